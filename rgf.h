@@ -30,9 +30,84 @@ LICENSE
 #define RGF_API static
 #endif
 
+/* Small hot paths that have to be inlined into the parser loops */
+#if defined(__GNUC__) || defined(__clang__)
+#define RGF_FORCE_INLINE __inline__ __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define RGF_FORCE_INLINE __forceinline
+#else
+#define RGF_FORCE_INLINE RGF_INLINE
+#endif
+
+/* 64 bit unsigned integer (C89 has no portable "long long") */
+#if defined(_MSC_VER)
+typedef unsigned __int64 rgf_u64;
+#elif defined(__GNUC__) || defined(__clang__)
+__extension__ typedef unsigned long long rgf_u64;
+#else
+typedef unsigned long rgf_u64; /* Assumes a LP64 target */
+#endif
+
+/* Unsigned integer of the size of a pointer (unsigned long is smaller on 64 bit Windows) */
+#if defined(_WIN64)
+typedef rgf_u64 rgf_uptr;
+#else
+typedef unsigned long rgf_uptr;
+#endif
+
+/* #############################################################################
+ * # SIMD DETECTION (compile time, define RGF_NO_SIMD to force the scalar paths)
+ * #############################################################################
+ */
+#ifndef RGF_NO_SIMD
+#if defined(__AVX2__)
+#define RGF_SIMD_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RGF_SIMD_SSE2
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define RGF_SIMD_NEON
+#endif
+#endif /* RGF_NO_SIMD */
+
+#if defined(RGF_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(RGF_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(RGF_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 /* ########################################################## */
 /* # The standard RGF data model                              */
 /* ########################################################## */
+
+/* model->normals were read from the source (OBJ "vn" lines or a binary), so
+   rgf_model_calculate_normals does not have to run
+*/
+#define RGF_MODEL_FLAG_NORMALS_PROVIDED 0x1UL
+
+/* model->transform is not applied to the arrays yet, see rgf_model_transform_deferred */
+#define RGF_MODEL_FLAG_TRANSFORM_PENDING 0x2UL
+
+/* model->adjacency_offsets and model->adjacency_triangles match model->indices, see
+   rgf_model_build_adjacency
+*/
+#define RGF_MODEL_FLAG_ADJACENCY 0x4UL
+
+/* Flags that only describe the arrays in memory and are never stored */
+#define RGF_MODEL_FLAGS_RUNTIME (RGF_MODEL_FLAG_TRANSFORM_PENDING | RGF_MODEL_FLAG_ADJACENCY)
+
+/* A range of triangles drawn with one material (32 bit fields, stored as is in binaries) */
+typedef struct rgf_submesh
+{
+  unsigned int index_offset;  /* First index in model->indices                       */
+  unsigned int index_count;   /* Number of indices (3 per triangle)                  */
+  unsigned int material_hash; /* rgf_material_hash of the "usemtl" name, 0 = no name */
+
+} rgf_submesh;
+
 typedef struct rgf_model
 {
 
@@ -42,6 +117,10 @@ typedef struct rgf_model
   unsigned long bitangents_size;
   unsigned long uvs_size; /* Number of floats in the uvs array */
   unsigned long indices_size;
+  unsigned long index_width;    /* Bytes per index: 4 (or 0) int, 2 unsigned short, 1 unsigned char */
+  unsigned long submeshes_size; /* Number of rgf_submesh entries */
+
+  unsigned long flags; /* RGF_MODEL_FLAG_* bits */
 
   float min_x;
   float min_y;
@@ -63,12 +142,24 @@ typedef struct rgf_model
   float original_max_dim; /* The largest dimension of the model before any scaling. */
   float current_scale;    /* The current scaling factor relative to the original.  */
 
+  float transform[12];     /* Pending row major 3x4 transform of the arrays            */
+  float transform_min[3];  /* Bounds of the arrays the pending transform applies to    */
+  float transform_max[3];
+
   float *vertices;   /* The vertex data */
   float *normals;    /* Normals data */
   float *tangents;   /* Point along the U-axis of the texture*/
   float *bitangents; /* Point along the V-axis of the texture. */
   float *uvs;        /* Texture coosrdinates: size = (vertices_size / 3) * 2 */
-  int *indices;      /* Vertex indices data */
+  int *indices;      /* Vertex indices data, index_width bytes each (see rgf_model_index) */
+
+  rgf_submesh *submeshes; /* Index ranges per "o", "g" and "usemtl" */
+
+  /* Optional vertex to triangle adjacency (CSR), buffers supplied by the caller:
+     vertices_size / 3 + 1 offsets and indices_size triangle entries
+  */
+  unsigned int *adjacency_offsets;   /* First entry of every vertex in adjacency_triangles */
+  unsigned int *adjacency_triangles; /* Triangles using a vertex, ascending              */
 
 } rgf_model;
 
@@ -80,72 +171,71 @@ RGF_API RGF_INLINE int rgf_is_space(char c)
   return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
 }
 
-RGF_API RGF_INLINE int rgf_atoi(char *s, int *consumed)
+#define RGF_HASH_FNV1A_BASIS 2166136261UL
+
+/* Continues a 32 bit FNV-1a hash with more data, starting from RGF_HASH_FNV1A_BASIS */
+RGF_API RGF_INLINE unsigned long rgf_hash_fnv1a_update(unsigned long hash, unsigned char *data, unsigned long length)
 {
-  int sign = 1;
-  int value = 0;
-  int i = 0;
+  unsigned long i;
 
-  if (s[i] == '-')
-  {
-    sign = -1;
-    i++;
-  }
-  else if (s[i] == '+')
+  for (i = 0; i < length; ++i)
   {
-    i++;
+    hash = ((hash ^ data[i]) * 16777619UL) & 0xFFFFFFFFUL;
   }
 
-  while (s[i] >= '0' && s[i] <= '9')
+  return hash;
+}
+
+/* 32 bit FNV-1a hash */
+RGF_API RGF_INLINE unsigned long rgf_hash_fnv1a(unsigned char *data, unsigned long length)
+{
+  return rgf_hash_fnv1a_update(RGF_HASH_FNV1A_BASIS, data, length);
+}
+
+/* The rgf_submesh material_hash of a material name */
+RGF_API RGF_INLINE unsigned long rgf_material_hash(char *name)
+{
+  unsigned long length = 0;
+
+  while (name[length])
   {
-    value = value * 10 + (s[i] - '0');
-    i++;
+    length++;
   }
 
-  *consumed = i;
-
-  return value * sign;
+  return rgf_hash_fnv1a((unsigned char *)name, length);
 }
 
-RGF_API RGF_INLINE float rgf_atof(char *s, int *consumed)
+/* Parses an integer of at most length characters */
+RGF_API RGF_INLINE int rgf_atoi_n(char *s, unsigned long length, int *consumed)
 {
-  int i = 0;
   int sign = 1;
-  float value = 0.0f;
-  float frac = 0.0f;
-  float divisor = 1.0f;
+  int value = 0;
+  unsigned long i = 0;
 
-  if (s[i] == '-')
+  if (i < length && s[i] == '-')
   {
     sign = -1;
     i++;
   }
-  else if (s[i] == '+')
+  else if (i < length && s[i] == '+')
   {
     i++;
   }
 
-  while (s[i] >= '0' && s[i] <= '9')
+  while (i < length && s[i] >= '0' && s[i] <= '9')
   {
-    value = value * 10.0f + (float)(s[i] - '0');
+    value = value * 10 + (s[i] - '0');
     i++;
   }
 
-  if (s[i] == '.')
-  {
-    i++;
-    while (s[i] >= '0' && s[i] <= '9')
-    {
-      frac = frac * 10.0f + (float)(s[i] - '0');
-      divisor *= 10.0f;
-      i++;
-    }
-    value += frac / divisor;
-  }
+  *consumed = (int)i;
 
-  *consumed = i;
+  return value * sign;
+}
 
-  return value * (float)sign;
+RGF_API RGF_INLINE int rgf_atoi(char *s, int *consumed)
+{
+  return rgf_atoi_n(s, (unsigned long)-1, consumed);
 }
 
 RGF_API RGF_INLINE void rgf_reverse_str(char *str, int length)
@@ -270,1129 +360,8183 @@ RGF_API RGF_INLINE void rgf_append_str(char *src, unsigned char *buffer, unsigne
 }
 
 /* ########################################################## */
-/* # Utility Vector Functions                                 */
+/* # Utility Memory functions                                 */
 /* ########################################################## */
-RGF_API RGF_INLINE float rgf_sqrtf(float f)
-{
-  float guess = f / 2.0f;
-
-  /* Perform a few iterations of Newton-Raphson to refine the guess */
-  guess = 0.5f * (guess + f / guess);
-  guess = 0.5f * (guess + f / guess);
-  guess = 0.5f * (guess + f / guess);
-  guess = 0.5f * (guess + f / guess);
-  guess = 0.5f * (guess + f / guess);
-
-  return guess;
-}
-
-RGF_API RGF_INLINE void rgf_v3_sub(float *out, float *a, float *b)
-{
-  out[0] = a[0] - b[0];
-  out[1] = a[1] - b[1];
-  out[2] = a[2] - b[2];
-}
-
-RGF_API RGF_INLINE void rgf_v3_add(float *out, float *a, float *b)
-{
-  out[0] = a[0] + b[0];
-  out[1] = a[1] + b[1];
-  out[2] = a[2] + b[2];
-}
-
-RGF_API RGF_INLINE void rgf_v3_cross(float *out, float *a, float *b)
-{
-  out[0] = a[1] * b[2] - a[2] * b[1];
-  out[1] = a[2] * b[0] - a[0] * b[2];
-  out[2] = a[0] * b[1] - a[1] * b[0];
-}
-
-RGF_API RGF_INLINE float rgf_v3_length(float *v)
+/* The address of a pointer as an integer, for alignment checks */
+RGF_API RGF_INLINE rgf_uptr rgf_address(void *pointer)
 {
-  return rgf_sqrtf((v[0] * v[0] + v[1] * v[1] + v[2] * v[2]));
+  return (rgf_uptr)pointer;
 }
 
-RGF_API RGF_INLINE void rgf_v3_normalize(float *out, float *v)
-{
-  float len = rgf_v3_length(v);
-  if (len > 0.0f)
-  {
-    float inv_len = 1.0f / len;
-    out[0] = v[0] * inv_len;
-    out[1] = v[1] * inv_len;
-    out[2] = v[2] * inv_len;
-  }
-  else
-  {
-    out[0] = out[1] = out[2] = 0.0f;
-  }
-}
+/* Copies of at least this many bytes use non-temporal stores (SSE2/AVX2): the destination
+   of a large copy (a whole model array) is not read again soon, so it bypasses the cache
+   instead of evicting the working set.
+*/
+#ifndef RGF_MEMCPY_STREAM_SIZE
+#define RGF_MEMCPY_STREAM_SIZE (4UL * 1024UL * 1024UL)
+#endif
 
-/* ########################################################## */
-/* # OBJ to RGF conversion funciton                           */
-/* ########################################################## */
-#ifndef RGF_OBJ_MAX_FACE_VERTICES
-#define RGF_OBJ_MAX_FACE_VERTICES 8
+/* Machine word that may alias any other type (the copied arrays are floats, ints, ...) */
+#if defined(__GNUC__) || defined(__clang__)
+typedef unsigned long rgf_word __attribute__((__may_alias__));
+#else
+typedef unsigned long rgf_word;
 #endif
 
-RGF_API RGF_INLINE int rgf_parse_obj(
-    rgf_model *model,             /* The filled by supplied obj file data model      */
-    unsigned char *obj_binary,    /* OBJ File binary buffer                          */
-    unsigned long obj_binary_size /* OBJ File binary buffer size                     */
-)
+/* Copies count bytes between buffers that do not overlap. Bytes until dest is aligned,
+   then 64 bytes per iteration with aligned SIMD stores (non-temporal from
+   RGF_MEMCPY_STREAM_SIZE), then machine words if src and dest are aligned alike, then
+   the remaining bytes.
+*/
+RGF_API RGF_INLINE void *rgf_binary_memcpy(void *dest, void *src, unsigned long count)
 {
-  unsigned long i = 0;
-  unsigned long vertex_count = 0;
-  unsigned long triangle_count = 0;
-  unsigned long uv_count = 0;
-  unsigned long v_index = 0;
-  unsigned long uv_index = 0;
-  unsigned long f_index = 0;
-  int face_indices_temp[RGF_OBJ_MAX_FACE_VERTICES];
-  int face_vertices_count;
+  unsigned char *d = (unsigned char *)dest;
+  unsigned char *s = (unsigned char *)src;
 
-  /* Check input arguments */
-  if (!model || !obj_binary || obj_binary_size <= 0)
+#if defined(RGF_SIMD_AVX2) || defined(RGF_SIMD_SSE2) || defined(RGF_SIMD_NEON)
+  if (count >= 128)
   {
-    return 0;
-  }
+    int stream = count >= RGF_MEMCPY_STREAM_SIZE;
 
-  /* First pass: count vertices & triangles */
-  i = 0;
-
-  while (i < obj_binary_size)
-  {
-    if (obj_binary[i] == 'v' && obj_binary[i + 1] == ' ')
+    for (; (rgf_address(d) & 31) != 0; --count)
     {
-      vertex_count++;
+      *d++ = *s++;
     }
-    else if (obj_binary[i] == 'v' && obj_binary[i + 1] == 't')
+
+#if defined(RGF_SIMD_AVX2)
+    for (; count >= 64; count -= 64, d += 64, s += 64)
     {
-      uv_count++;
+      __m256i a = _mm256_loadu_si256((__m256i *)(void *)s);
+      __m256i b = _mm256_loadu_si256((__m256i *)(void *)(s + 32));
+
+      if (stream)
+      {
+        _mm256_stream_si256((__m256i *)(void *)d, a);
+        _mm256_stream_si256((__m256i *)(void *)(d + 32), b);
+      }
+      else
+      {
+        _mm256_store_si256((__m256i *)(void *)d, a);
+        _mm256_store_si256((__m256i *)(void *)(d + 32), b);
+      }
     }
-    else if (obj_binary[i] == 'f' && obj_binary[i + 1] == ' ')
+#elif defined(RGF_SIMD_SSE2)
+    for (; count >= 64; count -= 64, d += 64, s += 64)
     {
-      unsigned long j = i + 2;
-      int current_char_is_digit;
-
-      face_vertices_count = 0;
+      __m128i a = _mm_loadu_si128((__m128i *)(void *)s);
+      __m128i b = _mm_loadu_si128((__m128i *)(void *)(s + 16));
+      __m128i c = _mm_loadu_si128((__m128i *)(void *)(s + 32));
+      __m128i e = _mm_loadu_si128((__m128i *)(void *)(s + 48));
 
-      while (j < obj_binary_size && obj_binary[j] != '\n' && obj_binary[j] != '\r')
+      if (stream)
       {
-        current_char_is_digit = obj_binary[j] >= '0' && obj_binary[j] <= '9';
-
-        if (current_char_is_digit || obj_binary[j] == '-')
-        {
-          face_vertices_count++;
-          /* Skip to end of number, ignoring slashes */
-          while (j < obj_binary_size && obj_binary[j] != ' ' && obj_binary[j] != '\n' && obj_binary[j] != '\r')
-          {
-            j++;
-          }
-        }
-        else
-        {
-          j++;
-        }
+        _mm_stream_si128((__m128i *)(void *)d, a);
+        _mm_stream_si128((__m128i *)(void *)(d + 16), b);
+        _mm_stream_si128((__m128i *)(void *)(d + 32), c);
+        _mm_stream_si128((__m128i *)(void *)(d + 48), e);
       }
-
-      if (face_vertices_count >= 3)
+      else
       {
-        triangle_count += (unsigned long)(face_vertices_count - 2);
+        _mm_store_si128((__m128i *)(void *)d, a);
+        _mm_store_si128((__m128i *)(void *)(d + 16), b);
+        _mm_store_si128((__m128i *)(void *)(d + 32), c);
+        _mm_store_si128((__m128i *)(void *)(d + 48), e);
       }
     }
+#else
+    /* No non-temporal stores that are worth it on NEON */
+    (void)stream;
 
-    while (i < obj_binary_size && obj_binary[i] != '\n')
+    for (; count >= 64; count -= 64, d += 64, s += 64)
     {
-      i++;
+      uint8x16_t a = vld1q_u8(s);
+      uint8x16_t b = vld1q_u8(s + 16);
+      uint8x16_t c = vld1q_u8(s + 32);
+      uint8x16_t e = vld1q_u8(s + 48);
+
+      vst1q_u8(d, a);
+      vst1q_u8(d + 16, b);
+      vst1q_u8(d + 32, c);
+      vst1q_u8(d + 48, e);
     }
-    i++;
-  }
-
-  /* Allocate arrays */
-  model->vertices_size = vertex_count * 3;
-  model->indices_size = triangle_count * 3;
-  model->uvs_size = uv_count * 2;
+#endif
 
-  if (!model->vertices)
-  {
-    return 0;
+#if defined(RGF_SIMD_SSE2)
+    if (stream)
+    {
+      /* Order the non-temporal stores before any later store */
+      _mm_sfence();
+    }
+#endif
   }
+#endif
 
-  /* Second pass: parse data */
-  i = 0;
-  model->min_x = model->min_y = model->min_z = 1e30f;
-  model->max_x = model->max_y = model->max_z = -1e30f;
-
-  while (i < obj_binary_size)
+  /* Words only if both are aligned, not every target loads unaligned words */
+  if (count >= sizeof(rgf_word) && rgf_address(d) % sizeof(rgf_word) == rgf_address(s) % sizeof(rgf_word))
   {
-    /* -------- Vertex -------- */
-    if (obj_binary[i] == 'v' && obj_binary[i + 1] == ' ')
+    for (; rgf_address(d) % sizeof(rgf_word) != 0; --count)
     {
-      int consumed = 0;
+      *d++ = *s++;
+    }
 
-      i += 2;
+    for (; count >= sizeof(rgf_word); count -= sizeof(rgf_word), d += sizeof(rgf_word), s += sizeof(rgf_word))
+    {
+      *(rgf_word *)(void *)d = *(rgf_word *)(void *)s;
+    }
+  }
 
-      model->vertices[v_index] = rgf_atof((char *)(obj_binary + i), &consumed);
+  for (; count > 0; --count)
+  {
+    *d++ = *s++;
+  }
 
-      if (model->vertices[v_index] < model->min_x)
-      {
-        model->min_x = model->vertices[v_index];
-      }
+  return dest;
+}
 
-      if (model->vertices[v_index] > model->max_x)
-      {
-        model->max_x = model->vertices[v_index];
-      }
+/* ########################################################## */
+/* # Utility Bit functions                                    */
+/* ########################################################## */
+RGF_API RGF_INLINE unsigned long rgf_popcount64(rgf_u64 x)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__POPCNT__)
+  return (unsigned long)__builtin_popcountll(x);
+#else
+  /* SWAR bit count, avoids a libgcc call when no popcnt instruction is available */
+  x = x - ((x >> 1) & (((rgf_u64)0x55555555UL << 32) | 0x55555555UL));
+  x = (x & (((rgf_u64)0x33333333UL << 32) | 0x33333333UL)) + ((x >> 2) & (((rgf_u64)0x33333333UL << 32) | 0x33333333UL));
+  x = (x + (x >> 4)) & (((rgf_u64)0x0F0F0F0FUL << 32) | 0x0F0F0F0FUL);
+  return (unsigned long)((x * (((rgf_u64)0x01010101UL << 32) | 0x01010101UL)) >> 56);
+#endif
+}
 
-      i += (unsigned long)consumed;
-      v_index++;
+/* Index of the lowest set bit, x must not be zero */
+RGF_API RGF_INLINE unsigned long rgf_ctz64(rgf_u64 x)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__LP64__) || defined(_WIN64))
+  return (unsigned long)__builtin_ctzll(x);
+#elif defined(__GNUC__) || defined(__clang__)
+  /* 32 bit targets: __builtin_ctzll would be a libgcc call */
+  unsigned int low = (unsigned int)x;
+  return low ? (unsigned long)__builtin_ctz(low) : 32 + (unsigned long)__builtin_ctz((unsigned int)(x >> 32));
+#else
+  unsigned long n = 0;
 
-      while (rgf_is_space((char)obj_binary[i]))
-      {
-        i++;
-      }
+  if (!(x & 0xFFFFFFFFUL))
+  {
+    n += 32;
+    x >>= 32;
+  }
 
-      model->vertices[v_index] = rgf_atof((char *)(obj_binary + i), &consumed);
+  while (!(x & 1))
+  {
+    n++;
+    x >>= 1;
+  }
 
-      if (model->vertices[v_index] < model->min_y)
-      {
-        model->min_y = model->vertices[v_index];
-      }
+  return n;
+#endif
+}
 
-      if (model->vertices[v_index] > model->max_y)
-      {
-        model->max_y = model->vertices[v_index];
-      }
+/* Index of the highest set bit counted from bit 63, x must not be zero */
+RGF_API RGF_INLINE unsigned long rgf_clz64(rgf_u64 x)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__LP64__) || defined(_WIN64))
+  return (unsigned long)__builtin_clzll(x);
+#elif defined(__GNUC__) || defined(__clang__)
+  unsigned int high = (unsigned int)(x >> 32);
+  return high ? (unsigned long)__builtin_clz(high) : 32 + (unsigned long)__builtin_clz((unsigned int)x);
+#else
+  unsigned long n = 0;
 
-      i += (unsigned long)consumed;
-      v_index++;
+  if (!(x >> 32))
+  {
+    n += 32;
+    x <<= 32;
+  }
 
-      while (rgf_is_space((char)obj_binary[i]))
-      {
-        i++;
-      }
+  while (!(x >> 63))
+  {
+    n++;
+    x <<= 1;
+  }
 
-      model->vertices[v_index] = rgf_atof((char *)(obj_binary + i), &consumed);
+  return n;
+#endif
+}
 
-      if (model->vertices[v_index] < model->min_z)
-      {
-        model->min_z = model->vertices[v_index];
-      }
+/* Full 64x64 bit multiplication, returns the low 64 bits and stores the high 64 bits */
+RGF_API RGF_INLINE rgf_u64 rgf_mul64(rgf_u64 a, rgf_u64 b, rgf_u64 *high)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 rgf_u128;
+  rgf_u128 product = (rgf_u128)a * b;
+  *high = (rgf_u64)(product >> 64);
+  return (rgf_u64)product;
+#else
+  rgf_u64 a_lo = a & 0xFFFFFFFFUL;
+  rgf_u64 a_hi = a >> 32;
+  rgf_u64 b_lo = b & 0xFFFFFFFFUL;
+  rgf_u64 b_hi = b >> 32;
+  rgf_u64 lo_lo = a_lo * b_lo;
+  rgf_u64 hi_lo = a_hi * b_lo;
+  rgf_u64 lo_hi = a_lo * b_hi;
+  rgf_u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFUL) + lo_hi;
+
+  *high = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+  return (cross << 32) | (lo_lo & 0xFFFFFFFFUL);
+#endif
+}
 
-      if (model->vertices[v_index] > model->max_z)
-      {
-        model->max_z = model->vertices[v_index];
-      }
+/* Mask with the bits [from, to) set, 0 <= from <= to <= 64 */
+RGF_API RGF_INLINE rgf_u64 rgf_bit_range64(unsigned long from, unsigned long to)
+{
+  rgf_u64 upper = to >= 64 ? ~(rgf_u64)0 : (((rgf_u64)1 << to) - 1);
+  rgf_u64 lower = from >= 64 ? ~(rgf_u64)0 : (((rgf_u64)1 << from) - 1);
+  return upper & ~lower;
+}
 
-      i += (unsigned long)consumed;
-      v_index++;
-    }
-    /* -------- Texture Coordinate -------- */
-    else if (model->uvs && obj_binary[i] == 'v' && obj_binary[i + 1] == 't')
-    {
-      int consumed = 0;
-      i += 3; /* skip "vt " */
+/* ########################################################## */
+/* # Utility Number parsing (correctly rounded)               */
+/* ########################################################## */
+/* Decimal exponents outside of [MIN, MAX] are always 0 or infinity for a float */
+#define RGF_FLOAT_POWER_MIN (-64)
+#define RGF_FLOAT_POWER_MAX 38
 
-      model->uvs[uv_index++] = rgf_atof((char *)(obj_binary + i), &consumed);
-      i += (unsigned long)consumed;
+/* High 64 bits of the normalized 128 bit approximations of 5^q for q in [-64, 38]
+   (same values as the table of the Eisel-Lemire algorithm), stored as 32 bit halves.
+*/
+static const unsigned long rgf_float_power_of_five[] = {
+    0xA87FEA27UL, 0xA539E9A5UL, 0xD29FE4B1UL, 0x8E88640EUL, 0x83A3EEEEUL, 0xF9153E89UL,
+    0xA48CEAAAUL, 0xB75A8E2BUL, 0xCDB02555UL, 0x653131B6UL, 0x808E1755UL, 0x5F3EBF11UL,
+    0xA0B19D2AUL, 0xB70E6ED6UL, 0xC8DE0475UL, 0x64D20A8BUL, 0xFB158592UL, 0xBE068D2EUL,
+    0x9CED737BUL, 0xB6C4183DUL, 0xC428D05AUL, 0xA4751E4CUL, 0xF5330471UL, 0x4D9265DFUL,
+    0x993FE2C6UL, 0xD07B7FABUL, 0xBF8FDB78UL, 0x849A5F96UL, 0xEF73D256UL, 0xA5C0F77CUL,
+    0x95A86376UL, 0x27989AADUL, 0xBB127C53UL, 0xB17EC159UL, 0xE9D71B68UL, 0x9DDE71AFUL,
+    0x92267121UL, 0x62AB070DUL, 0xB6B00D69UL, 0xBB55C8D1UL, 0xE45C10C4UL, 0x2A2B3B05UL,
+    0x8EB98A7AUL, 0x9A5B04E3UL, 0xB267ED19UL, 0x40F1C61CUL, 0xDF01E85FUL, 0x912E37A3UL,
+    0x8B61313BUL, 0xBABCE2C6UL, 0xAE397D8AUL, 0xA96C1B77UL, 0xD9C7DCEDUL, 0x53C72255UL,
+    0x881CEA14UL, 0x545C7575UL, 0xAA242499UL, 0x697392D2UL, 0xD4AD2DBFUL, 0xC3D07787UL,
+    0x84EC3C97UL, 0xDA624AB4UL, 0xA6274BBDUL, 0xD0FADD61UL, 0xCFB11EADUL, 0x453994BAUL,
+    0x81CEB32CUL, 0x4B43FCF4UL, 0xA2425FF7UL, 0x5E14FC31UL, 0xCAD2F7F5UL, 0x359A3B3EUL,
+    0xFD87B5F2UL, 0x8300CA0DUL, 0x9E74D1B7UL, 0x91E07E48UL, 0xC6120625UL, 0x76589DDAUL,
+    0xF79687AEUL, 0xD3EEC551UL, 0x9ABE14CDUL, 0x44753B52UL, 0xC16D9A00UL, 0x95928A27UL,
+    0xF1C90080UL, 0xBAF72CB1UL, 0x971DA050UL, 0x74DA7BEEUL, 0xBCE50864UL, 0x92111AEAUL,
+    0xEC1E4A7DUL, 0xB69561A5UL, 0x9392EE8EUL, 0x921D5D07UL, 0xB877AA32UL, 0x36A4B449UL,
+    0xE69594BEUL, 0xC44DE15BUL, 0x901D7CF7UL, 0x3AB0ACD9UL, 0xB424DC35UL, 0x095CD80FUL,
+    0xE12E1342UL, 0x4BB40E13UL, 0x8CBCCC09UL, 0x6F5088CBUL, 0xAFEBFF0BUL, 0xCB24AAFEUL,
+    0xDBE6FECEUL, 0xBDEDD5BEUL, 0x89705F41UL, 0x36B4A597UL, 0xABCC7711UL, 0x8461CEFCUL,
+    0xD6BF94D5UL, 0xE57A42BCUL, 0x8637BD05UL, 0xAF6C69B5UL, 0xA7C5AC47UL, 0x1B478423UL,
+    0xD1B71758UL, 0xE219652BUL, 0x83126E97UL, 0x8D4FDF3BUL, 0xA3D70A3DUL, 0x70A3D70AUL,
+    0xCCCCCCCCUL, 0xCCCCCCCCUL, 0x80000000UL, 0x00000000UL, 0xA0000000UL, 0x00000000UL,
+    0xC8000000UL, 0x00000000UL, 0xFA000000UL, 0x00000000UL, 0x9C400000UL, 0x00000000UL,
+    0xC3500000UL, 0x00000000UL, 0xF4240000UL, 0x00000000UL, 0x98968000UL, 0x00000000UL,
+    0xBEBC2000UL, 0x00000000UL, 0xEE6B2800UL, 0x00000000UL, 0x9502F900UL, 0x00000000UL,
+    0xBA43B740UL, 0x00000000UL, 0xE8D4A510UL, 0x00000000UL, 0x9184E72AUL, 0x00000000UL,
+    0xB5E620F4UL, 0x80000000UL, 0xE35FA931UL, 0xA0000000UL, 0x8E1BC9BFUL, 0x04000000UL,
+    0xB1A2BC2EUL, 0xC5000000UL, 0xDE0B6B3AUL, 0x76400000UL, 0x8AC72304UL, 0x89E80000UL,
+    0xAD78EBC5UL, 0xAC620000UL, 0xD8D726B7UL, 0x177A8000UL, 0x87867832UL, 0x6EAC9000UL,
+    0xA968163FUL, 0x0A57B400UL, 0xD3C21BCEUL, 0xCCEDA100UL, 0x84595161UL, 0x401484A0UL,
+    0xA56FA5B9UL, 0x9019A5C8UL, 0xCECB8F27UL, 0xF4200F3AUL, 0x813F3978UL, 0xF8940984UL,
+    0xA18F07D7UL, 0x36B90BE5UL, 0xC9F2C9CDUL, 0x04674EDEUL, 0xFC6F7C40UL, 0x45812296UL,
+    0x9DC5ADA8UL, 0x2B70B59DUL, 0xC5371912UL, 0x364CE305UL, 0xF684DF56UL, 0xC3E01BC6UL,
+    0x9A130B96UL, 0x3A6C115CUL, 0xC097CE7BUL, 0xC90715B3UL, 0xF0BDC21AUL, 0xBB48DB20UL,
+    0x96769950UL, 0xB50D88F4UL
+};
+
+/* The float division of the fast path is only correctly rounded
+   without excess precision (e.g. not on the x87 FPU)
+*/
+#if defined(__FLT_EVAL_METHOD__)
+#if __FLT_EVAL_METHOD__ == 0 || __FLT_EVAL_METHOD__ == 16 /* 16: only _Float16 is widened */
+#define RGF_FLOAT_EXACT_ARITHMETIC
+#endif
+#elif defined(_M_X64) || defined(_M_ARM64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RGF_FLOAT_EXACT_ARITHMETIC
+#endif
 
-      while (rgf_is_space((char)obj_binary[i]))
-      {
-        i++;
-      }
+#ifdef RGF_FLOAT_EXACT_ARITHMETIC
+/* Powers of ten that are exact in a float */
+static const float rgf_float_power_of_ten[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+#endif
 
-      model->uvs[uv_index++] = rgf_atof((char *)(obj_binary + i), &consumed);
-      i += (unsigned long)consumed;
-    }
-    /* -------- Faces -------- */
-    else if (model->indices && obj_binary[i] == 'f' && obj_binary[i + 1] == ' ')
-    {
-      int consumed = 0;
-      int j;
-      int current_index;
+RGF_API RGF_INLINE float rgf_float_from_bits(unsigned long bits)
+{
+  union
+  {
+    unsigned int u;
+    float f;
+  } value;
 
-      i += 2;
-      face_vertices_count = 0;
+  value.u = (unsigned int)bits;
 
-      /* Parse all vertex indices on the line */
-      while (i < obj_binary_size && obj_binary[i] != '\n' && obj_binary[i] != '\r' && face_vertices_count < RGF_OBJ_MAX_FACE_VERTICES)
-      {
-        /* Skip non-numeric characters before the vertex index */
-        while (i < obj_binary_size && rgf_is_space((char)obj_binary[i]))
-        {
-          i++;
-        }
+  return value.f;
+}
 
-        if (i >= obj_binary_size || obj_binary[i] == '\n' || obj_binary[i] == '\r')
-        {
-          break;
-        }
+RGF_API RGF_INLINE int rgf_is_digit(unsigned char c)
+{
+  return c >= '0' && c <= '9';
+}
 
-        current_index = rgf_atoi((char *)(obj_binary + i), &consumed);
-        i += (unsigned long)consumed;
+/* Loads 8 bytes as a little endian integer */
+RGF_API RGF_INLINE rgf_u64 rgf_load64_le(unsigned char *p)
+{
+  return ((rgf_u64)p[0]) |
+         ((rgf_u64)p[1] << 8) |
+         ((rgf_u64)p[2] << 16) |
+         ((rgf_u64)p[3] << 24) |
+         ((rgf_u64)p[4] << 32) |
+         ((rgf_u64)p[5] << 40) |
+         ((rgf_u64)p[6] << 48) |
+         ((rgf_u64)p[7] << 56);
+}
 
-        /* Skip any texture/normal indices and the trailing space/newline */
-        while (i < obj_binary_size && !rgf_is_space((char)obj_binary[i]) && obj_binary[i] != '\n' && obj_binary[i] != '\r')
-        {
-          i++;
-        }
+/* Checks if all 8 bytes of a little endian loaded integer are ASCII digits */
+RGF_API RGF_INLINE int rgf_is_eight_digits(rgf_u64 x)
+{
+  rgf_u64 high = ((rgf_u64)0xF0F0F0F0UL << 32) | 0xF0F0F0F0UL;
+  rgf_u64 six = ((rgf_u64)0x06060606UL << 32) | 0x06060606UL;
+  rgf_u64 three = ((rgf_u64)0x33333333UL << 32) | 0x33333333UL;
 
-        /* Handle negative indices (relative to the end of the vertex count) */
-        if (current_index < 0)
-        {
-          current_index = (int)vertex_count + current_index;
-        }
-        else
+  return ((x & high) | (((x + six) & high) >> 4)) == three;
+}
+
+/* Converts 8 ASCII digits (little endian loaded) to their value with three multiplications */
+RGF_API RGF_INLINE unsigned long rgf_parse_eight_digits(rgf_u64 x)
+{
+  rgf_u64 mask = ((rgf_u64)0x000000FFUL << 32) | 0x000000FFUL;
+  rgf_u64 mul1 = ((rgf_u64)0x000F4240UL << 32) | 0x00000064UL; /* 100 + (1000000 << 32) */
+  rgf_u64 mul2 = ((rgf_u64)0x00002710UL << 32) | 0x00000001UL; /* 1 + (10000 << 32)     */
+
+  x -= ((rgf_u64)0x30303030UL << 32) | 0x30303030UL;
+  x = (x * 10) + (x >> 8); /* Pairs of digits */
+  x = (((x & mask) * mul1) + (((x >> 16) & mask) * mul2)) >> 32;
+
+  return (unsigned long)x;
+}
+
+/* Loads 4 bytes as a little endian integer */
+RGF_API RGF_INLINE unsigned long rgf_load32_le(unsigned char *p)
+{
+  return ((unsigned long)p[0]) |
+         ((unsigned long)p[1] << 8) |
+         ((unsigned long)p[2] << 16) |
+         ((unsigned long)p[3] << 24);
+}
+
+/* Checks if all 4 bytes of a little endian loaded integer are ASCII digits */
+RGF_API RGF_INLINE int rgf_is_four_digits(unsigned long x)
+{
+  return ((x & 0xF0F0F0F0UL) | (((x + 0x06060606UL) & 0xF0F0F0F0UL) >> 4)) == 0x33333333UL;
+}
+
+/* Converts 4 ASCII digits (little endian loaded) to their value */
+RGF_API RGF_INLINE unsigned long rgf_parse_four_digits(unsigned long x)
+{
+  x = (x & 0x0F0F0F0FUL) * 10 + ((x & 0x0F0F0F0FUL) >> 8); /* Pairs of digits */
+
+  return (unsigned long)((((rgf_u64)(x & 0x00FF00FFUL) * ((100UL << 16) + 1)) >> 16) & 0xFFFFUL);
+}
+
+/* Eisel-Lemire: converts w * 10^q (w < 2^64) to float bits using a single 64x64 bit
+   multiplication. Returns 0 if the product is too close to a rounding boundary to
+   decide, the caller has to take the exact slow path then.
+*/
+RGF_API RGF_INLINE int rgf_float_eisel_lemire(rgf_u64 w, long q, unsigned long *bits)
+{
+  rgf_u64 precision_mask = ((rgf_u64)0x3FUL << 32) | 0xFFFFFFFFUL; /* 64 - (23 + 3) low bits */
+  rgf_u64 power_of_five, high, low, mantissa;
+  unsigned long leading_zeros, upper_bit, shift;
+  long power2;
+
+  if (w == 0 || q < RGF_FLOAT_POWER_MIN)
+  {
+    *bits = 0;
+    return 1;
+  }
+
+  if (q > RGF_FLOAT_POWER_MAX)
+  {
+    *bits = 0x7F800000UL;
+    return 1;
+  }
+
+  leading_zeros = rgf_clz64(w);
+  w <<= leading_zeros;
+
+  power_of_five = ((rgf_u64)rgf_float_power_of_five[(q - RGF_FLOAT_POWER_MIN) * 2] << 32) |
+                  (rgf_u64)rgf_float_power_of_five[(q - RGF_FLOAT_POWER_MIN) * 2 + 1];
+  low = rgf_mul64(w, power_of_five, &high);
+
+  if ((high & precision_mask) == precision_mask)
+  {
+    return 0;
+  }
+
+  upper_bit = (unsigned long)(high >> 63);
+  shift = upper_bit + 64 - 23 - 3;
+  mantissa = high >> shift;
+
+  /* floor(log2(10^q)) + 63 + bias, 217706 / 2^16 approximates log2(10) */
+  power2 = ((217706L * q) >> 16) + 63 + (long)upper_bit - (long)leading_zeros + 127;
+
+  /* Subnormal */
+  if (power2 <= 0)
+  {
+    if (-power2 + 1 >= 64)
+    {
+      *bits = 0;
+      return 1;
+    }
+
+    mantissa >>= -power2 + 1;
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+
+    *bits = (unsigned long)mantissa | (mantissa < ((rgf_u64)1 << 23) ? 0UL : (1UL << 23));
+    return 1;
+  }
+
+  /* Exactly halfway between two floats: round to even instead of up */
+  if (low <= 1 && q >= -17 && q <= 10 && (mantissa & 3) == 1 && (mantissa << shift) == high)
+  {
+    mantissa &= ~(rgf_u64)1;
+  }
+
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+
+  if (mantissa >= ((rgf_u64)2 << 23))
+  {
+    mantissa = (rgf_u64)1 << 23;
+    power2++;
+  }
+
+  mantissa &= ~((rgf_u64)1 << 23);
+
+  if (power2 >= 0xFF)
+  {
+    power2 = 0xFF;
+    mantissa = 0;
+  }
+
+  *bits = ((unsigned long)power2 << 23) | (unsigned long)mantissa;
+
+  return 1;
+}
+
+/* Arbitrary precision decimal for the slow path (value = 0.d[0]d[1]... * 10^dp) */
+#define RGF_DECIMAL_DIGITS 800
+#define RGF_DECIMAL_MAX_SHIFT 28 /* n * 10 + 9 with n < 2^shift must fit into 32 bits */
+
+typedef struct rgf_decimal
+{
+  unsigned char d[RGF_DECIMAL_DIGITS + 9]; /* Digit values, 9 spare digits for left shifts */
+  long nd;                                 /* Number of digits used                         */
+  long dp;                                 /* Decimal point position                        */
+  int trunc;                               /* Nonzero digits were discarded                 */
+
+} rgf_decimal;
+
+RGF_API RGF_INLINE void rgf_decimal_trim(rgf_decimal *a)
+{
+  while (a->nd > 0 && a->d[a->nd - 1] == 0)
+  {
+    a->nd--;
+  }
+
+  if (a->nd == 0)
+  {
+    a->dp = 0;
+  }
+}
+
+/* a = a / 2^k */
+RGF_API RGF_INLINE void rgf_decimal_shift_right(rgf_decimal *a, unsigned long k)
+{
+  unsigned long n = 0;
+  unsigned long mask = (1UL << k) - 1;
+  long r = 0;
+  long w = 0;
+
+  /* Pick up enough leading digits to cover the first shift */
+  for (; (n >> k) == 0; r++)
+  {
+    if (r >= a->nd)
+    {
+      if (n == 0)
+      {
+        a->nd = 0;
+        return;
+      }
+
+      while ((n >> k) == 0)
+      {
+        n = n * 10;
+        r++;
+      }
+
+      break;
+    }
+
+    n = n * 10 + a->d[r];
+  }
+
+  a->dp -= r - 1;
+
+  /* Pick up a digit, put down a digit */
+  for (; r < a->nd; r++)
+  {
+    unsigned long digit = n >> k;
+    n &= mask;
+    a->d[w++] = (unsigned char)digit;
+    n = n * 10 + a->d[r];
+  }
+
+  /* Put down the remaining digits */
+  while (n > 0)
+  {
+    unsigned long digit = n >> k;
+    n &= mask;
+
+    if (w < RGF_DECIMAL_DIGITS)
+    {
+      a->d[w++] = (unsigned char)digit;
+    }
+    else if (digit > 0)
+    {
+      a->trunc = 1;
+    }
+
+    n = n * 10;
+  }
+
+  a->nd = w;
+  rgf_decimal_trim(a);
+}
+
+/* a = a * 2^k, k <= RGF_DECIMAL_MAX_SHIFT adds at most 9 digits */
+RGF_API RGF_INLINE void rgf_decimal_shift_left(rgf_decimal *a, unsigned long k)
+{
+  unsigned long n = 0;
+  long r;
+  long w = a->nd + 9;
+  long count;
+  long i;
+
+  /* Multiply from the last digit, writing behind the spare digits */
+  for (r = a->nd - 1; r >= 0; r--)
+  {
+    unsigned long quotient;
+
+    n += (unsigned long)a->d[r] << k;
+    quotient = n / 10;
+    a->d[--w] = (unsigned char)(n - 10 * quotient);
+    n = quotient;
+  }
+
+  while (n > 0)
+  {
+    unsigned long quotient = n / 10;
+    a->d[--w] = (unsigned char)(n - 10 * quotient);
+    n = quotient;
+  }
+
+  /* Move the digits back to the front */
+  count = a->nd + 9 - w;
+
+  for (i = 0; i < count; ++i)
+  {
+    if (i < RGF_DECIMAL_DIGITS)
+    {
+      a->d[i] = a->d[w + i];
+    }
+    else if (a->d[w + i] != 0)
+    {
+      a->trunc = 1;
+    }
+  }
+
+  a->dp += count - a->nd;
+  a->nd = count < RGF_DECIMAL_DIGITS ? count : RGF_DECIMAL_DIGITS;
+  rgf_decimal_trim(a);
+}
+
+RGF_API RGF_INLINE void rgf_decimal_shift(rgf_decimal *a, long k)
+{
+  if (a->nd == 0)
+  {
+    return;
+  }
+
+  for (; k > RGF_DECIMAL_MAX_SHIFT; k -= RGF_DECIMAL_MAX_SHIFT)
+  {
+    rgf_decimal_shift_left(a, RGF_DECIMAL_MAX_SHIFT);
+  }
+
+  for (; k < -RGF_DECIMAL_MAX_SHIFT; k += RGF_DECIMAL_MAX_SHIFT)
+  {
+    rgf_decimal_shift_right(a, RGF_DECIMAL_MAX_SHIFT);
+  }
+
+  if (k > 0)
+  {
+    rgf_decimal_shift_left(a, (unsigned long)k);
+  }
+  else if (k < 0)
+  {
+    rgf_decimal_shift_right(a, (unsigned long)-k);
+  }
+}
+
+/* Integer part of a rounded to nearest, ties to even (a < 2^32) */
+RGF_API RGF_INLINE unsigned long rgf_decimal_rounded_integer(rgf_decimal *a)
+{
+  unsigned long n = 0;
+  long i;
+  int round_up;
+
+  for (i = 0; i < a->dp && i < a->nd; ++i)
+  {
+    n = n * 10 + a->d[i];
+  }
+
+  for (; i < a->dp; ++i)
+  {
+    n *= 10;
+  }
+
+  if (a->dp < 0 || a->dp >= a->nd)
+  {
+    round_up = 0;
+  }
+  else if (a->d[a->dp] == 5 && a->dp + 1 == a->nd)
+  {
+    round_up = a->trunc || (a->dp > 0 && (a->d[a->dp - 1] & 1));
+  }
+  else
+  {
+    round_up = a->d[a->dp] >= 5;
+  }
+
+  return n + (unsigned long)round_up;
+}
+
+/* Exact conversion of the decimal to float bits by repeated binary shifts */
+RGF_API RGF_INLINE unsigned long rgf_decimal_float_bits(rgf_decimal *a)
+{
+  static const unsigned char power_table[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+  unsigned long mantissa;
+  long exponent = 0;
+
+  if (a->nd == 0 || a->dp < -46)
+  {
+    return 0;
+  }
+
+  if (a->dp > 39)
+  {
+    return 0x7F800000UL;
+  }
+
+  /* Scale into [0.5, 1) */
+  while (a->dp > 0)
+  {
+    long n = a->dp >= 9 ? 27 : power_table[a->dp];
+    rgf_decimal_shift(a, -n);
+    exponent += n;
+  }
+
+  while (a->dp < 0 || (a->dp == 0 && a->d[0] < 5))
+  {
+    long n = -a->dp >= 9 ? 27 : power_table[-a->dp];
+    rgf_decimal_shift(a, n);
+    exponent -= n;
+  }
+
+  /* The float range is [1, 2) */
+  exponent--;
+
+  /* Smallest exponent is -126, below that the value becomes subnormal */
+  if (exponent < -126)
+  {
+    rgf_decimal_shift(a, -(-126 - exponent));
+    exponent = -126;
+  }
+
+  if (exponent + 127 >= 0xFF)
+  {
+    return 0x7F800000UL;
+  }
+
+  /* Extract 24 bits */
+  rgf_decimal_shift(a, 24);
+  mantissa = rgf_decimal_rounded_integer(a);
+
+  /* Rounding might have added a bit */
+  if (mantissa == (2UL << 23))
+  {
+    mantissa >>= 1;
+    exponent++;
+
+    if (exponent + 127 >= 0xFF)
+    {
+      return 0x7F800000UL;
+    }
+  }
+
+  /* Subnormal */
+  if (!(mantissa & (1UL << 23)))
+  {
+    exponent = -127;
+  }
+
+  return (mantissa & 0x7FFFFFUL) | ((unsigned long)(exponent + 127) << 23);
+}
+
+/* Reads the digits and '.' of the mantissa text into the decimal */
+RGF_API RGF_INLINE void rgf_decimal_assign(rgf_decimal *a, unsigned char *begin, unsigned char *end, long exponent)
+{
+  int saw_dot = 0;
+
+  a->nd = 0;
+  a->dp = 0;
+  a->trunc = 0;
+
+  for (; begin < end; ++begin)
+  {
+    if (*begin == '.')
+    {
+      saw_dot = 1;
+      continue;
+    }
+
+    /* Leading zeros only move the decimal point */
+    if (*begin == '0' && a->nd == 0)
+    {
+      a->dp -= saw_dot;
+      continue;
+    }
+
+    if (a->nd < RGF_DECIMAL_DIGITS)
+    {
+      a->d[a->nd++] = (unsigned char)(*begin - '0');
+    }
+    else if (*begin != '0')
+    {
+      a->trunc = 1;
+    }
+
+    a->dp += !saw_dot;
+  }
+
+  a->dp += exponent;
+  rgf_decimal_trim(a);
+}
+
+/* Parses a decimal floating point number of at most length characters, see rgf_atof_n.
+   Handles everything the fast path of rgf_atof_n does not: exponents, more than 19
+   digits (the first 19 significant digits are kept), Eisel-Lemire and the exact decimal
+   slow path. Kept out of line so the fast path stays small enough to be inlined.
+*/
+RGF_API float rgf_atof_general(char *s, unsigned long length, int *consumed)
+{
+  rgf_decimal decimal;
+  unsigned char *p = (unsigned char *)s;
+  unsigned char *end = p + length;
+  unsigned char *digits_begin;
+  unsigned char *digits_end;
+  rgf_u64 w = 0;
+  long exponent = 0;
+  long explicit_exponent = 0;
+  unsigned long digit_count = 0;
+  unsigned long significant = 0;
+  unsigned long sign = 0;
+  unsigned long bits;
+  unsigned long bits_up;
+  int saw_dot = 0;
+  int truncated = 0;
+
+  if (p < end && (*p == '-' || *p == '+'))
+  {
+    sign = *p == '-' ? 0x80000000UL : 0;
+    p++;
+  }
+
+  digits_begin = p;
+
+  /* Keep the first 19 significant digits in w, the dropped ones only move the exponent */
+  for (; p < end; ++p)
+  {
+    if (*p == '.' && !saw_dot)
+    {
+      saw_dot = 1;
+      continue;
+    }
+
+    if (!rgf_is_digit(*p))
+    {
+      break;
+    }
+
+    digit_count++;
+
+    if (w == 0 && *p == '0')
+    {
+      exponent -= saw_dot;
+    }
+    else if (significant < 19)
+    {
+      w = w * 10 + (rgf_u64)(*p - '0');
+      exponent -= saw_dot;
+      significant++;
+    }
+    else
+    {
+      exponent += !saw_dot;
+      truncated |= *p != '0';
+    }
+  }
+
+  if (digit_count == 0)
+  {
+    *consumed = 0;
+    return 0.0f;
+  }
+
+  digits_end = p;
+
+  /* Exponent, only consumed if digits follow */
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    unsigned char *e = p + 1;
+    int negative_exponent = 0;
+
+    if (e < end && (*e == '-' || *e == '+'))
+    {
+      negative_exponent = *e == '-';
+      e++;
+    }
+
+    if (e < end && rgf_is_digit(*e))
+    {
+      for (; e < end && rgf_is_digit(*e); ++e)
+      {
+        /* Anything larger over/underflows anyway */
+        if (explicit_exponent < 100000L)
         {
-          current_index = current_index - 1; /* Convert to 0-based */
+          explicit_exponent = explicit_exponent * 10 + (*e - '0');
         }
-
-        face_indices_temp[face_vertices_count] = current_index;
-        face_vertices_count++;
       }
 
-      /* Triangulate the face using a fan method */
-      if (face_vertices_count >= 3)
+      explicit_exponent = negative_exponent ? -explicit_exponent : explicit_exponent;
+      exponent += explicit_exponent;
+      p = e;
+    }
+  }
+
+  *consumed = (int)(p - (unsigned char *)s);
+
+  if (w == 0)
+  {
+    return rgf_float_from_bits(sign);
+  }
+
+  /* The dropped digits lie between w and w + 1, both have to round the same */
+  if (rgf_float_eisel_lemire(w, exponent, &bits) &&
+      (!truncated || (rgf_float_eisel_lemire(w + 1, exponent, &bits_up) && bits_up == bits)))
+  {
+    return rgf_float_from_bits(bits | sign);
+  }
+
+  rgf_decimal_assign(&decimal, digits_begin, digits_end, explicit_exponent);
+
+  return rgf_float_from_bits(rgf_decimal_float_bits(&decimal) | sign);
+}
+
+#ifdef RGF_FLOAT_EXACT_ARITHMETIC
+/* Fast path of rgf_atof_n, returns 0 if the number needs rgf_atof_general. With unbounded
+   set the character before end can not continue a number, which stops every digit loop
+   before the end, so they skip the bounds checks.
+*/
+RGF_API RGF_FORCE_INLINE int rgf_atof_decimal(char *s, unsigned char *end, int unbounded, float *value, int *consumed)
+{
+  unsigned char *p = (unsigned char *)s;
+  unsigned char *digits_begin;
+  unsigned char *fraction_begin;
+  unsigned long fraction_digits = 0;
+  rgf_u64 w = 0;
+
+  if ((unbounded || p < end) && *p == '-')
+  {
+    p++;
+  }
+
+  digits_begin = p;
+
+  while ((unbounded || p < end) && rgf_is_digit(*p))
+  {
+    w = w * 10 + (rgf_u64)(*p - '0');
+    p++;
+  }
+
+  if ((unbounded || p < end) && *p == '.')
+  {
+    fraction_begin = ++p;
+
+    if (end - p >= 8 && rgf_is_eight_digits(rgf_load64_le(p)))
+    {
+      w = w * 100000000UL + rgf_parse_eight_digits(rgf_load64_le(p));
+      p += 8;
+    }
+
+    if (end - p >= 4 && rgf_is_four_digits(rgf_load32_le(p)))
+    {
+      w = w * 10000UL + rgf_parse_four_digits(rgf_load32_le(p));
+      p += 4;
+    }
+
+    while ((unbounded || p < end) && rgf_is_digit(*p))
+    {
+      w = w * 10 + (rgf_u64)(*p - '0');
+      p++;
+    }
+
+    fraction_digits = (unsigned long)(p - fraction_begin);
+    digits_begin++;
+  }
+
+  /* 1 to 19 digits can not overflow w, w and 10^fraction_digits are exact floats */
+  if ((unsigned long)(p - digits_begin) - 1 >= 19 || w > ((rgf_u64)1 << 24) || fraction_digits > 10 ||
+      ((unbounded || p < end) && (*p == 'e' || *p == 'E')))
+  {
+    return 0;
+  }
+
+  *value = (float)(long)w / rgf_float_power_of_ten[fraction_digits];
+  *value = *s == '-' ? -*value : *value;
+  *consumed = (int)(p - (unsigned char *)s);
+
+  return 1;
+}
+#endif
+
+/* Parses a decimal floating point number of at most length characters:
+   [+-] digits [. digits] [(e|E) [+-] digits]
+
+   The result is correctly rounded (nearest, ties to even). Plain decimals up to 2^24
+   with at most 10 decimal places (the common case in OBJ files) are accumulated into an
+   integer (8 and 4 fraction digits at a time with SWAR) and converted with one exact
+   float division. Everything else goes to rgf_atof_general. The digit loops skip their
+   bounds checks when the buffer ends in a character that can not continue a number (a
+   line break, NUL or blank, as in a whole OBJ file).
+   consumed receives the number of characters read, 0 if there is no number.
+*/
+RGF_API RGF_FORCE_INLINE float rgf_atof_n(char *s, unsigned long length, int *consumed)
+{
+#ifdef RGF_FLOAT_EXACT_ARITHMETIC
+  unsigned char *end = (unsigned char *)s + length;
+  float value;
+
+  if (length > 0 && !rgf_is_digit(end[-1]) && end[-1] != '.' && end[-1] != '-')
+  {
+    if (rgf_atof_decimal(s, end, 1, &value, consumed))
+    {
+      return value;
+    }
+  }
+  else if (rgf_atof_decimal(s, end, 0, &value, consumed))
+  {
+    return value;
+  }
+#endif
+
+  return rgf_atof_general(s, length, consumed);
+}
+
+/* Parses a float of a NUL terminated string, see rgf_atof_n */
+RGF_API RGF_INLINE float rgf_atof(char *s, int *consumed)
+{
+  unsigned long length = 0;
+
+  while (rgf_is_digit((unsigned char)s[length]) || s[length] == '.' || s[length] == '-' || s[length] == '+' || s[length] == 'e' || s[length] == 'E')
+  {
+    length++;
+  }
+
+  /* Includes the terminating character, which lets rgf_atof_n take its fast path */
+  return rgf_atof_n(s, length + 1, consumed);
+}
+
+/* ########################################################## */
+/* # Utility Vector Functions                                 */
+/* ########################################################## */
+/* 1 / sqrt(f) for a positive normal float: the halved exponent of the bit pattern is a
+   guess within 0.2% that two newton steps refine to float precision
+*/
+RGF_API RGF_INLINE float rgf_rsqrtf(float f)
+{
+  union
+  {
+    unsigned int u;
+    float f;
+  } value;
+  float r;
+
+  value.f = f;
+  value.u = 0x5f375a86U - (value.u >> 1);
+  r = value.f;
+
+  r = r * (1.5f - 0.5f * f * r * r);
+  r = r * (1.5f - 0.5f * f * r * r);
+
+  return r;
+}
+
+RGF_API RGF_INLINE float rgf_sqrtf(float f)
+{
+  float scale = 1.0f;
+  float r;
+  float s;
+
+  /* Infinity and NaN */
+  if (f - f != 0.0f)
+  {
+    return f;
+  }
+
+  if (f <= 0.0f)
+  {
+    return 0.0f;
+  }
+
+  /* Subnormals are scaled by 2^46 into the normal range first */
+  if (f < 1.17549435e-38f)
+  {
+    f *= 70368744177664.0f;
+    scale = 1.0f / 8388608.0f;
+  }
+
+  /* sqrt(f) = f * (1 / sqrt(f)), one newton step on the product corrects the last bits */
+  r = rgf_rsqrtf(f);
+  s = f * r;
+  s = s + 0.5f * r * (f - s * s);
+
+  return s * scale;
+}
+
+/* atan2 within 2e-6 radians: a minimax polynomial of atan on [0, 1] and the octant */
+RGF_API RGF_INLINE float rgf_atan2f(float y, float x)
+{
+  float ax = x < 0.0f ? -x : x;
+  float ay = y < 0.0f ? -y : y;
+  float t;
+  float s;
+  float r;
+
+  if (ax == 0.0f && ay == 0.0f)
+  {
+    return 0.0f;
+  }
+
+  t = (ay > ax ? ax : ay) / (ay > ax ? ay : ax);
+  s = t * t;
+  r = t * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+
+  if (ay > ax)
+  {
+    r = 1.57079637f - r;
+  }
+
+  if (x < 0.0f)
+  {
+    r = 3.14159274f - r;
+  }
+
+  return y < 0.0f ? -r : r;
+}
+
+RGF_API RGF_INLINE void rgf_v3_sub(float *out, float *a, float *b)
+{
+  out[0] = a[0] - b[0];
+  out[1] = a[1] - b[1];
+  out[2] = a[2] - b[2];
+}
+
+RGF_API RGF_INLINE void rgf_v3_add(float *out, float *a, float *b)
+{
+  out[0] = a[0] + b[0];
+  out[1] = a[1] + b[1];
+  out[2] = a[2] + b[2];
+}
+
+RGF_API RGF_INLINE void rgf_v3_cross(float *out, float *a, float *b)
+{
+  out[0] = a[1] * b[2] - a[2] * b[1];
+  out[1] = a[2] * b[0] - a[0] * b[2];
+  out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+RGF_API RGF_INLINE float rgf_v3_length(float *v)
+{
+  return rgf_sqrtf((v[0] * v[0] + v[1] * v[1] + v[2] * v[2]));
+}
+
+RGF_API RGF_INLINE float rgf_v3_dot(float *a, float *b)
+{
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/* Zero, infinite and NaN vectors normalize to zero */
+RGF_API RGF_INLINE void rgf_v3_normalize(float *out, float *v)
+{
+  float x = v[0];
+  float y = v[1];
+  float z = v[2];
+  float length_squared = x * x + y * y + z * z;
+  float inv_length;
+
+  /* The squared length under- or overflows, divide by the largest component first */
+  if (!(length_squared >= 1.17549435e-38f) || length_squared > 3.40282347e+38f)
+  {
+    float ax = x < 0.0f ? -x : x;
+    float ay = y < 0.0f ? -y : y;
+    float az = z < 0.0f ? -z : z;
+    float largest = ax > ay ? ax : ay;
+
+    largest = az > largest ? az : largest;
+    x /= largest;
+    y /= largest;
+    z /= largest;
+    length_squared = x * x + y * y + z * z;
+
+    if (!(length_squared >= 1.0f))
+    {
+      out[0] = out[1] = out[2] = 0.0f;
+      return;
+    }
+  }
+
+  /* Through the corrected square root, so unit vectors stay exactly unit */
+  inv_length = 1.0f / rgf_sqrtf(length_squared);
+
+  out[0] = x * inv_length;
+  out[1] = y * inv_length;
+  out[2] = z * inv_length;
+}
+
+#if defined(RGF_SIMD_SSE2)
+/* [first[i0], first[i1], second[j2], second[j3]] */
+#define RGF_SHUFFLE(first, second, i0, i1, j2, j3) _mm_shuffle_ps(first, second, _MM_SHUFFLE(j3, j2, i1, i0))
+#endif
+
+/* rgf_v3_normalize for count / 3 xyz interleaved vectors (out may be v). 4 vectors per
+   SIMD step are split into x, y and z registers and scaled by the hardware reciprocal
+   square root estimate after newton steps (one for the 12 bit SSE estimate, two for the
+   8 bit NEON one). Steps with a squared length out of the normal float range go through
+   rgf_v3_normalize. The result of a vector only depends on its position modulo 4.
+*/
+RGF_API RGF_INLINE void rgf_v3_normalize_batch(float *out, float *v, unsigned long count)
+{
+  unsigned long i = 0;
+
+#if defined(RGF_SIMD_SSE2)
+  __m128 smallest = _mm_set1_ps(1.17549435e-38f);
+  __m128 largest = _mm_set1_ps(3.40282347e+38f);
+  __m128 half = _mm_set1_ps(0.5f);
+  __m128 three_halves = _mm_set1_ps(1.5f);
+
+  for (; i + 12 <= count; i += 12)
+  {
+    __m128 a = _mm_loadu_ps(v + i);     /* x0 y0 z0 x1 */
+    __m128 b = _mm_loadu_ps(v + i + 4); /* y1 z1 x2 y2 */
+    __m128 c = _mm_loadu_ps(v + i + 8); /* z2 x3 y3 z3 */
+    __m128 x = RGF_SHUFFLE(RGF_SHUFFLE(a, b, 0, 3, 2, 2), RGF_SHUFFLE(b, c, 2, 2, 1, 1), 0, 1, 0, 2);
+    __m128 y = RGF_SHUFFLE(RGF_SHUFFLE(a, b, 1, 1, 0, 0), RGF_SHUFFLE(b, c, 3, 3, 2, 2), 0, 2, 0, 2);
+    __m128 z = RGF_SHUFFLE(RGF_SHUFFLE(a, b, 2, 2, 1, 1), RGF_SHUFFLE(c, c, 0, 0, 3, 3), 0, 2, 0, 2);
+    __m128 length_squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    __m128 r;
+
+    if (_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(length_squared, smallest), _mm_cmple_ps(length_squared, largest))) != 15)
+    {
+      rgf_v3_normalize(out + i, v + i);
+      rgf_v3_normalize(out + i + 3, v + i + 3);
+      rgf_v3_normalize(out + i + 6, v + i + 6);
+      rgf_v3_normalize(out + i + 9, v + i + 9);
+      continue;
+    }
+
+    r = _mm_rsqrt_ps(length_squared);
+    r = _mm_mul_ps(r, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, length_squared), _mm_mul_ps(r, r))));
+
+    x = _mm_mul_ps(x, r);
+    y = _mm_mul_ps(y, r);
+    z = _mm_mul_ps(z, r);
+
+    _mm_storeu_ps(out + i, RGF_SHUFFLE(RGF_SHUFFLE(x, y, 0, 0, 0, 0), RGF_SHUFFLE(z, x, 0, 0, 1, 1), 0, 2, 0, 2));
+    _mm_storeu_ps(out + i + 4, RGF_SHUFFLE(RGF_SHUFFLE(y, z, 1, 1, 1, 1), RGF_SHUFFLE(x, y, 2, 2, 2, 2), 0, 2, 0, 2));
+    _mm_storeu_ps(out + i + 8, RGF_SHUFFLE(RGF_SHUFFLE(z, x, 2, 2, 3, 3), RGF_SHUFFLE(y, z, 3, 3, 3, 3), 0, 2, 0, 2));
+  }
+#elif defined(RGF_SIMD_NEON)
+  float32x4_t smallest = vdupq_n_f32(1.17549435e-38f);
+  float32x4_t largest = vdupq_n_f32(3.40282347e+38f);
+
+  for (; i + 12 <= count; i += 12)
+  {
+    float32x4x3_t p = vld3q_f32(v + i);
+    float32x4_t length_squared = vaddq_f32(vaddq_f32(vmulq_f32(p.val[0], p.val[0]), vmulq_f32(p.val[1], p.val[1])), vmulq_f32(p.val[2], p.val[2]));
+    uint32x4_t valid = vandq_u32(vcgeq_f32(length_squared, smallest), vcleq_f32(length_squared, largest));
+    uint32x2_t valid_half = vand_u32(vget_low_u32(valid), vget_high_u32(valid));
+    float32x4_t r;
+
+    if (!(vget_lane_u32(valid_half, 0) & vget_lane_u32(valid_half, 1)))
+    {
+      rgf_v3_normalize(out + i, v + i);
+      rgf_v3_normalize(out + i + 3, v + i + 3);
+      rgf_v3_normalize(out + i + 6, v + i + 6);
+      rgf_v3_normalize(out + i + 9, v + i + 9);
+      continue;
+    }
+
+    r = vrsqrteq_f32(length_squared);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(length_squared, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(length_squared, r), r));
+
+    p.val[0] = vmulq_f32(p.val[0], r);
+    p.val[1] = vmulq_f32(p.val[1], r);
+    p.val[2] = vmulq_f32(p.val[2], r);
+
+    vst3q_f32(out + i, p);
+  }
+#endif
+
+  for (; i + 3 <= count; i += 3)
+  {
+    rgf_v3_normalize(out + i, v + i);
+  }
+}
+
+/* ########################################################## */
+/* # Job dispatch (optional multi-threading)                  */
+/* ########################################################## */
+typedef void (*rgf_job_function)(void *job_data, unsigned long job_index);
+
+typedef void (*rgf_job_dispatch_function)(
+    void *dispatch_context, /* User context (e.g. a thread pool)                    */
+    rgf_job_function job,   /* Function to run for every job index                  */
+    void *job_data,         /* Passed to every job                                  */
+    unsigned long job_count /* Jobs 0 to job_count - 1 have to run before returning */
+);
+
+typedef struct rgf_job_system
+{
+  rgf_job_dispatch_function dispatch; /* 0 runs all jobs serially on the calling thread */
+  void *dispatch_context;
+  unsigned long thread_count; /* Number of threads the dispatcher runs jobs on */
+
+} rgf_job_system;
+
+RGF_API RGF_INLINE unsigned long rgf_job_thread_count(rgf_job_system *jobs)
+{
+  return (jobs && jobs->dispatch && jobs->thread_count > 1) ? jobs->thread_count : 1;
+}
+
+RGF_API RGF_INLINE void rgf_job_run(rgf_job_system *jobs, rgf_job_function job, void *job_data, unsigned long job_count)
+{
+  unsigned long i;
+
+  if (job_count > 1 && rgf_job_thread_count(jobs) > 1)
+  {
+    jobs->dispatch(jobs->dispatch_context, job, job_data, job_count);
+    return;
+  }
+
+  for (i = 0; i < job_count; ++i)
+  {
+    job(job_data, i);
+  }
+}
+
+/* ########################################################## */
+/* # Bounding box reduction                                   */
+/* ########################################################## */
+/* Extends min and max (3 floats each) by the count / 3 xyz interleaved vertices. A SIMD
+   register of 4 (8 with AVX2) floats keeps every component at a fixed lane over the
+   3 registers of a step, so the lanes are only folded into xyz once at the end. NaN
+   components are skipped like by the scalar comparisons.
+*/
+RGF_API RGF_INLINE void rgf_bounds_reduce(float *min, float *max, float *vertices, unsigned long count)
+{
+  unsigned long i = 0;
+
+#if defined(RGF_SIMD_AVX2) || defined(RGF_SIMD_SSE2) || defined(RGF_SIMD_NEON)
+  {
+#if defined(RGF_SIMD_AVX2)
+#define RGF_BOUNDS_LANES 24
+#else
+#define RGF_BOUNDS_LANES 12
+#endif
+    float lanes_min[RGF_BOUNDS_LANES];
+    float lanes_max[RGF_BOUNDS_LANES];
+    unsigned long k;
+
+    for (k = 0; k < RGF_BOUNDS_LANES; ++k)
+    {
+      lanes_min[k] = min[k % 3];
+      lanes_max[k] = max[k % 3];
+    }
+
+#if defined(RGF_SIMD_AVX2)
+    {
+      __m256 min0 = _mm256_loadu_ps(lanes_min);
+      __m256 min1 = _mm256_loadu_ps(lanes_min + 8);
+      __m256 min2 = _mm256_loadu_ps(lanes_min + 16);
+      __m256 max0 = _mm256_loadu_ps(lanes_max);
+      __m256 max1 = _mm256_loadu_ps(lanes_max + 8);
+      __m256 max2 = _mm256_loadu_ps(lanes_max + 16);
+
+      /* min(v, m) returns m if v is NaN */
+      for (; i + 24 <= count; i += 24)
+      {
+        __m256 v0 = _mm256_loadu_ps(vertices + i);
+        __m256 v1 = _mm256_loadu_ps(vertices + i + 8);
+        __m256 v2 = _mm256_loadu_ps(vertices + i + 16);
+
+        min0 = _mm256_min_ps(v0, min0);
+        min1 = _mm256_min_ps(v1, min1);
+        min2 = _mm256_min_ps(v2, min2);
+        max0 = _mm256_max_ps(v0, max0);
+        max1 = _mm256_max_ps(v1, max1);
+        max2 = _mm256_max_ps(v2, max2);
+      }
+
+      _mm256_storeu_ps(lanes_min, min0);
+      _mm256_storeu_ps(lanes_min + 8, min1);
+      _mm256_storeu_ps(lanes_min + 16, min2);
+      _mm256_storeu_ps(lanes_max, max0);
+      _mm256_storeu_ps(lanes_max + 8, max1);
+      _mm256_storeu_ps(lanes_max + 16, max2);
+    }
+#elif defined(RGF_SIMD_SSE2)
+    {
+      __m128 min0 = _mm_loadu_ps(lanes_min);
+      __m128 min1 = _mm_loadu_ps(lanes_min + 4);
+      __m128 min2 = _mm_loadu_ps(lanes_min + 8);
+      __m128 max0 = _mm_loadu_ps(lanes_max);
+      __m128 max1 = _mm_loadu_ps(lanes_max + 4);
+      __m128 max2 = _mm_loadu_ps(lanes_max + 8);
+
+      /* min(v, m) returns m if v is NaN */
+      for (; i + 12 <= count; i += 12)
+      {
+        __m128 v0 = _mm_loadu_ps(vertices + i);
+        __m128 v1 = _mm_loadu_ps(vertices + i + 4);
+        __m128 v2 = _mm_loadu_ps(vertices + i + 8);
+
+        min0 = _mm_min_ps(v0, min0);
+        min1 = _mm_min_ps(v1, min1);
+        min2 = _mm_min_ps(v2, min2);
+        max0 = _mm_max_ps(v0, max0);
+        max1 = _mm_max_ps(v1, max1);
+        max2 = _mm_max_ps(v2, max2);
+      }
+
+      _mm_storeu_ps(lanes_min, min0);
+      _mm_storeu_ps(lanes_min + 4, min1);
+      _mm_storeu_ps(lanes_min + 8, min2);
+      _mm_storeu_ps(lanes_max, max0);
+      _mm_storeu_ps(lanes_max + 4, max1);
+      _mm_storeu_ps(lanes_max + 8, max2);
+    }
+#else
+    {
+      float32x4_t min0 = vld1q_f32(lanes_min);
+      float32x4_t min1 = vld1q_f32(lanes_min + 4);
+      float32x4_t min2 = vld1q_f32(lanes_min + 8);
+      float32x4_t max0 = vld1q_f32(lanes_max);
+      float32x4_t max1 = vld1q_f32(lanes_max + 4);
+      float32x4_t max2 = vld1q_f32(lanes_max + 8);
+
+      /* vminq_f32 would return NaN, select with the comparison instead */
+      for (; i + 12 <= count; i += 12)
+      {
+        float32x4_t v0 = vld1q_f32(vertices + i);
+        float32x4_t v1 = vld1q_f32(vertices + i + 4);
+        float32x4_t v2 = vld1q_f32(vertices + i + 8);
+
+        min0 = vbslq_f32(vcltq_f32(v0, min0), v0, min0);
+        min1 = vbslq_f32(vcltq_f32(v1, min1), v1, min1);
+        min2 = vbslq_f32(vcltq_f32(v2, min2), v2, min2);
+        max0 = vbslq_f32(vcgtq_f32(v0, max0), v0, max0);
+        max1 = vbslq_f32(vcgtq_f32(v1, max1), v1, max1);
+        max2 = vbslq_f32(vcgtq_f32(v2, max2), v2, max2);
+      }
+
+      vst1q_f32(lanes_min, min0);
+      vst1q_f32(lanes_min + 4, min1);
+      vst1q_f32(lanes_min + 8, min2);
+      vst1q_f32(lanes_max, max0);
+      vst1q_f32(lanes_max + 4, max1);
+      vst1q_f32(lanes_max + 8, max2);
+    }
+#endif
+
+    for (k = 0; k < RGF_BOUNDS_LANES; ++k)
+    {
+      if (lanes_min[k] < min[k % 3])
+      {
+        min[k % 3] = lanes_min[k];
+      }
+
+      if (lanes_max[k] > max[k % 3])
+      {
+        max[k % 3] = lanes_max[k];
+      }
+    }
+#undef RGF_BOUNDS_LANES
+  }
+#endif
+
+  for (; i + 3 <= count; i += 3)
+  {
+    unsigned long k;
+
+    for (k = 0; k < 3; ++k)
+    {
+      if (vertices[i + k] < min[k])
+      {
+        min[k] = vertices[i + k];
+      }
+
+      if (vertices[i + k] > max[k])
+      {
+        max[k] = vertices[i + k];
+      }
+    }
+  }
+}
+
+/* Vertices per job below which the reduction is not split further */
+#ifndef RGF_BOUNDS_JOB_VERTICES
+#define RGF_BOUNDS_JOB_VERTICES 262144
+#endif
+
+#ifndef RGF_BOUNDS_MAX_JOBS
+#define RGF_BOUNDS_MAX_JOBS 64
+#endif
+
+typedef struct rgf_bounds_range
+{
+  unsigned long begin; /* First float of the range      */
+  unsigned long end;   /* One after the last float      */
+  float min[3];
+  float max[3];
+
+} rgf_bounds_range;
+
+typedef struct rgf_bounds_reduction
+{
+  float *vertices;
+  rgf_bounds_range *ranges;
+
+} rgf_bounds_reduction;
+
+RGF_API void rgf_bounds_reduce_job(void *job_data, unsigned long job_index)
+{
+  rgf_bounds_reduction *reduction = (rgf_bounds_reduction *)job_data;
+  rgf_bounds_range *range = &reduction->ranges[job_index];
+
+  rgf_bounds_reduce(range->min, range->max, reduction->vertices + range->begin, range->end - range->begin);
+}
+
+/* rgf_bounds_reduce split into ranges of whole vertices that are reduced through the job
+   system, the bounds of the ranges are folded on the calling thread
+*/
+RGF_API RGF_INLINE void rgf_bounds_reduce_parallel(float *min, float *max, float *vertices, unsigned long count, rgf_job_system *jobs)
+{
+  rgf_bounds_range ranges[RGF_BOUNDS_MAX_JOBS];
+  rgf_bounds_reduction reduction;
+  unsigned long vertex_count = count / 3;
+  unsigned long range_count = vertex_count / RGF_BOUNDS_JOB_VERTICES;
+  unsigned long i;
+
+  if (range_count > rgf_job_thread_count(jobs))
+  {
+    range_count = rgf_job_thread_count(jobs);
+  }
+
+  if (range_count > RGF_BOUNDS_MAX_JOBS)
+  {
+    range_count = RGF_BOUNDS_MAX_JOBS;
+  }
+
+  if (range_count <= 1)
+  {
+    rgf_bounds_reduce(min, max, vertices, count);
+    return;
+  }
+
+  for (i = 0; i < range_count; ++i)
+  {
+    ranges[i].begin = vertex_count / range_count * i * 3;
+    ranges[i].end = i + 1 == range_count ? vertex_count * 3 : vertex_count / range_count * (i + 1) * 3;
+    ranges[i].min[0] = min[0];
+    ranges[i].min[1] = min[1];
+    ranges[i].min[2] = min[2];
+    ranges[i].max[0] = max[0];
+    ranges[i].max[1] = max[1];
+    ranges[i].max[2] = max[2];
+  }
+
+  reduction.vertices = vertices;
+  reduction.ranges = ranges;
+
+  rgf_job_run(jobs, rgf_bounds_reduce_job, &reduction, range_count);
+
+  for (i = 0; i < range_count; ++i)
+  {
+    rgf_bounds_reduce(min, max, ranges[i].min, 3);
+    rgf_bounds_reduce(min, max, ranges[i].max, 3);
+  }
+}
+
+/* ########################################################## */
+/* # Growable arena (chunked, memory supplied by the caller)  */
+/* ########################################################## */
+typedef void *(*rgf_allocate_function)(void *allocate_context, unsigned long size);
+
+typedef struct rgf_arena_block
+{
+  struct rgf_arena_block *next;
+  unsigned long size;     /* Bytes used in this block                  */
+  unsigned long capacity; /* Bytes available after this block header  */
+
+} rgf_arena_block;
+
+/* An append only byte stream stored in a list of blocks. Full blocks are never moved
+   or copied, a new block is requested from the allocate callback instead.
+*/
+typedef struct rgf_arena
+{
+  rgf_allocate_function allocate; /* Returns 0 if out of memory, 0 = no growing */
+  void *allocate_context;
+  unsigned long block_capacity; /* Minimum payload bytes of a new block */
+
+  rgf_arena_block *first;
+  rgf_arena_block *last;
+  unsigned long size; /* Total bytes pushed */
+
+} rgf_arena;
+
+RGF_API RGF_INLINE void rgf_arena_init(
+    rgf_arena *arena,
+    void *memory,                   /* Optional first block (4 byte aligned), can be 0 */
+    unsigned long memory_size,      /* Size of memory in bytes                         */
+    rgf_allocate_function allocate, /* Optional block allocator, can be 0              */
+    void *allocate_context,         /* Passed to allocate                              */
+    unsigned long block_capacity    /* Minimum payload bytes for allocated blocks      */
+)
+{
+  arena->allocate = allocate;
+  arena->allocate_context = allocate_context;
+  arena->block_capacity = block_capacity;
+  arena->first = 0;
+  arena->last = 0;
+  arena->size = 0;
+
+  if (memory && memory_size > (unsigned long)sizeof(rgf_arena_block))
+  {
+    arena->first = arena->last = (rgf_arena_block *)memory;
+    arena->first->next = 0;
+    arena->first->size = 0;
+    arena->first->capacity = memory_size - (unsigned long)sizeof(rgf_arena_block);
+  }
+}
+
+RGF_API RGF_INLINE unsigned char *rgf_arena_block_data(rgf_arena_block *block)
+{
+  return (unsigned char *)(block + 1);
+}
+
+/* Reserves size contiguous bytes at the end of the arena, returns 0 if out of memory */
+RGF_API RGF_INLINE void *rgf_arena_push(rgf_arena *arena, unsigned long size)
+{
+  unsigned char *data;
+
+  if (!arena->last || arena->last->capacity - arena->last->size < size)
+  {
+    rgf_arena_block *block;
+    unsigned long capacity = arena->block_capacity > size ? arena->block_capacity : size;
+
+    if (!arena->allocate)
+    {
+      return 0;
+    }
+
+    block = (rgf_arena_block *)arena->allocate(arena->allocate_context, (unsigned long)sizeof(rgf_arena_block) + capacity);
+
+    if (!block)
+    {
+      return 0;
+    }
+
+    block->next = 0;
+    block->size = 0;
+    block->capacity = capacity;
+
+    if (arena->last)
+    {
+      arena->last->next = block;
+    }
+    else
+    {
+      arena->first = block;
+    }
+
+    arena->last = block;
+  }
+
+  data = rgf_arena_block_data(arena->last) + arena->last->size;
+  arena->last->size += size;
+  arena->size += size;
+
+  return data;
+}
+
+/* Pointer to the arena contents if they are stored in one block, otherwise 0 */
+RGF_API RGF_INLINE void *rgf_arena_data(rgf_arena *arena)
+{
+  rgf_arena_block *block = arena->first;
+
+  while (block && block->size == 0)
+  {
+    block = block->next;
+  }
+
+  if (!block || block->size != arena->size)
+  {
+    return 0;
+  }
+
+  return rgf_arena_block_data(block);
+}
+
+/* Copies the arena contents into one contiguous buffer of at least arena->size bytes */
+RGF_API RGF_INLINE void rgf_arena_copy(rgf_arena *arena, void *out)
+{
+  unsigned char *ptr = (unsigned char *)out;
+  rgf_arena_block *block;
+
+  for (block = arena->first; block; block = block->next)
+  {
+    rgf_binary_memcpy(ptr, rgf_arena_block_data(block), block->size);
+    ptr += block->size;
+  }
+}
+
+/* ########################################################## */
+/* # OBJ to RGF conversion funciton                           */
+/* ########################################################## */
+
+#define RGF_OBJ_BLOCK_SIZE 64
+
+#if defined(RGF_SIMD_NEON)
+RGF_API RGF_INLINE unsigned long rgf_obj_neon_movemask(uint8x16_t v)
+{
+  static const unsigned char bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t masked = vandq_u8(v, vld1q_u8(bits));
+  uint8x8_t sum = vpadd_u8(vget_low_u8(masked), vget_high_u8(masked));
+  sum = vpadd_u8(sum, sum);
+  sum = vpadd_u8(sum, sum);
+  return (unsigned long)vget_lane_u8(sum, 0) | ((unsigned long)vget_lane_u8(sum, 1) << 8);
+}
+#endif
+
+#if !defined(RGF_SIMD_AVX2) && !defined(RGF_SIMD_SSE2) && !defined(RGF_SIMD_NEON)
+/* SWAR fallback: 8 bytes per step, the high bit of each byte lane holds the result */
+#define RGF_SWAR_ONES ((((rgf_u64)0x01010101UL) << 32) | 0x01010101UL)
+#define RGF_SWAR_LOW (RGF_SWAR_ONES * 0x7F)
+#define RGF_SWAR_HIGH (RGF_SWAR_ONES * 0x80)
+
+RGF_API RGF_INLINE rgf_u64 rgf_swar_load(unsigned char *p)
+{
+  return ((rgf_u64)p[0]) | ((rgf_u64)p[1] << 8) | ((rgf_u64)p[2] << 16) | ((rgf_u64)p[3] << 24) |
+         ((rgf_u64)p[4] << 32) | ((rgf_u64)p[5] << 40) | ((rgf_u64)p[6] << 48) | ((rgf_u64)p[7] << 56);
+}
+
+RGF_API RGF_INLINE rgf_u64 rgf_swar_eq(rgf_u64 x, unsigned char c)
+{
+  rgf_u64 t = x ^ (RGF_SWAR_ONES * c);
+  return ~(((t & RGF_SWAR_LOW) + RGF_SWAR_LOW) | t | RGF_SWAR_LOW);
+}
+
+/* Gathers the 8 lane high bits into the lowest byte */
+RGF_API RGF_INLINE rgf_u64 rgf_swar_movemask(rgf_u64 x)
+{
+  return (((x & RGF_SWAR_HIGH) >> 7) * ((((rgf_u64)0x01020408UL) << 32) | 0x10204080UL)) >> 56;
+}
+#endif
+
+/* Bit mask of the '\n' bytes in a 64 byte block (bit n represents byte n) */
+RGF_API RGF_INLINE rgf_u64 rgf_obj_block_newlines(unsigned char *block)
+{
+  rgf_u64 newlines = 0;
+  int i;
+
+#if defined(RGF_SIMD_AVX2)
+  __m256i nl = _mm256_set1_epi8('\n');
+
+  for (i = 0; i < RGF_OBJ_BLOCK_SIZE; i += 32)
+  {
+    __m256i c = _mm256_loadu_si256((__m256i *)(void *)(block + i));
+    newlines |= (rgf_u64)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, nl)) << i;
+  }
+#elif defined(RGF_SIMD_SSE2)
+  __m128i nl = _mm_set1_epi8('\n');
+
+  for (i = 0; i < RGF_OBJ_BLOCK_SIZE; i += 16)
+  {
+    __m128i c = _mm_loadu_si128((__m128i *)(void *)(block + i));
+    newlines |= (rgf_u64)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(c, nl)) << i;
+  }
+#elif defined(RGF_SIMD_NEON)
+  for (i = 0; i < RGF_OBJ_BLOCK_SIZE; i += 16)
+  {
+    uint8x16_t c = vld1q_u8(block + i);
+    newlines |= (rgf_u64)rgf_obj_neon_movemask(vceqq_u8(c, vdupq_n_u8('\n'))) << i;
+  }
+#else
+  for (i = 0; i < RGF_OBJ_BLOCK_SIZE; i += 8)
+  {
+    newlines |= rgf_swar_movemask(rgf_swar_eq(rgf_swar_load(block + i), '\n')) << i;
+  }
+#endif
+
+  return newlines;
+}
+
+/* Bit mask of the bytes in a 64 byte block that start a face index: a digit or '-'
+   following one of ' ', '\t', '\r', '\n'. carry_space is 1 if the byte before the
+   block is a space.
+*/
+RGF_API RGF_INLINE rgf_u64 rgf_obj_block_tokens(unsigned char *block, rgf_u64 carry_space)
+{
+  rgf_u64 spaces = 0;
+  rgf_u64 numbers = 0;
+  int i;
+
+#if defined(RGF_SIMD_AVX2)
+  __m256i nl = _mm256_set1_epi8('\n');
+  __m256i sp = _mm256_set1_epi8(' ');
+  __m256i tab = _mm256_set1_epi8('\t');
+  __m256i cr = _mm256_set1_epi8('\r');
+  __m256i zero = _mm256_set1_epi8('0');
+  __m256i nine = _mm256_set1_epi8('9');
+  __m256i minus = _mm256_set1_epi8('-');
+
+  for (i = 0; i < RGF_OBJ_BLOCK_SIZE; i += 32)
+  {
+    __m256i c = _mm256_loadu_si256((__m256i *)(void *)(block + i));
+    __m256i is_sp = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(c, nl), _mm256_cmpeq_epi8(c, sp)), _mm256_or_si256(_mm256_cmpeq_epi8(c, tab), _mm256_cmpeq_epi8(c, cr)));
+    __m256i is_digit = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(c, zero), c), _mm256_cmpeq_epi8(_mm256_min_epu8(c, nine), c));
+    __m256i is_num = _mm256_or_si256(is_digit, _mm256_cmpeq_epi8(c, minus));
+
+    spaces |= (rgf_u64)(unsigned int)_mm256_movemask_epi8(is_sp) << i;
+    numbers |= (rgf_u64)(unsigned int)_mm256_movemask_epi8(is_num) << i;
+  }
+#elif defined(RGF_SIMD_SSE2)
+  __m128i nl = _mm_set1_epi8('\n');
+  __m128i sp = _mm_set1_epi8(' ');
+  __m128i tab = _mm_set1_epi8('\t');
+  __m128i cr = _mm_set1_epi8('\r');
+  __m128i zero = _mm_set1_epi8('0');
+  __m128i nine = _mm_set1_epi8('9');
+  __m128i minus = _mm_set1_epi8('-');
+
+  for (i = 0; i < RGF_OBJ_BLOCK_SIZE; i += 16)
+  {
+    __m128i c = _mm_loadu_si128((__m128i *)(void *)(block + i));
+    __m128i is_sp = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, nl), _mm_cmpeq_epi8(c, sp)), _mm_or_si128(_mm_cmpeq_epi8(c, tab), _mm_cmpeq_epi8(c, cr)));
+    __m128i is_digit = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(c, zero), c), _mm_cmpeq_epi8(_mm_min_epu8(c, nine), c));
+    __m128i is_num = _mm_or_si128(is_digit, _mm_cmpeq_epi8(c, minus));
+
+    spaces |= (rgf_u64)(unsigned int)_mm_movemask_epi8(is_sp) << i;
+    numbers |= (rgf_u64)(unsigned int)_mm_movemask_epi8(is_num) << i;
+  }
+#elif defined(RGF_SIMD_NEON)
+  for (i = 0; i < RGF_OBJ_BLOCK_SIZE; i += 16)
+  {
+    uint8x16_t c = vld1q_u8(block + i);
+    uint8x16_t is_sp = vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8('\n')), vceqq_u8(c, vdupq_n_u8(' '))), vorrq_u8(vceqq_u8(c, vdupq_n_u8('\t')), vceqq_u8(c, vdupq_n_u8('\r'))));
+    uint8x16_t is_digit = vandq_u8(vcgeq_u8(c, vdupq_n_u8('0')), vcleq_u8(c, vdupq_n_u8('9')));
+    uint8x16_t is_num = vorrq_u8(is_digit, vceqq_u8(c, vdupq_n_u8('-')));
+
+    spaces |= (rgf_u64)rgf_obj_neon_movemask(is_sp) << i;
+    numbers |= (rgf_u64)rgf_obj_neon_movemask(is_num) << i;
+  }
+#else
+  for (i = 0; i < RGF_OBJ_BLOCK_SIZE; i += 8)
+  {
+    rgf_u64 x = rgf_swar_load(block + i);
+    rgf_u64 ascii = x & RGF_SWAR_LOW;
+    rgf_u64 is_sp = rgf_swar_eq(x, '\n') | rgf_swar_eq(x, ' ') | rgf_swar_eq(x, '\t') | rgf_swar_eq(x, '\r');
+    rgf_u64 is_digit = (ascii + RGF_SWAR_ONES * (0x80 - '0')) & ~(ascii + RGF_SWAR_ONES * (0x80 - '9' - 1)) & ~x;
+
+    spaces |= rgf_swar_movemask(is_sp) << i;
+    numbers |= rgf_swar_movemask(is_digit | rgf_swar_eq(x, '-')) << i;
+  }
+#endif
+
+  return numbers & ((spaces << 1) | carry_space);
+}
+
+typedef struct rgf_obj_counts
+{
+  unsigned long vertex_count;   /* Number of "v " lines                         */
+  unsigned long uv_count;       /* Number of "vt" lines                         */
+  unsigned long normal_count;   /* Number of "vn" lines                         */
+  unsigned long triangle_count; /* Triangles after fan triangulating "f " lines */
+  unsigned long corner_count;   /* Vertex references of all "f " lines          */
+  unsigned long submesh_count;  /* Runs of faces split by "o", "g" and "usemtl" */
+
+} rgf_obj_counts;
+
+/* Checks if the line starting at obj_binary[line] begins with the keyword */
+RGF_API RGF_INLINE int rgf_obj_line_is(unsigned char *obj_binary, unsigned long obj_binary_size, unsigned long line, char *keyword)
+{
+  while (*keyword)
+  {
+    if (line >= obj_binary_size || obj_binary[line] != (unsigned char)*keyword)
+    {
+      return 0;
+    }
+
+    line++;
+    keyword++;
+  }
+
+  return line < obj_binary_size && rgf_is_space((char)obj_binary[line]);
+}
+
+#define RGF_OBJ_LINE_GROUP 1    /* "o" or "g" line */
+#define RGF_OBJ_LINE_MATERIAL 2 /* "usemtl" line   */
+
+/* Checks if the line starting at obj_binary[line] begins a new submesh, returns 0 or RGF_OBJ_LINE_* */
+RGF_API RGF_INLINE int rgf_obj_submesh_line(unsigned char *obj_binary, unsigned long obj_binary_size, unsigned long line)
+{
+  if (line + 1 < obj_binary_size && (obj_binary[line] == 'o' || obj_binary[line] == 'g') && rgf_is_space((char)obj_binary[line + 1]))
+  {
+    return RGF_OBJ_LINE_GROUP;
+  }
+
+  return rgf_obj_line_is(obj_binary, obj_binary_size, line, "usemtl") ? RGF_OBJ_LINE_MATERIAL : 0;
+}
+
+/* Counts the vertices, uvs, normals, triangles, face corners and submeshes of an OBJ buffer.
+
+   The buffer is classified in 64 byte blocks into newline/space/number bit masks
+   so that only line starts are inspected byte wise. Face vertices are the number
+   of tokens starting with a digit or '-' after the "f " prefix.
+
+   A submesh is a run of faces. The buffer begins a submesh and every "o", "g" or
+   "usemtl" line begins a new one, groups without faces are not counted.
+*/
+RGF_API RGF_INLINE void rgf_obj_count(
+    rgf_obj_counts *counts,       /* The resulting line counts */
+    unsigned char *obj_binary,    /* OBJ File binary buffer    */
+    unsigned long obj_binary_size /* OBJ File binary buffer size */
+)
+{
+  unsigned char tail[RGF_OBJ_BLOCK_SIZE];
+  unsigned long base;
+  unsigned long face_vertices_count = 0;
+  int in_face = 0;
+  int submesh_pending = 1;
+  rgf_u64 carry_newline = 1; /* The buffer begins with a line start */
+
+  counts->vertex_count = 0;
+  counts->uv_count = 0;
+  counts->normal_count = 0;
+  counts->triangle_count = 0;
+  counts->corner_count = 0;
+  counts->submesh_count = 0;
+
+  for (base = 0; base < obj_binary_size; base += RGF_OBJ_BLOCK_SIZE)
+  {
+    unsigned char *block = obj_binary + base;
+    unsigned long cursor = 0;
+    int has_tokens = 0;
+    rgf_u64 newlines, line_starts;
+    rgf_u64 tokens = 0;
+
+    /* Pad the last partial block with spaces so it can be classified as a whole */
+    if (obj_binary_size - base < RGF_OBJ_BLOCK_SIZE)
+    {
+      unsigned long j;
+
+      for (j = 0; j < RGF_OBJ_BLOCK_SIZE; ++j)
+      {
+        tail[j] = base + j < obj_binary_size ? obj_binary[base + j] : (unsigned char)' ';
+      }
+
+      block = tail;
+    }
+
+    newlines = rgf_obj_block_newlines(block);
+    line_starts = (newlines << 1) | carry_newline;
+    carry_newline = newlines >> 63;
+
+    /* Face index tokens are only classified for blocks that contain a face line */
+#define RGF_OBJ_BLOCK_FACE_VERTICES(from, to)                                                                        \
+  if (!has_tokens)                                                                                                   \
+  {                                                                                                                  \
+    tokens = rgf_obj_block_tokens(block, (rgf_u64)(base == 0 || rgf_is_space((char)obj_binary[base - 1])));          \
+    has_tokens = 1;                                                                                                  \
+  }                                                                                                                  \
+  face_vertices_count += rgf_popcount64(tokens & rgf_bit_range64((from), (to)))
+
+    while (line_starts)
+    {
+      unsigned long bit = rgf_ctz64(line_starts);
+      unsigned long line = base + bit;
+
+      line_starts &= line_starts - 1;
+
+      /* The previous line ends here */
+      if (in_face)
+      {
+        RGF_OBJ_BLOCK_FACE_VERTICES(cursor, bit);
+
+        if (face_vertices_count >= 3)
+        {
+          counts->triangle_count += face_vertices_count - 2;
+        }
+
+        counts->corner_count += face_vertices_count;
+        in_face = 0;
+      }
+
+      if (line + 1 >= obj_binary_size)
+      {
+        continue;
+      }
+
+      if (obj_binary[line] == 'v' && obj_binary[line + 1] == ' ')
+      {
+        counts->vertex_count++;
+      }
+      else if (obj_binary[line] == 'v' && obj_binary[line + 1] == 't')
+      {
+        counts->uv_count++;
+      }
+      else if (obj_binary[line] == 'v' && obj_binary[line + 1] == 'n')
+      {
+        counts->normal_count++;
+      }
+      else if (obj_binary[line] == 'f' && obj_binary[line + 1] == ' ')
+      {
+        in_face = 1;
+        face_vertices_count = 0;
+        cursor = bit;
+
+        counts->submesh_count += (unsigned long)submesh_pending;
+        submesh_pending = 0;
+      }
+      else if (rgf_obj_submesh_line(obj_binary, obj_binary_size, line))
+      {
+        submesh_pending = 1;
+      }
+    }
+
+    /* Face line continues into the next block */
+    if (in_face)
+    {
+      RGF_OBJ_BLOCK_FACE_VERTICES(cursor, RGF_OBJ_BLOCK_SIZE);
+    }
+
+#undef RGF_OBJ_BLOCK_FACE_VERTICES
+  }
+
+  if (in_face)
+  {
+    counts->corner_count += face_vertices_count;
+
+    if (face_vertices_count >= 3)
+    {
+      counts->triangle_count += face_vertices_count - 2;
+    }
+  }
+}
+
+/* A hash table slot of rgf_parse_obj_welded */
+typedef struct rgf_obj_weld_slot
+{
+  int v;     /* 0-based "v" index                    */
+  int vt;    /* 0-based "vt" index, -1 = not given   */
+  int vn;    /* 0-based "vn" index, -1 = not given   */
+  int index; /* Welded vertex index, -1 = empty slot */
+
+} rgf_obj_weld_slot;
+
+/* Most chunks rgf_parse_obj_parallel splits a buffer into */
+#ifndef RGF_OBJ_MAX_CHUNKS
+#define RGF_OBJ_MAX_CHUNKS 256
+#endif
+
+/* Exact output sizes of an OBJ buffer, see rgf_obj_measure. The vertex array sizes are the
+   ones of rgf_parse_obj, rgf_parse_obj_welded emits a vertex per unique face corner
+   instead (at most weld_vertex_capacity) and sets the model sizes to the welded count.
+*/
+typedef struct rgf_obj_measurement
+{
+  rgf_obj_counts counts;
+
+  unsigned long vertices_size; /* Number of floats in model->vertices  */
+  unsigned long uvs_size;      /* Number of floats in model->uvs       */
+  unsigned long normals_size;  /* Number of floats of the "vn" lines   */
+  unsigned long indices_size;  /* Number of ints in model->indices     */
+  unsigned long submeshes_size; /* Number of entries in model->submeshes */
+
+  unsigned long vertices_bytes;
+  unsigned long uvs_bytes;
+  unsigned long normals_bytes;
+  unsigned long indices_bytes;
+  unsigned long submeshes_bytes;
+
+  unsigned long total_bytes; /* Sum of all array bytes, one allocation fits every array */
+
+  unsigned long parallel_submeshes_size;  /* Entries rgf_parse_obj_parallel needs in model->submeshes */
+  unsigned long parallel_submeshes_bytes; /* before the submeshes of its chunks are joined          */
+
+  unsigned long weld_vertex_capacity; /* Vertices rgf_parse_obj_welded emits at most       */
+  unsigned long weld_table_size;      /* Hash slots of rgf_parse_obj_welded, a power of 2 */
+  unsigned long weld_scratch_bytes;   /* Scratch bytes rgf_parse_obj_welded needs         */
+
+} rgf_obj_measurement;
+
+/* Measures the exact array sizes rgf_parse_obj will produce for an OBJ buffer without
+   touching any model. Runs the same counting pass rgf_parse_obj runs first, so callers
+   can allocate a single right sized block per asset before parsing.
+*/
+RGF_API RGF_INLINE int rgf_obj_measure(
+    rgf_obj_measurement *measurement, /* The resulting counts and sizes */
+    unsigned char *obj_binary,        /* OBJ File binary buffer         */
+    unsigned long obj_binary_size     /* OBJ File binary buffer size    */
+)
+{
+  if (!measurement || !obj_binary || obj_binary_size <= 0)
+  {
+    return 0;
+  }
+
+  rgf_obj_count(&measurement->counts, obj_binary, obj_binary_size);
+
+  measurement->vertices_size = measurement->counts.vertex_count * 3;
+  measurement->uvs_size = measurement->counts.uv_count * 2;
+  measurement->normals_size = measurement->counts.normal_count * 3;
+  measurement->indices_size = measurement->counts.triangle_count * 3;
+  measurement->submeshes_size = measurement->counts.submesh_count;
+
+  measurement->vertices_bytes = measurement->vertices_size * (unsigned long)sizeof(float);
+  measurement->uvs_bytes = measurement->uvs_size * (unsigned long)sizeof(float);
+  measurement->normals_bytes = measurement->normals_size * (unsigned long)sizeof(float);
+  measurement->indices_bytes = measurement->indices_size * (unsigned long)sizeof(int);
+  measurement->submeshes_bytes = measurement->submeshes_size * (unsigned long)sizeof(rgf_submesh);
+
+  measurement->total_bytes = measurement->vertices_bytes +
+                             measurement->uvs_bytes +
+                             measurement->normals_bytes +
+                             measurement->indices_bytes +
+                             measurement->submeshes_bytes;
+
+  /* Every chunk of the parallel parse begins a submesh of its own */
+  measurement->parallel_submeshes_size = measurement->submeshes_size + RGF_OBJ_MAX_CHUNKS;
+  measurement->parallel_submeshes_bytes = measurement->parallel_submeshes_size * (unsigned long)sizeof(rgf_submesh);
+
+  /* Every face corner can become a welded vertex, the hash table is kept at most half full */
+  measurement->weld_vertex_capacity = measurement->counts.corner_count;
+  measurement->weld_table_size = 16;
+
+  while (measurement->weld_table_size < measurement->weld_vertex_capacity * 2)
+  {
+    measurement->weld_table_size *= 2;
+  }
+
+  measurement->weld_scratch_bytes = measurement->weld_table_size * (unsigned long)sizeof(rgf_obj_weld_slot) +
+                                    measurement->vertices_bytes +
+                                    measurement->uvs_bytes +
+                                    measurement->normals_bytes;
+
+  return 1;
+}
+
+/* A line aligned byte range of an OBJ buffer and where its data goes in the model arrays */
+typedef struct rgf_obj_chunk
+{
+  unsigned long begin; /* First byte, always at the start of a line */
+  unsigned long end;   /* One past the last byte                     */
+
+  rgf_obj_counts counts;
+
+  unsigned long vertex_offset; /* First float written to model->vertices */
+  unsigned long uv_offset;     /* First float written to model->uvs      */
+  unsigned long index_offset;  /* First int written to model->indices    */
+
+  float min[3]; /* Bounds of the vertices in this chunk */
+  float max[3];
+
+  /* Submesh ranges, joined across the chunks by rgf_obj_submeshes_join */
+  unsigned long submesh_offset;    /* First entry written to model->submeshes                    */
+  unsigned long submesh_written;   /* Entries written by this chunk                              */
+  unsigned long submesh_inherited; /* Leading entries using the material of the previous chunks  */
+  unsigned long material_hash;     /* Material of the last "usemtl" line                         */
+  int material_set;                /* The chunk has a "usemtl" line                              */
+  int submesh_boundary;            /* The chunk has an "o", "g" or "usemtl" line                 */
+  int submesh_pending;             /* The next face begins a new submesh                         */
+  int submesh_continued;           /* The first entry has no "o", "g" or "usemtl" line before it */
+
+} rgf_obj_chunk;
+
+RGF_API RGF_INLINE int rgf_obj_is_number_start(unsigned char c)
+{
+  return (c >= '0' && c <= '9') || c == '-';
+}
+
+/* Skips spaces and tabs but never crosses the end of a line */
+RGF_API RGF_INLINE unsigned long rgf_obj_skip_blanks(unsigned char *obj_binary, unsigned long i, unsigned long end)
+{
+  while (i < end && (obj_binary[i] == ' ' || obj_binary[i] == '\t'))
+  {
+    i++;
+  }
+
+  return i;
+}
+
+/* Parses count whitespace separated floats of a line */
+RGF_API RGF_INLINE unsigned long rgf_obj_parse_floats(unsigned char *obj_binary, unsigned long i, unsigned long end, float *out, int count)
+{
+  int consumed = 0;
+  int k;
+
+  for (k = 0; k < count; ++k)
+  {
+    i = rgf_obj_skip_blanks(obj_binary, i, end);
+    out[k] = rgf_atof_n((char *)(obj_binary + i), end - i, &consumed);
+    i += (unsigned long)consumed;
+  }
+
+  return i;
+}
+
+RGF_API RGF_INLINE void rgf_obj_submesh_init(rgf_obj_chunk *chunk)
+{
+  chunk->submesh_written = 0;
+  chunk->submesh_inherited = 0;
+  chunk->material_hash = 0;
+  chunk->material_set = 0;
+  chunk->submesh_boundary = 0;
+  chunk->submesh_pending = 1;
+  chunk->submesh_continued = 0;
+}
+
+/* Records an "o", "g" or "usemtl" line starting at obj_binary[i] */
+RGF_API RGF_INLINE void rgf_obj_submesh_line_parse(rgf_obj_chunk *chunk, unsigned char *obj_binary, unsigned long i, unsigned long end, int line_type)
+{
+  unsigned long name_end;
+
+  chunk->submesh_boundary = 1;
+  chunk->submesh_pending = 1;
+
+  if (line_type != RGF_OBJ_LINE_MATERIAL)
+  {
+    return;
+  }
+
+  /* The material name is the rest of the line without surrounding blanks */
+  i = rgf_obj_skip_blanks(obj_binary, i + 6, end);
+  name_end = i;
+
+  while (name_end < end && obj_binary[name_end] != '\n')
+  {
+    name_end++;
+  }
+
+  while (name_end > i && rgf_is_space((char)obj_binary[name_end - 1]))
+  {
+    name_end--;
+  }
+
+  chunk->material_hash = rgf_hash_fnv1a(obj_binary + i, name_end - i);
+  chunk->material_set = 1;
+}
+
+/* Adds the indices [index_begin, index_end) of a face to the current submesh */
+RGF_API RGF_INLINE void rgf_obj_submesh_face(rgf_submesh *submeshes, rgf_obj_chunk *chunk, unsigned long index_begin, unsigned long index_end)
+{
+  rgf_submesh *submesh;
+
+  if (chunk->submesh_pending)
+  {
+    submesh = &submeshes[chunk->submesh_offset + chunk->submesh_written];
+    submesh->index_offset = (unsigned int)index_begin;
+    submesh->material_hash = (unsigned int)chunk->material_hash;
+
+    if (chunk->submesh_written == 0)
+    {
+      chunk->submesh_continued = !chunk->submesh_boundary;
+    }
+
+    if (!chunk->material_set)
+    {
+      chunk->submesh_inherited++;
+    }
+
+    chunk->submesh_written++;
+    chunk->submesh_pending = 0;
+  }
+
+  submesh = &submeshes[chunk->submesh_offset + chunk->submesh_written - 1];
+  submesh->index_count = (unsigned int)(index_end - submesh->index_offset);
+}
+
+/* Compacts the submeshes of all chunks in place and returns their number. A chunk begins
+   a submesh even if it only continues the faces of the previous chunk, these are merged
+   back, and submeshes before the first "usemtl" of a chunk get the material of the
+   previous chunks.
+*/
+RGF_API RGF_INLINE unsigned long rgf_obj_submeshes_join(rgf_submesh *submeshes, rgf_obj_chunk *chunks, unsigned long chunk_count)
+{
+  unsigned long count = 0;
+  unsigned long material_hash = 0;
+  unsigned long i, j;
+  int pending = 1;
+
+  for (i = 0; i < chunk_count; ++i)
+  {
+    rgf_obj_chunk *chunk = &chunks[i];
+
+    for (j = 0; j < chunk->submesh_written; ++j)
+    {
+      rgf_submesh submesh = submeshes[chunk->submesh_offset + j];
+
+      if (j < chunk->submesh_inherited)
+      {
+        submesh.material_hash = (unsigned int)material_hash;
+      }
+
+      if (j == 0 && chunk->submesh_continued && !pending)
+      {
+        submeshes[count - 1].index_count += submesh.index_count;
+        continue;
+      }
+
+      submeshes[count++] = submesh;
+    }
+
+    if (chunk->material_set)
+    {
+      material_hash = chunk->material_hash;
+    }
+
+    pending = chunk->submesh_written > 0 ? chunk->submesh_pending : (pending || chunk->submesh_boundary);
+  }
+
+  return count;
+}
+
+/* Parses the vertex indices of a face line and fan triangulates them.
+   The triangles are written to indices + *f_index or pushed to arena if indices is 0.
+   Returns 0 if the arena ran out of memory.
+*/
+RGF_API RGF_INLINE int rgf_obj_parse_face(
+    unsigned char *obj_binary,
+    unsigned long *i,           /* Position after "f ", moved to the end of the line */
+    unsigned long end,          /* End of the buffer                                 */
+    unsigned long vertex_count, /* Vertices defined before this face                 */
+    int *indices,
+    unsigned long *f_index,
+    rgf_arena *arena)
+{
+  int consumed = 0;
+  int current_index;
+  int first_index = 0;
+  int previous_index = 0;
+  unsigned long face_vertices_count = 0;
+  unsigned long p = *i;
+
+  /* Parse all vertex indices on the line */
+  while (p < end && obj_binary[p] != '\n')
+  {
+    if (rgf_is_space((char)obj_binary[p]))
+    {
+      p++;
+      continue;
+    }
+
+    if (rgf_obj_is_number_start(obj_binary[p]))
+    {
+      current_index = rgf_atoi_n((char *)(obj_binary + p), end - p, &consumed);
+      p += (unsigned long)consumed;
+
+      /* Handle negative indices (relative to the vertices defined so far) */
+      if (current_index < 0)
+      {
+        current_index = (int)vertex_count + current_index;
+      }
+      else
+      {
+        current_index = current_index - 1; /* Convert to 0-based */
+      }
+
+      /* Triangulate the face using a fan method */
+      if (face_vertices_count == 0)
+      {
+        first_index = current_index;
+      }
+      else if (face_vertices_count >= 2)
+      {
+        int *triangle = indices ? indices + *f_index : (int *)rgf_arena_push(arena, 3 * (unsigned long)sizeof(int));
+
+        if (!triangle)
+        {
+          return 0;
+        }
+
+        triangle[0] = first_index;
+        triangle[1] = previous_index;
+        triangle[2] = current_index;
+        *f_index += 3;
+      }
+
+      previous_index = current_index;
+      face_vertices_count++;
+    }
+
+    /* Skip any texture/normal indices and the rest of the token */
+    while (p < end && !rgf_is_space((char)obj_binary[p]))
+    {
+      p++;
+    }
+  }
+
+  *i = p;
+
+  return 1;
+}
+
+/* Parses all lines of a chunk into the model arrays at the chunk offsets */
+RGF_API RGF_INLINE void rgf_parse_obj_chunk(rgf_model *model, unsigned char *obj_binary, rgf_obj_chunk *chunk)
+{
+  unsigned long i = chunk->begin;
+  unsigned long end = chunk->end;
+  unsigned long v_index = chunk->vertex_offset;
+  unsigned long uv_index = chunk->uv_offset;
+  unsigned long f_index = chunk->index_offset;
+  int line_type;
+  int k;
+
+  for (k = 0; k < 3; ++k)
+  {
+    chunk->min[k] = 1e30f;
+    chunk->max[k] = -1e30f;
+  }
+
+  rgf_obj_submesh_init(chunk);
+
+  while (i < end)
+  {
+    /* A last line of one character holds no data, the buffer needs no terminator */
+    if (i + 1 >= end)
+    {
+      break;
+    }
+
+    /* -------- Vertex -------- */
+    if (obj_binary[i] == 'v' && obj_binary[i + 1] == ' ')
+    {
+      i = rgf_obj_parse_floats(obj_binary, i + 2, end, &model->vertices[v_index], 3);
+      v_index += 3;
+    }
+    /* -------- Texture Coordinate -------- */
+    else if (model->uvs && obj_binary[i] == 'v' && obj_binary[i + 1] == 't')
+    {
+      i = rgf_obj_parse_floats(obj_binary, i + 2, end, &model->uvs[uv_index], 2);
+      uv_index += 2;
+    }
+    /* -------- Faces -------- */
+    else if (model->indices && obj_binary[i] == 'f' && obj_binary[i + 1] == ' ')
+    {
+      unsigned long face_begin = f_index;
+
+      i += 2;
+      rgf_obj_parse_face(obj_binary, &i, end, v_index / 3, model->indices, &f_index, 0);
+
+      if (model->submeshes)
+      {
+        rgf_obj_submesh_face(model->submeshes, chunk, face_begin, f_index);
+      }
+    }
+    /* -------- Submesh boundaries -------- */
+    else if ((line_type = rgf_obj_submesh_line(obj_binary, end, i)) != 0)
+    {
+      rgf_obj_submesh_line_parse(chunk, obj_binary, i, end, line_type);
+    }
+
+    while (i < end && obj_binary[i] != '\n')
+    {
+      i++;
+    }
+    i++;
+  }
+
+  /* The vertices of the chunk are reduced at once instead of per line */
+  rgf_bounds_reduce(chunk->min, chunk->max, model->vertices + chunk->vertex_offset, v_index - chunk->vertex_offset);
+}
+
+RGF_API RGF_INLINE void rgf_parse_obj_bounds(rgf_model *model, float *min, float *max)
+{
+  /* The parsed arrays replace the ones a transform and the adjacency were for */
+  model->flags &= ~RGF_MODEL_FLAGS_RUNTIME;
+
+  model->min_x = min[0];
+  model->min_y = min[1];
+  model->min_z = min[2];
+  model->max_x = max[0];
+  model->max_y = max[1];
+  model->max_z = max[2];
+
+  model->center_x = (model->min_x + model->max_x) * 0.5f;
+  model->center_y = (model->min_y + model->max_y) * 0.5f;
+  model->center_z = (model->min_z + model->max_z) * 0.5f;
+
+  /* Store the original center position */
+  model->original_center_x = model->center_x;
+  model->original_center_y = model->center_y;
+  model->original_center_z = model->center_z;
+
+  /* Calculate the initial dimensions and set scale */
+  model->original_max_dim = model->max_x - model->min_x;
+
+  if (model->max_y - model->min_y > model->original_max_dim)
+  {
+    model->original_max_dim = model->max_y - model->min_y;
+  }
+
+  if (model->max_z - model->min_z > model->original_max_dim)
+  {
+    model->original_max_dim = model->max_z - model->min_z;
+  }
+
+  model->current_scale = 1.0f;
+}
+
+/* Parses the OBJ buffer into the caller supplied model arrays (sizes see rgf_obj_measure).
+   The optional model->submeshes receive the index range of every run of faces split by
+   "o", "g" and "usemtl" lines.
+*/
+RGF_API RGF_INLINE int rgf_parse_obj(
+    rgf_model *model,             /* The filled by supplied obj file data model      */
+    unsigned char *obj_binary,    /* OBJ File binary buffer                          */
+    unsigned long obj_binary_size /* OBJ File binary buffer size                     */
+)
+{
+  rgf_obj_measurement measurement;
+  rgf_obj_chunk chunk;
+
+  /* Check input arguments */
+  if (!model || !obj_binary || obj_binary_size <= 0)
+  {
+    return 0;
+  }
+
+  /* First pass: count vertices & triangles */
+  rgf_obj_measure(&measurement, obj_binary, obj_binary_size);
+
+  chunk.begin = 0;
+  chunk.end = obj_binary_size;
+  chunk.counts = measurement.counts;
+  chunk.vertex_offset = 0;
+  chunk.uv_offset = 0;
+  chunk.index_offset = 0;
+  chunk.submesh_offset = 0;
+
+  /* Allocate arrays */
+  model->vertices_size = measurement.vertices_size;
+  model->indices_size = measurement.indices_size;
+  model->index_width = 4;
+  model->uvs_size = measurement.uvs_size;
+
+  if (!model->vertices)
+  {
+    return 0;
+  }
+
+  /* Positions only, "vn" lines are not indexed by vertex (see rgf_parse_obj_welded) */
+  model->flags &= ~RGF_MODEL_FLAG_NORMALS_PROVIDED;
+
+  /* Second pass: parse data */
+  rgf_parse_obj_chunk(model, obj_binary, &chunk);
+  rgf_parse_obj_bounds(model, chunk.min, chunk.max);
+
+  model->submeshes_size = model->submeshes && model->indices ? rgf_obj_submeshes_join(model->submeshes, &chunk, 1) : 0;
+
+  return 1;
+}
+
+/* Parses the OBJ buffer in a single pass (no counting pass) into growable arenas.
+
+   Every arena receives the raw array data (float vertices, float uvs, int indices,
+   rgf_submesh), uvs, indices and submeshes can be 0 to skip them. The arrays are the
+   ones of rgf_parse_obj: submeshes need indices, "vn" lines are skipped. The model
+   sizes are set to the exact final number of elements. If an arena is stored in one
+   block the matching model array points into it, otherwise the array is 0 and the data
+   has to be gathered with rgf_arena_copy.
+
+   Returns 0 instead of overflowing when an arena can not grow anymore.
+*/
+RGF_API RGF_INLINE int rgf_parse_obj_arena(
+    rgf_model *model,              /* The filled by supplied obj file data model      */
+    unsigned char *obj_binary,     /* OBJ File binary buffer                          */
+    unsigned long obj_binary_size, /* OBJ File binary buffer size                     */
+    rgf_arena *vertices,           /* Receives the vertex positions                   */
+    rgf_arena *uvs,                /* Receives the texture coordinates (optional)     */
+    rgf_arena *indices,            /* Receives the triangle indices (optional)        */
+    rgf_arena *submeshes           /* Receives the submesh ranges (optional)          */
+)
+{
+  unsigned long i = 0;
+  unsigned long vertex_count = 0;
+  unsigned long f_index = 0;
+  float min[3] = {1e30f, 1e30f, 1e30f};
+  float max[3] = {-1e30f, -1e30f, -1e30f};
+  rgf_arena_block *block;
+  rgf_obj_chunk chunk;
+  rgf_submesh *submesh = 0;
+  int line_type;
+
+  /* Check input arguments */
+  if (!model || !obj_binary || obj_binary_size <= 0 || !vertices)
+  {
+    return 0;
+  }
+
+  rgf_obj_submesh_init(&chunk);
+
+  while (i < obj_binary_size)
+  {
+    /* A last line of one character holds no data, the buffer needs no terminator */
+    if (i + 1 >= obj_binary_size)
+    {
+      break;
+    }
+
+    /* -------- Vertex -------- */
+    if (obj_binary[i] == 'v' && obj_binary[i + 1] == ' ')
+    {
+      float *v = (float *)rgf_arena_push(vertices, 3 * (unsigned long)sizeof(float));
+
+      if (!v)
+      {
+        return 0;
+      }
+
+      i = rgf_obj_parse_floats(obj_binary, i + 2, obj_binary_size, v, 3);
+      vertex_count++;
+    }
+    /* -------- Texture Coordinate -------- */
+    else if (uvs && obj_binary[i] == 'v' && obj_binary[i + 1] == 't')
+    {
+      float *uv = (float *)rgf_arena_push(uvs, 2 * (unsigned long)sizeof(float));
+
+      if (!uv)
+      {
+        return 0;
+      }
+
+      i = rgf_obj_parse_floats(obj_binary, i + 2, obj_binary_size, uv, 2);
+    }
+    /* -------- Faces -------- */
+    else if (indices && obj_binary[i] == 'f' && obj_binary[i + 1] == ' ')
+    {
+      unsigned long face_begin = f_index;
+
+      i += 2;
+
+      if (!rgf_obj_parse_face(obj_binary, &i, obj_binary_size, vertex_count, 0, &f_index, indices))
+      {
+        return 0;
+      }
+
+      /* Same ranges as rgf_obj_submesh_face, a pushed entry never moves */
+      if (submeshes && chunk.submesh_pending)
+      {
+        submesh = (rgf_submesh *)rgf_arena_push(submeshes, (unsigned long)sizeof(rgf_submesh));
+
+        if (!submesh)
+        {
+          return 0;
+        }
+
+        submesh->index_offset = (unsigned int)face_begin;
+        submesh->material_hash = (unsigned int)chunk.material_hash;
+        chunk.submesh_pending = 0;
+      }
+
+      if (submesh)
+      {
+        submesh->index_count = (unsigned int)(f_index - submesh->index_offset);
+      }
+    }
+    /* -------- Submesh boundaries -------- */
+    else if ((line_type = rgf_obj_submesh_line(obj_binary, obj_binary_size, i)) != 0)
+    {
+      rgf_obj_submesh_line_parse(&chunk, obj_binary, i, obj_binary_size, line_type);
+    }
+
+    while (i < obj_binary_size && obj_binary[i] != '\n')
+    {
+      i++;
+    }
+    i++;
+  }
+
+  model->vertices_size = vertices->size / (unsigned long)sizeof(float);
+  model->uvs_size = uvs ? uvs->size / (unsigned long)sizeof(float) : 0;
+  model->indices_size = indices ? indices->size / (unsigned long)sizeof(int) : 0;
+  model->index_width = 4;
+
+  model->vertices = (float *)rgf_arena_data(vertices);
+  model->uvs = uvs ? (float *)rgf_arena_data(uvs) : 0;
+  model->indices = indices ? (int *)rgf_arena_data(indices) : 0;
+  model->submeshes_size = submeshes && indices ? submeshes->size / (unsigned long)sizeof(rgf_submesh) : 0;
+  model->submeshes = model->submeshes_size > 0 ? (rgf_submesh *)rgf_arena_data(submeshes) : 0;
+  model->flags &= ~RGF_MODEL_FLAG_NORMALS_PROVIDED;
+
+  /* Every block holds whole vertices */
+  for (block = vertices->first; block; block = block->next)
+  {
+    rgf_bounds_reduce(min, max, (float *)(void *)rgf_arena_block_data(block), block->size / (unsigned long)sizeof(float));
+  }
+
+  rgf_parse_obj_bounds(model, min, max);
+
+  return 1;
+}
+
+/* Resolves a 1-based or negative (relative) OBJ index against the defined element count.
+   Returns -1 if the index does not reference a defined element.
+*/
+RGF_API RGF_INLINE int rgf_obj_resolve_index(int index, unsigned long defined)
+{
+  long resolved = index < 0 ? (long)defined + index : (long)index - 1;
+
+  return (resolved >= 0 && resolved < (long)defined) ? (int)resolved : -1;
+}
+
+/* Parses a "v", "v/vt", "v//vn" or "v/vt/vn" face token into 0-based indices, missing parts are -1.
+   Returns 0 if the token has no position or references an undefined element.
+*/
+RGF_API RGF_INLINE int rgf_obj_parse_corner(
+    unsigned char *obj_binary,
+    unsigned long *i,       /* Position of the token, moved past it       */
+    unsigned long end,      /* End of the buffer                          */
+    unsigned long *defined, /* Number of "v", "vt" and "vn" defined so far */
+    int *corner             /* Receives the v, vt and vn index            */
+)
+{
+  unsigned long p = *i;
+  int consumed = 0;
+  int k;
+
+  corner[0] = corner[1] = corner[2] = -1;
+
+  for (k = 0; k < 3; ++k)
+  {
+    if (k > 0)
+    {
+      if (p >= end || obj_binary[p] != '/')
+      {
+        break;
+      }
+
+      p++;
+    }
+
+    if (p < end && rgf_obj_is_number_start(obj_binary[p]))
+    {
+      corner[k] = rgf_obj_resolve_index(rgf_atoi_n((char *)(obj_binary + p), end - p, &consumed), defined[k]);
+      p += (unsigned long)consumed;
+
+      if (corner[k] < 0)
+      {
+        return 0;
+      }
+    }
+    else if (k == 0)
+    {
+      return 0;
+    }
+  }
+
+  while (p < end && !rgf_is_space((char)obj_binary[p]))
+  {
+    p++;
+  }
+
+  *i = p;
+
+  return 1;
+}
+
+RGF_API RGF_INLINE unsigned long rgf_obj_weld_hash(int *corner)
+{
+  unsigned long h = ((unsigned long)(unsigned int)corner[0] * 0x9E3779B1UL) ^
+                    ((unsigned long)(unsigned int)corner[1] * 0x85EBCA77UL) ^
+                    ((unsigned long)(unsigned int)corner[2] * 0xC2B2AE3DUL);
+
+  h &= 0xFFFFFFFFUL;
+
+  return h ^ (h >> 16);
+}
+
+/* Parses the OBJ buffer into GPU ready arrays: every unique (v, vt, vn) combination used by
+   a face becomes one output vertex and the indices reference these welded vertices, so
+   model->vertices, model->uvs and model->normals share the same index.
+
+   The "v", "vt" and "vn" lines are parsed into the scratch memory, face corners are looked
+   up in an open addressing hash table (linear probing) and a new vertex is emitted the
+   first time a combination is seen. Corners without a uv or normal get zeros.
+
+   The "vn" normals are written to model->normals if it is set. If every welded vertex has
+   a normal RGF_MODEL_FLAG_NORMALS_PROVIDED is set in model->flags and the loader can skip
+   rgf_model_calculate_normals, which also keeps the authored hard edges.
+
+   Set model->vertices and model->indices, model->uvs, model->normals and model->submeshes
+   are optional. Every vertex array has to hold measurement->weld_vertex_capacity vertices,
+   model->indices measurement->indices_size ints and model->submeshes
+   measurement->submeshes_size entries. Returns 0 if a face references an undefined element.
+*/
+RGF_API RGF_INLINE int rgf_parse_obj_welded(
+    rgf_model *model,                 /* The filled by supplied obj file data model           */
+    unsigned char *obj_binary,        /* OBJ File binary buffer                               */
+    unsigned long obj_binary_size,    /* OBJ File binary buffer size                          */
+    rgf_obj_measurement *measurement, /* rgf_obj_measure result of the buffer                 */
+    void *scratch                     /* measurement->weld_scratch_bytes, 4 byte aligned      */
+)
+{
+  rgf_obj_weld_slot *table = (rgf_obj_weld_slot *)scratch;
+  float *positions = (float *)(table + measurement->weld_table_size);
+  float *texcoords = positions + measurement->vertices_size;
+  float *normals = texcoords + measurement->uvs_size;
+  unsigned long mask = measurement->weld_table_size - 1;
+  unsigned long defined[3] = {0, 0, 0};
+  unsigned long vertex_count = 0;
+  unsigned long f_index = 0;
+  unsigned long i = 0;
+  float min[3] = {1e30f, 1e30f, 1e30f};
+  float max[3] = {-1e30f, -1e30f, -1e30f};
+  int write_uvs;
+  int write_normals;
+  int normals_missing = 0;
+  int line_type;
+  rgf_obj_chunk submesh_state;
+
+  /* Check input arguments */
+  if (!model || !obj_binary || obj_binary_size <= 0 || !measurement || !scratch || !model->vertices || !model->indices)
+  {
+    return 0;
+  }
+
+  write_uvs = model->uvs && measurement->counts.uv_count > 0;
+  write_normals = model->normals && measurement->counts.normal_count > 0;
+
+  for (i = 0; i < measurement->weld_table_size; ++i)
+  {
+    table[i].index = -1;
+  }
+
+  submesh_state.submesh_offset = 0;
+  rgf_obj_submesh_init(&submesh_state);
+
+  i = 0;
+
+  while (i < obj_binary_size)
+  {
+    /* A last line of one character holds no data, the buffer needs no terminator */
+    if (i + 1 >= obj_binary_size)
+    {
+      break;
+    }
+
+    /* -------- Vertex -------- */
+    if (obj_binary[i] == 'v' && obj_binary[i + 1] == ' ')
+    {
+      i = rgf_obj_parse_floats(obj_binary, i + 2, obj_binary_size, &positions[defined[0] * 3], 3);
+      defined[0]++;
+    }
+    /* -------- Texture Coordinate -------- */
+    else if (obj_binary[i] == 'v' && obj_binary[i + 1] == 't')
+    {
+      i = rgf_obj_parse_floats(obj_binary, i + 2, obj_binary_size, &texcoords[defined[1] * 2], 2);
+      defined[1]++;
+    }
+    /* -------- Normal -------- */
+    else if (obj_binary[i] == 'v' && obj_binary[i + 1] == 'n')
+    {
+      i = rgf_obj_parse_floats(obj_binary, i + 2, obj_binary_size, &normals[defined[2] * 3], 3);
+      defined[2]++;
+    }
+    /* -------- Faces -------- */
+    else if (obj_binary[i] == 'f' && obj_binary[i + 1] == ' ')
+    {
+      int first_index = 0;
+      int previous_index = 0;
+      unsigned long face_vertices_count = 0;
+      unsigned long face_begin = f_index;
+
+      i += 2;
+
+      while (i < obj_binary_size && obj_binary[i] != '\n')
+      {
+        int corner[3];
+        int current_index;
+        unsigned long slot;
+
+        if (rgf_is_space((char)obj_binary[i]))
+        {
+          i++;
+          continue;
+        }
+
+        /* Tokens without a vertex number are skipped, rgf_obj_count does not count them */
+        if (!rgf_obj_is_number_start(obj_binary[i]))
+        {
+          while (i < obj_binary_size && !rgf_is_space((char)obj_binary[i]))
+          {
+            i++;
+          }
+
+          continue;
+        }
+
+        if (!rgf_obj_parse_corner(obj_binary, &i, obj_binary_size, defined, corner))
+        {
+          return 0;
+        }
+
+        /* Find the welded vertex of this corner or emit a new one */
+        slot = rgf_obj_weld_hash(corner) & mask;
+
+        while (table[slot].index >= 0 &&
+               (table[slot].v != corner[0] || table[slot].vt != corner[1] || table[slot].vn != corner[2]))
+        {
+          slot = (slot + 1) & mask;
+        }
+
+        if (table[slot].index < 0)
+        {
+          float *p = &positions[(unsigned long)corner[0] * 3];
+          float *out = &model->vertices[vertex_count * 3];
+
+          out[0] = p[0];
+          out[1] = p[1];
+          out[2] = p[2];
+
+          if (write_uvs)
+          {
+            out = &model->uvs[vertex_count * 2];
+            out[0] = corner[1] < 0 ? 0.0f : texcoords[(unsigned long)corner[1] * 2];
+            out[1] = corner[1] < 0 ? 0.0f : texcoords[(unsigned long)corner[1] * 2 + 1];
+          }
+
+          if (write_normals)
+          {
+            out = &model->normals[vertex_count * 3];
+            out[0] = corner[2] < 0 ? 0.0f : normals[(unsigned long)corner[2] * 3];
+            out[1] = corner[2] < 0 ? 0.0f : normals[(unsigned long)corner[2] * 3 + 1];
+            out[2] = corner[2] < 0 ? 0.0f : normals[(unsigned long)corner[2] * 3 + 2];
+          }
+
+          normals_missing |= corner[2] < 0;
+
+          table[slot].v = corner[0];
+          table[slot].vt = corner[1];
+          table[slot].vn = corner[2];
+          table[slot].index = (int)vertex_count++;
+        }
+
+        current_index = table[slot].index;
+
+        /* Triangulate the face using a fan method */
+        if (face_vertices_count == 0)
+        {
+          first_index = current_index;
+        }
+        else if (face_vertices_count >= 2)
+        {
+          model->indices[f_index + 0] = first_index;
+          model->indices[f_index + 1] = previous_index;
+          model->indices[f_index + 2] = current_index;
+          f_index += 3;
+        }
+
+        previous_index = current_index;
+        face_vertices_count++;
+      }
+
+      if (model->submeshes)
+      {
+        rgf_obj_submesh_face(model->submeshes, &submesh_state, face_begin, f_index);
+      }
+    }
+    /* -------- Submesh boundaries -------- */
+    else if ((line_type = rgf_obj_submesh_line(obj_binary, obj_binary_size, i)) != 0)
+    {
+      rgf_obj_submesh_line_parse(&submesh_state, obj_binary, i, obj_binary_size, line_type);
+    }
+
+    while (i < obj_binary_size && obj_binary[i] != '\n')
+    {
+      i++;
+    }
+    i++;
+  }
+
+  model->vertices_size = vertex_count * 3;
+  model->uvs_size = write_uvs ? vertex_count * 2 : 0;
+  model->normals_size = write_normals ? vertex_count * 3 : 0;
+  model->indices_size = f_index;
+  model->index_width = 4;
+  model->submeshes_size = model->submeshes ? rgf_obj_submeshes_join(model->submeshes, &submesh_state, 1) : 0;
+
+  /* Only complete normals make the recompute unnecessary */
+  if (write_normals && !normals_missing)
+  {
+    model->flags |= RGF_MODEL_FLAG_NORMALS_PROVIDED;
+  }
+  else
+  {
+    model->flags &= ~RGF_MODEL_FLAG_NORMALS_PROVIDED;
+  }
+
+  /* The bounds of all defined positions, referenced or not */
+  rgf_bounds_reduce(min, max, positions, defined[0] * 3);
+  rgf_parse_obj_bounds(model, min, max);
+
+  return 1;
+}
+
+#ifndef RGF_OBJ_CHUNKS_PER_THREAD
+#define RGF_OBJ_CHUNKS_PER_THREAD 4
+#endif
+
+#ifndef RGF_OBJ_MIN_CHUNK_SIZE
+#define RGF_OBJ_MIN_CHUNK_SIZE (64UL * 1024UL)
+#endif
+
+typedef struct rgf_obj_parallel
+{
+  rgf_model *model;
+  unsigned char *obj_binary;
+  rgf_obj_chunk *chunks;
+
+} rgf_obj_parallel;
+
+RGF_API void rgf_obj_count_job(void *job_data, unsigned long job_index)
+{
+  rgf_obj_parallel *parallel = (rgf_obj_parallel *)job_data;
+  rgf_obj_chunk *chunk = &parallel->chunks[job_index];
+
+  rgf_obj_count(&chunk->counts, parallel->obj_binary + chunk->begin, chunk->end - chunk->begin);
+}
+
+RGF_API void rgf_obj_parse_job(void *job_data, unsigned long job_index)
+{
+  rgf_obj_parallel *parallel = (rgf_obj_parallel *)job_data;
+
+  rgf_parse_obj_chunk(parallel->model, parallel->obj_binary, &parallel->chunks[job_index]);
+}
+
+/* Same result as rgf_parse_obj (bit identical) but the buffer is split on line boundaries
+   into chunks that are counted and parsed in parallel through the job system. The chunk
+   counts are turned into array offsets by a prefix sum so every chunk writes straight
+   into the final model arrays.
+
+   Every chunk begins a submesh with its first face, the ones that only continue the
+   previous chunk are merged afterwards. So model->submeshes needs room for the measured
+   parallel_submeshes_size entries (submeshes_size plus RGF_OBJ_MAX_CHUNKS).
+*/
+RGF_API RGF_INLINE int rgf_parse_obj_parallel(
+    rgf_model *model,              /* The filled by supplied obj file data model      */
+    unsigned char *obj_binary,     /* OBJ File binary buffer                          */
+    unsigned long obj_binary_size, /* OBJ File binary buffer size                     */
+    rgf_job_system *jobs           /* Job dispatcher, 0 runs the chunks serially      */
+)
+{
+  rgf_obj_chunk chunks[RGF_OBJ_MAX_CHUNKS];
+  rgf_obj_parallel parallel;
+  unsigned long chunk_count;
+  unsigned long chunk_size;
+  unsigned long vertex_offset = 0;
+  unsigned long uv_offset = 0;
+  unsigned long index_offset = 0;
+  unsigned long submesh_offset = 0;
+  unsigned long i;
+  float min[3];
+  float max[3];
+  int k;
+
+  /* Check input arguments */
+  if (!model || !obj_binary || obj_binary_size <= 0)
+  {
+    return 0;
+  }
+
+  chunk_count = rgf_job_thread_count(jobs) * RGF_OBJ_CHUNKS_PER_THREAD;
+
+  if (chunk_count > obj_binary_size / RGF_OBJ_MIN_CHUNK_SIZE)
+  {
+    chunk_count = obj_binary_size / RGF_OBJ_MIN_CHUNK_SIZE;
+  }
+
+  if (chunk_count > RGF_OBJ_MAX_CHUNKS)
+  {
+    chunk_count = RGF_OBJ_MAX_CHUNKS;
+  }
+
+  if (chunk_count < 1)
+  {
+    chunk_count = 1;
+  }
+
+  /* Split the buffer so that every chunk ends after a newline */
+  chunk_size = obj_binary_size / chunk_count;
+
+  for (i = 0; i < chunk_count; ++i)
+  {
+    unsigned long begin = i == 0 ? 0 : chunks[i - 1].end;
+    unsigned long end = i + 1 == chunk_count ? obj_binary_size : chunk_size * (i + 1);
+
+    if (end < begin)
+    {
+      end = begin;
+    }
+
+    while (end > begin && end < obj_binary_size && obj_binary[end - 1] != '\n')
+    {
+      end++;
+    }
+
+    chunks[i].begin = begin;
+    chunks[i].end = end;
+  }
+
+  parallel.model = model;
+  parallel.obj_binary = obj_binary;
+  parallel.chunks = chunks;
+
+  /* First pass: count vertices & triangles per chunk */
+  rgf_job_run(jobs, rgf_obj_count_job, &parallel, chunk_count);
+
+  /* Prefix sum of the chunk counts */
+  for (i = 0; i < chunk_count; ++i)
+  {
+    chunks[i].vertex_offset = vertex_offset;
+    chunks[i].uv_offset = uv_offset;
+    chunks[i].index_offset = index_offset;
+    chunks[i].submesh_offset = submesh_offset;
+
+    vertex_offset += chunks[i].counts.vertex_count * 3;
+    uv_offset += chunks[i].counts.uv_count * 2;
+    index_offset += chunks[i].counts.triangle_count * 3;
+    submesh_offset += chunks[i].counts.submesh_count;
+  }
+
+  /* Allocate arrays */
+  model->vertices_size = vertex_offset;
+  model->indices_size = index_offset;
+  model->index_width = 4;
+  model->uvs_size = uv_offset;
+
+  if (!model->vertices)
+  {
+    return 0;
+  }
+
+  model->flags &= ~RGF_MODEL_FLAG_NORMALS_PROVIDED;
+
+  /* Second pass: parse data of all chunks */
+  rgf_job_run(jobs, rgf_obj_parse_job, &parallel, chunk_count);
+
+  /* Reduce the chunk bounds */
+  for (k = 0; k < 3; ++k)
+  {
+    min[k] = 1e30f;
+    max[k] = -1e30f;
+
+    for (i = 0; i < chunk_count; ++i)
+    {
+      if (chunks[i].min[k] < min[k])
+      {
+        min[k] = chunks[i].min[k];
+      }
+
+      if (chunks[i].max[k] > max[k])
+      {
+        max[k] = chunks[i].max[k];
+      }
+    }
+  }
+
+  rgf_parse_obj_bounds(model, min, max);
+
+  model->submeshes_size = model->submeshes && model->indices ? rgf_obj_submeshes_join(model->submeshes, chunks, chunk_count) : 0;
+
+  return 1;
+}
+
+/* ########################################################## */
+/* # Geometry manipulation functions                          */
+/* ########################################################## */
+/* Index i of an array of width bytes per index (4 or 0 = int) */
+RGF_API RGF_INLINE unsigned long rgf_index_get(void *indices, unsigned long width, unsigned long i)
+{
+  switch (width)
+  {
+  case 1:
+    return ((unsigned char *)indices)[i];
+  case 2:
+    return ((unsigned short *)indices)[i];
+  default:
+    return (unsigned long)((int *)indices)[i];
+  }
+}
+
+/* Narrowest index width (1, 2 or 4 bytes) that holds max_index */
+RGF_API RGF_INLINE unsigned long rgf_index_width_for(unsigned long max_index)
+{
+  return max_index <= 0xFFUL ? 1 : (max_index <= 0xFFFFUL ? 2 : 4);
+}
+
+/* Copies count indices between widths, returns 0 if an index is negative or does not fit
+   into out_width. Narrowing (out_width <= in_width) works in place with out == in.
+*/
+RGF_API RGF_INLINE int rgf_index_convert(void *out, unsigned long out_width, void *in, unsigned long in_width, unsigned long count)
+{
+  unsigned long max_index = out_width == 1 ? 0xFFUL : (out_width == 2 ? 0xFFFFUL : 0x7FFFFFFFUL);
+  unsigned long i;
+
+  for (i = 0; i < count; ++i)
+  {
+    unsigned long index = rgf_index_get(in, in_width, i);
+
+    if (index > max_index)
+    {
+      return 0;
+    }
+
+    switch (out_width)
+    {
+    case 1:
+      ((unsigned char *)out)[i] = (unsigned char)index;
+      break;
+    case 2:
+      ((unsigned short *)out)[i] = (unsigned short)index;
+      break;
+    default:
+      ((int *)out)[i] = (int)index;
+      break;
+    }
+  }
+
+  return 1;
+}
+
+RGF_API RGF_INLINE unsigned long rgf_model_index_width(rgf_model *model)
+{
+  return model->index_width == 0 ? 4 : model->index_width;
+}
+
+/* Index i of the model at any index width */
+RGF_API RGF_INLINE unsigned long rgf_model_index(rgf_model *model, unsigned long i)
+{
+  return rgf_index_get(model->indices, model->index_width, i);
+}
+
+/* Largest index of the model, negative indices are above 0x7FFFFFFF (see rgf_index_get) */
+RGF_API RGF_INLINE unsigned long rgf_model_index_max(rgf_model *model)
+{
+  unsigned long max_index = 0;
+  unsigned long i;
+
+  for (i = 0; i < model->indices_size; ++i)
+  {
+    unsigned long index = rgf_model_index(model, i);
+
+    if (index > max_index)
+    {
+      max_index = index;
+    }
+  }
+
+  return max_index;
+}
+
+/* Stores the indices in place with the narrowest width (1 or 2 bytes for models with
+   up to 256 or 65536 vertices), the index memory shrinks to a half or a quarter.
+   Returns 0 for negative indices.
+*/
+RGF_API RGF_INLINE int rgf_model_narrow_indices(rgf_model *model)
+{
+  unsigned long max_index = rgf_model_index_max(model);
+  unsigned long width = rgf_index_width_for(max_index);
+
+  if (max_index > 0x7FFFFFFFUL)
+  {
+    /* negative index */
+    return 0;
+  }
+
+  if (width < rgf_model_index_width(model))
+  {
+    rgf_index_convert(model->indices, width, model->indices, rgf_model_index_width(model), model->indices_size);
+    model->index_width = width;
+  }
+
+  return 1;
+}
+
+/* Transforms count / 3 xyz interleaved vectors in place by a row major 3x4 matrix:
+   x' = m[0] x + m[1] y + m[2] z + m[3] and so on. Directions are normalized after the
+   transform (pass a matrix without translation). 4 vectors per SIMD step are split into
+   x, y and z registers, transformed and interleaved again.
+*/
+RGF_API RGF_INLINE void rgf_transform_vectors(float *v, unsigned long count, float *m, int normalize)
+{
+  unsigned long i = 0;
+
+#if defined(RGF_SIMD_SSE2)
+  __m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]), m03 = _mm_set1_ps(m[3]);
+  __m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]), m13 = _mm_set1_ps(m[7]);
+  __m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]), m23 = _mm_set1_ps(m[11]);
+  __m128 zero = _mm_setzero_ps();
+  __m128 one = _mm_set1_ps(1.0f);
+
+  for (; i + 12 <= count; i += 12)
+  {
+    __m128 a = _mm_loadu_ps(v + i);     /* x0 y0 z0 x1 */
+    __m128 b = _mm_loadu_ps(v + i + 4); /* y1 z1 x2 y2 */
+    __m128 c = _mm_loadu_ps(v + i + 8); /* z2 x3 y3 z3 */
+    __m128 x = RGF_SHUFFLE(RGF_SHUFFLE(a, b, 0, 3, 2, 2), RGF_SHUFFLE(b, c, 2, 2, 1, 1), 0, 1, 0, 2);
+    __m128 y = RGF_SHUFFLE(RGF_SHUFFLE(a, b, 1, 1, 0, 0), RGF_SHUFFLE(b, c, 3, 3, 2, 2), 0, 2, 0, 2);
+    __m128 z = RGF_SHUFFLE(RGF_SHUFFLE(a, b, 2, 2, 1, 1), RGF_SHUFFLE(c, c, 0, 0, 3, 3), 0, 2, 0, 2);
+    __m128 tx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_mul_ps(m02, z)), m03);
+    __m128 ty = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m12, z)), m13);
+    __m128 tz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_mul_ps(m22, z)), m23);
+
+    if (normalize)
+    {
+      __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz)));
+      __m128 inv_length = _mm_and_ps(_mm_cmpgt_ps(length, zero), _mm_div_ps(one, length));
+
+      tx = _mm_mul_ps(tx, inv_length);
+      ty = _mm_mul_ps(ty, inv_length);
+      tz = _mm_mul_ps(tz, inv_length);
+    }
+
+    _mm_storeu_ps(v + i, RGF_SHUFFLE(RGF_SHUFFLE(tx, ty, 0, 0, 0, 0), RGF_SHUFFLE(tz, tx, 0, 0, 1, 1), 0, 2, 0, 2));
+    _mm_storeu_ps(v + i + 4, RGF_SHUFFLE(RGF_SHUFFLE(ty, tz, 1, 1, 1, 1), RGF_SHUFFLE(tx, ty, 2, 2, 2, 2), 0, 2, 0, 2));
+    _mm_storeu_ps(v + i + 8, RGF_SHUFFLE(RGF_SHUFFLE(tz, tx, 2, 2, 3, 3), RGF_SHUFFLE(ty, tz, 3, 3, 3, 3), 0, 2, 0, 2));
+  }
+#elif defined(RGF_SIMD_NEON)
+  float32x4_t zero = vdupq_n_f32(0.0f);
+
+  for (; i + 12 <= count; i += 12)
+  {
+    float32x4x3_t p = vld3q_f32(v + i);
+    float32x4_t x = p.val[0];
+    float32x4_t y = p.val[1];
+    float32x4_t z = p.val[2];
+
+    p.val[0] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[0]), vmulq_n_f32(y, m[1])), vmulq_n_f32(z, m[2])), vdupq_n_f32(m[3]));
+    p.val[1] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[4]), vmulq_n_f32(y, m[5])), vmulq_n_f32(z, m[6])), vdupq_n_f32(m[7]));
+    p.val[2] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[8]), vmulq_n_f32(y, m[9])), vmulq_n_f32(z, m[10])), vdupq_n_f32(m[11]));
+
+    if (normalize)
+    {
+      float32x4_t length_squared = vaddq_f32(vaddq_f32(vmulq_f32(p.val[0], p.val[0]), vmulq_f32(p.val[1], p.val[1])), vmulq_f32(p.val[2], p.val[2]));
+      float32x4_t r = vrsqrteq_f32(length_squared);
+      uint32x4_t valid = vcgtq_f32(length_squared, zero);
+
+      /* Reciprocal square root estimate refined by two newton steps */
+      r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(length_squared, r), r));
+      r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(length_squared, r), r));
+      r = vbslq_f32(valid, r, zero);
+
+      p.val[0] = vmulq_f32(p.val[0], r);
+      p.val[1] = vmulq_f32(p.val[1], r);
+      p.val[2] = vmulq_f32(p.val[2], r);
+    }
+
+    vst3q_f32(v + i, p);
+  }
+#endif
+
+  for (; i + 3 <= count; i += 3)
+  {
+    float x = v[i];
+    float y = v[i + 1];
+    float z = v[i + 2];
+
+    v[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+    v[i + 1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+    v[i + 2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+
+    if (normalize)
+    {
+      rgf_v3_normalize(&v[i], &v[i]);
+    }
+  }
+}
+
+#if defined(RGF_SIMD_SSE2)
+#undef RGF_SHUFFLE
+#endif
+
+/* Transforms a bounding box from its corners: every row takes the corner that minimizes
+   (maximizes) it, in the operation order of rgf_transform_vectors. So the box contains
+   every transformed vertex of the box, exactly for scales and translations.
+*/
+RGF_API RGF_INLINE void rgf_transform_box(float *out_min, float *out_max, float *min, float *max, float *matrix)
+{
+  int r;
+  int c;
+
+  for (r = 0; r < 3; ++r)
+  {
+    float *row = matrix + r * 4;
+    float low = 0.0f;
+    float high = 0.0f;
+
+    for (c = 0; c < 3; ++c)
+    {
+      float a = row[c] * min[c];
+      float b = row[c] * max[c];
+
+      low = c == 0 ? (a < b ? a : b) : low + (a < b ? a : b);
+      high = c == 0 ? (a > b ? a : b) : high + (a > b ? a : b);
+    }
+
+    out_min[r] = low + row[3];
+    out_max[r] = high + row[3];
+  }
+}
+
+/* Applies a row major 3x4 matrix to the arrays in one pass per array: positions by the
+   matrix, normals by the inverse transpose of its 3x3 part, tangents and bitangents by
+   the 3x3 part, directions are normalized again. Directions keep their values when the
+   3x3 part is a uniform positive scale. The bounds are left as they are.
+*/
+RGF_API RGF_INLINE void rgf_model_transform_arrays(rgf_model *model, float *matrix)
+{
+  float linear[12];
+  float normal[12];
+  float det;
+  int r;
+  int c;
+
+  if (model->vertices)
+  {
+    rgf_transform_vectors(model->vertices, model->vertices_size, matrix, 0);
+  }
+
+  if (matrix[0] > 0.0f && matrix[0] == matrix[5] && matrix[0] == matrix[10] && matrix[1] == 0.0f && matrix[2] == 0.0f &&
+      matrix[4] == 0.0f && matrix[6] == 0.0f && matrix[8] == 0.0f && matrix[9] == 0.0f)
+  {
+    return;
+  }
+
+  for (r = 0; r < 3; ++r)
+  {
+    for (c = 0; c < 3; ++c)
+    {
+      linear[r * 4 + c] = matrix[r * 4 + c];
+    }
+
+    linear[r * 4 + 3] = 0.0f;
+    normal[r * 4 + 3] = 0.0f;
+  }
+
+  /* The cofactors are the inverse transpose times the determinant, the sign keeps the side */
+  normal[0] = matrix[5] * matrix[10] - matrix[6] * matrix[9];
+  normal[1] = matrix[6] * matrix[8] - matrix[4] * matrix[10];
+  normal[2] = matrix[4] * matrix[9] - matrix[5] * matrix[8];
+  normal[4] = matrix[2] * matrix[9] - matrix[1] * matrix[10];
+  normal[5] = matrix[0] * matrix[10] - matrix[2] * matrix[8];
+  normal[6] = matrix[1] * matrix[8] - matrix[0] * matrix[9];
+  normal[8] = matrix[1] * matrix[6] - matrix[2] * matrix[5];
+  normal[9] = matrix[2] * matrix[4] - matrix[0] * matrix[6];
+  normal[10] = matrix[0] * matrix[5] - matrix[1] * matrix[4];
+
+  det = matrix[0] * normal[0] + matrix[1] * normal[1] + matrix[2] * normal[2];
+
+  if (det < 0.0f)
+  {
+    for (r = 0; r < 12; ++r)
+    {
+      normal[r] = -normal[r];
+    }
+  }
+
+  if (model->normals)
+  {
+    rgf_transform_vectors(model->normals, model->normals_size, normal, 1);
+  }
+
+  if (model->tangents)
+  {
+    rgf_transform_vectors(model->tangents, model->tangents_size, linear, 1);
+  }
+
+  if (model->bitangents)
+  {
+    rgf_transform_vectors(model->bitangents, model->bitangents_size, linear, 1);
+  }
+}
+
+/* Applies the pending transform of the model to its arrays, one pass over every vertex
+   for any number of deferred transforms. The library calls it before it reads the
+   arrays (processing functions, encoders, C header export). Until then the vertices,
+   normals, tangents and bitangents still hold the values from before rgf_model_center,
+   rgf_model_scale, their resets or rgf_model_transform_deferred, so a caller that reads
+   the arrays directly (to draw or upload them) calls it first:
+
+     rgf_model_center(&model, 0.0f, 0.0f, 0.0f);
+     rgf_model_scale(&model, 1.0f);
+     rgf_model_apply_transform(&model);
+     upload(model.vertices, model.vertices_size);
+*/
+RGF_API RGF_INLINE void rgf_model_apply_transform(rgf_model *model)
+{
+  if (!(model->flags & RGF_MODEL_FLAG_TRANSFORM_PENDING))
+  {
+    return;
+  }
+
+  model->flags &= ~RGF_MODEL_FLAG_TRANSFORM_PENDING;
+
+  rgf_model_transform_arrays(model, model->transform);
+}
+
+/* Composes a row major 3x4 matrix after the pending transform of the model without
+   touching the arrays (see rgf_model_apply_transform). The bounding box is the box of
+   the arrays before the first pending transform transformed by the composition (see
+   rgf_transform_box), so it contains every vertex once the transform is applied. The
+   center is the one of the new box, the original center and size and the current
+   scale are left to the caller.
+*/
+RGF_API RGF_INLINE void rgf_model_transform_deferred(rgf_model *model, float *matrix)
+{
+  float composed[12];
+  float new_min[3];
+  float new_max[3];
+  int r;
+  int c;
+
+  if (!model->vertices)
+  {
+    return;
+  }
+
+  if (!(model->flags & RGF_MODEL_FLAG_TRANSFORM_PENDING))
+  {
+    model->transform_min[0] = model->min_x;
+    model->transform_min[1] = model->min_y;
+    model->transform_min[2] = model->min_z;
+    model->transform_max[0] = model->max_x;
+    model->transform_max[1] = model->max_y;
+    model->transform_max[2] = model->max_z;
+
+    for (r = 0; r < 12; ++r)
+    {
+      composed[r] = matrix[r];
+    }
+  }
+  else
+  {
+    /* matrix * transform, the translation column of the transform is a point */
+    for (r = 0; r < 3; ++r)
+    {
+      for (c = 0; c < 4; ++c)
+      {
+        composed[r * 4 + c] = matrix[r * 4] * model->transform[c] + matrix[r * 4 + 1] * model->transform[4 + c] + matrix[r * 4 + 2] * model->transform[8 + c];
+      }
+
+      composed[r * 4 + 3] += matrix[r * 4 + 3];
+    }
+  }
+
+  for (r = 0; r < 12; ++r)
+  {
+    model->transform[r] = composed[r];
+  }
+
+  model->flags |= RGF_MODEL_FLAG_TRANSFORM_PENDING;
+
+  rgf_transform_box(new_min, new_max, model->transform_min, model->transform_max, model->transform);
+
+  model->min_x = new_min[0];
+  model->min_y = new_min[1];
+  model->min_z = new_min[2];
+  model->max_x = new_max[0];
+  model->max_y = new_max[1];
+  model->max_z = new_max[2];
+
+  model->center_x = (model->min_x + model->max_x) / 2.0f;
+  model->center_y = (model->min_y + model->max_y) / 2.0f;
+  model->center_z = (model->min_z + model->max_z) / 2.0f;
+}
+
+/* Applies the affine transform of a row major 3x4 matrix (after any pending one) to the
+   model now, see rgf_model_transform_deferred and rgf_model_transform_arrays
+*/
+RGF_API RGF_INLINE void rgf_model_transform(rgf_model *model, float *matrix)
+{
+  rgf_model_transform_deferred(model, matrix);
+  rgf_model_apply_transform(model);
+}
+
+/* Recomputes the bounds from the vertices, large models are reduced through the job system */
+RGF_API RGF_INLINE void rgf_model_calculate_boundaries_parallel(rgf_model *model, rgf_job_system *jobs)
+{
+  float min[3];
+  float max[3];
+  float dim_x, dim_y, dim_z;
+
+  if (!model || !model->vertices || model->vertices_size == 0)
+  {
+    return;
+  }
+
+  rgf_model_apply_transform(model);
+
+  /* Initialize min/max with the coordinates of the first vertex. */
+  min[0] = max[0] = model->vertices[0];
+  min[1] = max[1] = model->vertices[1];
+  min[2] = max[2] = model->vertices[2];
+
+  rgf_bounds_reduce_parallel(min, max, model->vertices, model->vertices_size, jobs);
+
+  model->min_x = min[0];
+  model->min_y = min[1];
+  model->min_z = min[2];
+  model->max_x = max[0];
+  model->max_y = max[1];
+  model->max_z = max[2];
+
+  /* Calculate the center of the model. */
+  model->center_x = model->min_x + (model->max_x - model->min_x) / 2.0f;
+  model->center_y = model->min_y + (model->max_y - model->min_y) / 2.0f;
+  model->center_z = model->min_z + (model->max_z - model->min_z) / 2.0f;
+
+  /* Set the original properties (as this is the initial calculation). */
+  model->original_center_x = model->center_x;
+  model->original_center_y = model->center_y;
+  model->original_center_z = model->center_z;
+
+  /* Calculate the dimensions and find the largest one. */
+  dim_x = model->max_x - model->min_x;
+  dim_y = model->max_y - model->min_y;
+  dim_z = model->max_z - model->min_z;
+
+  model->original_max_dim = dim_x;
+  
+  if (dim_y > model->original_max_dim)
+  {
+    model->original_max_dim = dim_y;
+  }
+  if (dim_z > model->original_max_dim)
+  {
+    model->original_max_dim = dim_z;
+  }
+
+  /* Set the initial scale. */
+  model->current_scale = 1.0f;
+}
+
+RGF_API RGF_INLINE void rgf_model_calculate_boundaries(rgf_model *model)
+{
+  rgf_model_calculate_boundaries_parallel(model, 0);
+}
+
+/* Builds the vertex to triangle adjacency of the model into model->adjacency_offsets and
+   model->adjacency_triangles with a counting sort over the indices. The triangles of
+   vertex v are adjacency_triangles[adjacency_offsets[v]] up to adjacency_offsets[v + 1],
+   once per corner, in ascending order. Returns 0 if the buffers are missing or an index
+   is out of range.
+   The normal and tangent passes only gather over an adjacency built here, they never
+   build it themselves: for a single pass the build costs more than the gather saves.
+   Build it once when the normals are recomputed repeatedly on the same indices.
+*/
+RGF_API RGF_INLINE int rgf_model_build_adjacency(rgf_model *model)
+{
+  unsigned long vertex_count;
+  unsigned long corner_count;
+  unsigned long i;
+  unsigned int *offsets;
+  unsigned int *triangles;
+
+  if (!model || !model->indices || !model->adjacency_offsets || !model->adjacency_triangles)
+  {
+    return 0;
+  }
+
+  model->flags &= ~RGF_MODEL_FLAG_ADJACENCY;
+
+  vertex_count = model->vertices_size / 3;
+  corner_count = model->indices_size / 3 * 3;
+  offsets = model->adjacency_offsets;
+  triangles = model->adjacency_triangles;
+
+  if (corner_count > 0xFFFFFFFFUL)
+  {
+    return 0;
+  }
+
+  for (i = 0; i <= vertex_count; ++i)
+  {
+    offsets[i] = 0;
+  }
+
+  /* Count the corners of every vertex, one slot ahead */
+  for (i = 0; i < corner_count; ++i)
+  {
+    unsigned long index = rgf_model_index(model, i);
+
+    if (index >= vertex_count)
+    {
+      return 0;
+    }
+
+    offsets[index + 1]++;
+  }
+
+  for (i = 0; i < vertex_count; ++i)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+
+  /* Fill, offsets[v] moves on to the start of vertex v + 1 */
+  for (i = 0; i < corner_count; ++i)
+  {
+    triangles[offsets[rgf_model_index(model, i)]++] = (unsigned int)(i / 3);
+  }
+
+  for (i = vertex_count; i > 0; --i)
+  {
+    offsets[i] = offsets[i - 1];
+  }
+
+  offsets[0] = 0;
+
+  model->flags |= RGF_MODEL_FLAG_ADJACENCY;
+
+  return 1;
+}
+
+/* Returns 1 if model->adjacency_* was built by rgf_model_build_adjacency for the current indices */
+RGF_API RGF_INLINE int rgf_model_adjacency(rgf_model *model)
+{
+  return model->adjacency_offsets && model->adjacency_triangles && (model->flags & RGF_MODEL_FLAG_ADJACENCY);
+}
+
+/* Unnormalized normal (cross product of the edges) of a triangle */
+RGF_API RGF_INLINE void rgf_model_face_normal(rgf_model *model, unsigned long triangle, float *out)
+{
+  float edge1[3], edge2[3];
+  float *v1 = &model->vertices[rgf_model_index(model, triangle * 3 + 0) * 3];
+  float *v2 = &model->vertices[rgf_model_index(model, triangle * 3 + 1) * 3];
+  float *v3 = &model->vertices[rgf_model_index(model, triangle * 3 + 2) * 3];
+
+  rgf_v3_sub(edge1, v2, v1);
+  rgf_v3_sub(edge2, v3, v1);
+  rgf_v3_cross(out, edge1, edge2);
+}
+
+/* Weights of the face normals summed at a vertex by rgf_model_calculate_normals_weighted */
+#define RGF_NORMALS_WEIGHT_AREA 0  /* By triangle area: large faces dominate (the default)  */
+#define RGF_NORMALS_WEIGHT_ANGLE 1 /* By the angle of the triangle at the vertex: the normal
+                                      does not change when a face is split up differently */
+
+/* Weights of the face normal at the 3 corners of a triangle. The face normal already
+   scales with the area, for angle weights it is divided by its length and scaled by the
+   angles of the triangle: two from atan2(|edge1 x edge2|, edge1 . edge2), the third is
+   what remains of pi.
+*/
+RGF_API RGF_INLINE void rgf_model_face_weights(rgf_model *model, unsigned long triangle, int weighting, float *face_normal, float *weights)
+{
+  float edge01[3], edge02[3], edge12[3];
+  float *v0, *v1, *v2;
+  float length;
+  float angle0;
+  float angle1;
+
+  weights[0] = weights[1] = weights[2] = 1.0f;
+
+  if (weighting != RGF_NORMALS_WEIGHT_ANGLE)
+  {
+    return;
+  }
+
+  /* |edge1 x edge2| is the length of the face normal at every corner */
+  length = rgf_sqrtf(rgf_v3_dot(face_normal, face_normal));
+
+  if (!(length > 0.0f))
+  {
+    return;
+  }
+
+  v0 = &model->vertices[rgf_model_index(model, triangle * 3 + 0) * 3];
+  v1 = &model->vertices[rgf_model_index(model, triangle * 3 + 1) * 3];
+  v2 = &model->vertices[rgf_model_index(model, triangle * 3 + 2) * 3];
+
+  rgf_v3_sub(edge01, v1, v0);
+  rgf_v3_sub(edge02, v2, v0);
+  rgf_v3_sub(edge12, v2, v1);
+
+  angle0 = rgf_atan2f(length, rgf_v3_dot(edge01, edge02));
+  angle1 = rgf_atan2f(length, -rgf_v3_dot(edge01, edge12));
+
+  length = 1.0f / length;
+
+  weights[0] = angle0 * length;
+  weights[1] = angle1 * length;
+  weights[2] = (3.14159274f - angle0 - angle1) * length;
+}
+
+/* Unnormalized tangent and bitangent of a triangle from its positions and uvs */
+RGF_API RGF_INLINE void rgf_model_face_tangent(rgf_model *model, unsigned long triangle, float *tangent, float *bitangent)
+{
+  unsigned long i1 = rgf_model_index(model, triangle * 3 + 0);
+  unsigned long i2 = rgf_model_index(model, triangle * 3 + 1);
+  unsigned long i3 = rgf_model_index(model, triangle * 3 + 2);
+
+  /* Vertex positions */
+  float *v0 = &model->vertices[i1 * 3];
+  float *v1 = &model->vertices[i2 * 3];
+  float *v2 = &model->vertices[i3 * 3];
+
+  /* UV coordinates */
+  float *uv0 = &model->uvs[i1 * 2];
+  float *uv1 = &model->uvs[i2 * 2];
+  float *uv2 = &model->uvs[i3 * 2];
+
+  /* Edges of the triangle : position delta */
+  float deltaPos1[3], deltaPos2[3];
+
+  /* UV delta */
+  float deltaUV1[2];
+  float deltaUV2[2];
+
+  /* Calculate r = 1 / (determinant of UV matrix) */
+  float r;
+
+  deltaUV1[0] = uv1[0] - uv0[0];
+  deltaUV1[1] = uv1[1] - uv0[1];
+
+  deltaUV2[0] = uv2[0] - uv0[0];
+  deltaUV2[1] = uv2[1] - uv0[1];
+
+  r = deltaUV1[0] * deltaUV2[1] - deltaUV1[1] * deltaUV2[0];
+  r = r != 0.0f ? 1.0f / r : 0.0f;
+
+  rgf_v3_sub(deltaPos1, v1, v0);
+  rgf_v3_sub(deltaPos2, v2, v0);
+
+  /* Tangent & Bitangent */
+  tangent[0] = (deltaPos1[0] * deltaUV2[1] - deltaPos2[0] * deltaUV1[1]) * r;
+  tangent[1] = (deltaPos1[1] * deltaUV2[1] - deltaPos2[1] * deltaUV1[1]) * r;
+  tangent[2] = (deltaPos1[2] * deltaUV2[1] - deltaPos2[2] * deltaUV1[1]) * r;
+
+  bitangent[0] = (deltaPos2[0] * deltaUV1[0] - deltaPos1[0] * deltaUV2[0]) * r;
+  bitangent[1] = (deltaPos2[1] * deltaUV1[0] - deltaPos1[1] * deltaUV2[0]) * r;
+  bitangent[2] = (deltaPos2[2] * deltaUV1[0] - deltaPos1[2] * deltaUV2[0]) * r;
+}
+
+/* Smooth normals of count vertices from first, each summed from its adjacent faces. Every
+   vertex is written only by its own iteration, so ranges can run concurrently. The faces
+   are added in triangle order, the result matches the per triangle scatter exactly when
+   first is a multiple of 4 (see rgf_v3_normalize_batch).
+*/
+RGF_API RGF_INLINE void rgf_model_gather_normals(rgf_model *model, int weighting, unsigned long first, unsigned long count)
+{
+  unsigned long v;
+
+  for (v = first; v < first + count; ++v)
+  {
+    float *normal = &model->normals[v * 3];
+    unsigned long k;
+
+    normal[0] = normal[1] = normal[2] = 0.0f;
+
+    for (k = model->adjacency_offsets[v]; k < model->adjacency_offsets[v + 1]; ++k)
+    {
+      unsigned long triangle = model->adjacency_triangles[k];
+      unsigned long corner = 0;
+      float face_normal[3];
+      float weights[3];
+
+      rgf_model_face_normal(model, triangle, face_normal);
+      rgf_model_face_weights(model, triangle, weighting, face_normal, weights);
+
+      /* A vertex twice in a triangle has no area, so its first corner is as good */
+      while (corner < 2 && rgf_model_index(model, triangle * 3 + corner) != v)
+      {
+        corner++;
+      }
+
+      normal[0] += face_normal[0] * weights[corner];
+      normal[1] += face_normal[1] * weights[corner];
+      normal[2] += face_normal[2] * weights[corner];
+    }
+  }
+
+  rgf_v3_normalize_batch(&model->normals[first * 3], &model->normals[first * 3], count * 3);
+}
+
+/* rgf_model_gather_normals for tangents and bitangents, the faces are always summed as is */
+RGF_API RGF_INLINE void rgf_model_gather_tangents(rgf_model *model, int weighting, unsigned long first, unsigned long count)
+{
+  unsigned long v;
+
+  (void)weighting;
+
+  for (v = first; v < first + count; ++v)
+  {
+    float *tangent = &model->tangents[v * 3];
+    float *bitangent = &model->bitangents[v * 3];
+    unsigned long k;
+
+    tangent[0] = tangent[1] = tangent[2] = 0.0f;
+    bitangent[0] = bitangent[1] = bitangent[2] = 0.0f;
+
+    for (k = model->adjacency_offsets[v]; k < model->adjacency_offsets[v + 1]; ++k)
+    {
+      float face_tangent[3];
+      float face_bitangent[3];
+
+      rgf_model_face_tangent(model, model->adjacency_triangles[k], face_tangent, face_bitangent);
+      rgf_v3_add(tangent, tangent, face_tangent);
+      rgf_v3_add(bitangent, bitangent, face_bitangent);
+    }
+  }
+
+  rgf_v3_normalize_batch(&model->tangents[first * 3], &model->tangents[first * 3], count * 3);
+  rgf_v3_normalize_batch(&model->bitangents[first * 3], &model->bitangents[first * 3], count * 3);
+}
+
+/* Vertices per job below which a gather pass is not split further */
+#ifndef RGF_GATHER_JOB_VERTICES
+#define RGF_GATHER_JOB_VERTICES 32768
+#endif
+
+typedef void (*rgf_gather_function)(rgf_model *model, int weighting, unsigned long first, unsigned long count);
+
+typedef struct rgf_gather_pass
+{
+  rgf_model *model;
+  rgf_gather_function gather;
+  int weighting;
+  unsigned long vertex_count;
+  unsigned long job_count;
+
+} rgf_gather_pass;
+
+RGF_API void rgf_gather_job(void *job_data, unsigned long job_index)
+{
+  rgf_gather_pass *pass = (rgf_gather_pass *)job_data;
+  unsigned long step = pass->vertex_count / pass->job_count / 4 * 4;
+  unsigned long first = step * job_index;
+  unsigned long last = job_index + 1 == pass->job_count ? pass->vertex_count : step * (job_index + 1);
+
+  pass->gather(pass->model, pass->weighting, first, last - first);
+}
+
+/* Runs a gather over all vertices of the model split into vertex ranges for the jobs.
+   A gather computes every face once per corner, on a single thread the scatter is
+   cheaper, so 0 is returned without running anything if the pass would not be split
+   or the model has no adjacency.
+*/
+RGF_API RGF_INLINE int rgf_model_gather_parallel(rgf_model *model, rgf_gather_function gather, int weighting, rgf_job_system *jobs)
+{
+  rgf_gather_pass pass;
+
+  pass.model = model;
+  pass.gather = gather;
+  pass.weighting = weighting;
+  pass.vertex_count = model->vertices_size / 3;
+  pass.job_count = pass.vertex_count / RGF_GATHER_JOB_VERTICES;
+
+  if (pass.job_count > rgf_job_thread_count(jobs))
+  {
+    pass.job_count = rgf_job_thread_count(jobs);
+  }
+
+  if (pass.job_count <= 1 || !rgf_model_adjacency(model))
+  {
+    return 0;
+  }
+
+  rgf_job_run(jobs, rgf_gather_job, &pass, pass.job_count);
+
+  return 1;
+}
+
+/* Smooth vertex normals from the face normals weighted by RGF_NORMALS_WEIGHT_*. With an
+   adjacency built by rgf_model_build_adjacency and more than one thread every vertex
+   gathers its faces and the vertex ranges run through the job system, otherwise the face
+   normals are scattered to the vertices on the calling thread. Both give the same bits.
+*/
+RGF_API RGF_INLINE void rgf_model_calculate_normals_weighted(rgf_model *model, int weighting, rgf_job_system *jobs)
+{
+  unsigned long i;
+  float face_normal[3];
+  float weights[3];
+
+  if (!model->vertices || !model->indices || !model->normals)
+  {
+    return;
+  }
+
+  rgf_model_apply_transform(model);
+
+  model->flags &= ~RGF_MODEL_FLAG_NORMALS_PROVIDED;
+
+  if (rgf_model_gather_parallel(model, rgf_model_gather_normals, weighting, jobs))
+  {
+    return;
+  }
+
+  /* Initialize all normals to zero */
+  for (i = 0; i < model->vertices_size; ++i)
+  {
+    model->normals[i] = 0.0f;
+  }
+
+  /* Add the weighted face normal of each triangle to the normals of its three vertices */
+  for (i = 0; i < model->indices_size / 3; ++i)
+  {
+    unsigned long j;
+
+    rgf_model_face_normal(model, i, face_normal);
+    rgf_model_face_weights(model, i, weighting, face_normal, weights);
+
+    for (j = 0; j < 3; ++j)
+    {
+      float *normal = &model->normals[rgf_model_index(model, i * 3 + j) * 3];
+
+      normal[0] += face_normal[0] * weights[j];
+      normal[1] += face_normal[1] * weights[j];
+      normal[2] += face_normal[2] * weights[j];
+    }
+  }
+
+  /* Normalize each vertex normal to get the final smooth normal */
+  rgf_v3_normalize_batch(model->normals, model->normals, model->vertices_size);
+}
+
+RGF_API RGF_INLINE void rgf_model_calculate_normals_parallel(rgf_model *model, rgf_job_system *jobs)
+{
+  rgf_model_calculate_normals_weighted(model, RGF_NORMALS_WEIGHT_AREA, jobs);
+}
+
+RGF_API RGF_INLINE void rgf_model_calculate_normals(rgf_model *model)
+{
+  rgf_model_calculate_normals_weighted(model, RGF_NORMALS_WEIGHT_AREA, 0);
+}
+
+/* Per vertex tangents and bitangents, gathered in parallel like rgf_model_calculate_normals_parallel */
+RGF_API RGF_INLINE void rgf_model_calculate_tangents_bitangents_parallel(rgf_model *model, rgf_job_system *jobs)
+{
+  unsigned long i;
+
+  if (!model || !model->vertices || !model->indices || !model->uvs || !model->tangents || !model->bitangents)
+  {
+    return;
+  }
+
+  rgf_model_apply_transform(model);
+
+  model->tangents_size = model->vertices_size;
+  model->bitangents_size = model->vertices_size;
+
+  if (rgf_model_gather_parallel(model, rgf_model_gather_tangents, RGF_NORMALS_WEIGHT_AREA, jobs))
+  {
+    return;
+  }
+
+  /* Initialize to zero */
+  for (i = 0; i < model->vertices_size; ++i)
+  {
+    model->tangents[i] = 0.0f;
+    model->bitangents[i] = 0.0f;
+  }
+
+  /* Loop through each triangle */
+  for (i = 0; i < model->indices_size / 3; ++i)
+  {
+    unsigned long j;
+    float tangent[3];
+    float bitangent[3];
+
+    rgf_model_face_tangent(model, i, tangent, bitangent);
+
+    /* Add tangent and bitangent to each vertex of the triangle */
+    for (j = 0; j < 3; ++j)
+    {
+      unsigned long v = rgf_model_index(model, i * 3 + j) * 3;
+
+      model->tangents[v + 0] += tangent[0];
+      model->tangents[v + 1] += tangent[1];
+      model->tangents[v + 2] += tangent[2];
+
+      model->bitangents[v + 0] += bitangent[0];
+      model->bitangents[v + 1] += bitangent[1];
+      model->bitangents[v + 2] += bitangent[2];
+    }
+  }
+
+  /* Normalize tangents and bitangents */
+  rgf_v3_normalize_batch(model->tangents, model->tangents, model->vertices_size);
+  rgf_v3_normalize_batch(model->bitangents, model->bitangents, model->vertices_size);
+}
+
+RGF_API RGF_INLINE void rgf_model_calculate_tangents_bitangents(rgf_model *model)
+{
+  rgf_model_calculate_tangents_bitangents_parallel(model, 0);
+}
+
+/* Reorders the triangles so that every material is one contiguous index range and merges
+   the submeshes to one per material, so a renderer needs a single draw per material.
+   The order of the triangles within a material is kept. scratch has to hold
+   model->indices_size ints (or indices of the model index width).
+*/
+RGF_API RGF_INLINE void rgf_model_sort_submeshes(rgf_model *model, int *scratch)
+{
+  unsigned long i, j;
+  unsigned long count = 0;
+  unsigned long index_count = 0;
+  unsigned long width;
+
+  if (!model || !model->indices || !model->submeshes || !scratch)
+  {
+    return;
+  }
+
+  width = rgf_model_index_width(model);
+
+  /* The triangles are renumbered */
+  model->flags &= ~RGF_MODEL_FLAG_ADJACENCY;
+
+  /* Stable insertion sort by material, models have few submeshes */
+  for (i = 1; i < model->submeshes_size; ++i)
+  {
+    rgf_submesh submesh = model->submeshes[i];
+
+    for (j = i; j > 0 && model->submeshes[j - 1].material_hash > submesh.material_hash; --j)
+    {
+      model->submeshes[j] = model->submeshes[j - 1];
+    }
+
+    model->submeshes[j] = submesh;
+  }
+
+  /* Gather the index ranges in material order and merge equal materials */
+  for (i = 0; i < model->submeshes_size; ++i)
+  {
+    rgf_submesh submesh = model->submeshes[i];
+
+    rgf_binary_memcpy((unsigned char *)scratch + index_count * width, (unsigned char *)model->indices + submesh.index_offset * width, submesh.index_count * width);
+
+    if (count > 0 && model->submeshes[count - 1].material_hash == submesh.material_hash)
+    {
+      model->submeshes[count - 1].index_count += submesh.index_count;
+    }
+    else
+    {
+      submesh.index_offset = (unsigned int)index_count;
+      model->submeshes[count++] = submesh;
+    }
+
+    index_count += submesh.index_count;
+  }
+
+  rgf_binary_memcpy(model->indices, scratch, index_count * width);
+  model->submeshes_size = count;
+}
+
+/* A translation (scale 1 and offset) or a uniform scale as a 3x4 matrix */
+RGF_API RGF_INLINE void rgf_transform_matrix(float *matrix, float scale, float offset_x, float offset_y, float offset_z)
+{
+  int i;
+
+  for (i = 0; i < 12; ++i)
+  {
+    matrix[i] = 0.0f;
+  }
+
+  matrix[0] = matrix[5] = matrix[10] = scale;
+  matrix[3] = offset_x;
+  matrix[7] = offset_y;
+  matrix[11] = offset_z;
+}
+
+/* The center and scale functions only compose a deferred transform, the vertices are
+   transformed once when the library reads them. Call rgf_model_apply_transform before
+   reading the arrays directly.
+*/
+RGF_API RGF_INLINE void rgf_model_center(
+    rgf_model *model,
+    float center_x,
+    float center_y,
+    float center_z)
+{
+  float matrix[12];
+
+  if (!model->vertices)
+  {
+    return;
+  }
+
+  /* Move the current center of the model's bounding box to the new center */
+  rgf_transform_matrix(
+      matrix,
+      1.0f,
+      center_x - (model->min_x + model->max_x) / 2.0f,
+      center_y - (model->min_y + model->max_y) / 2.0f,
+      center_z - (model->min_z + model->max_z) / 2.0f);
+
+  rgf_model_transform_deferred(model, matrix);
+
+  model->center_x = center_x;
+  model->center_y = center_y;
+  model->center_z = center_z;
+}
+
+RGF_API RGF_INLINE void rgf_model_center_reset(
+    rgf_model *model)
+{
+  rgf_model_center(model, model->original_center_x, model->original_center_y, model->original_center_z);
+}
+
+RGF_API RGF_INLINE void rgf_model_scale(
+    rgf_model *model,
+    float scale)
+{
+  float matrix[12];
+  float new_scale_factor;
+  float center_x = model->center_x;
+  float center_y = model->center_y;
+  float center_z = model->center_z;
+
+  /* Handle degenerate case of no vertices */
+  if (!model->vertices || model->original_max_dim <= 0.0f)
+  {
+    return;
+  }
+
+  /* Calculate the desired scaling factor */
+  new_scale_factor = scale / model->original_max_dim;
+
+  /* Avoid redundant scaling if already at the desired scale */
+  if (new_scale_factor == model->current_scale)
+  {
+    return;
+  }
+
+  /* Calculate the actual scaling factor to apply incrementally */
+  new_scale_factor = new_scale_factor / model->current_scale;
+
+  rgf_transform_matrix(matrix, new_scale_factor, 0.0f, 0.0f, 0.0f);
+  rgf_model_transform_deferred(model, matrix);
+
+  model->center_x = center_x * new_scale_factor;
+  model->center_y = center_y * new_scale_factor;
+  model->center_z = center_z * new_scale_factor;
+  model->current_scale *= new_scale_factor;
+}
+
+RGF_API RGF_INLINE void rgf_model_scale_reset(
+    rgf_model *model)
+{
+  float matrix[12];
+
+  /* Handle degenerate cases */
+  if (!model->vertices || model->original_max_dim <= 0.0f || model->current_scale == 1.0f)
+  {
+    return;
+  }
+
+  /* The inverse of the current scale reverts to the original size, the bounds follow it */
+  rgf_transform_matrix(matrix, 1.0f / model->current_scale, 0.0f, 0.0f, 0.0f);
+  rgf_model_transform_deferred(model, matrix);
+
+  model->current_scale = 1.0f;
+}
+
+/* ########################################################## */
+/* # Interleaved vertex layout                                */
+/* ########################################################## */
+/* Vertex attributes, the same indices as RGF_BINARY_SECTION_* */
+#define RGF_VERTEX_POSITION 0
+#define RGF_VERTEX_NORMAL 1
+#define RGF_VERTEX_TANGENT 2
+#define RGF_VERTEX_BITANGENT 3
+#define RGF_VERTEX_UV 4
+#define RGF_VERTEX_ATTRIBUTES 5
+
+#define RGF_VERTEX_BIT(attribute) (1UL << (attribute))
+
+/* Where the attributes of a model are within one interleaved vertex */
+typedef struct rgf_vertex_layout
+{
+  unsigned long attributes;                     /* RGF_VERTEX_BIT of every interleaved attribute */
+  unsigned long offsets[RGF_VERTEX_ATTRIBUTES]; /* Byte offset of the attribute in a vertex      */
+  unsigned long stride;                         /* Bytes from one vertex to the next             */
+
+} rgf_vertex_layout;
+
+RGF_API RGF_INLINE unsigned long rgf_vertex_components(int attribute)
+{
+  return attribute == RGF_VERTEX_UV ? 2 : 3;
+}
+
+/* The model array of an attribute and its size */
+RGF_API RGF_INLINE float **rgf_vertex_attribute(rgf_model *model, int attribute, unsigned long **size)
+{
+  switch (attribute)
+  {
+  case RGF_VERTEX_POSITION:
+    *size = &model->vertices_size;
+    return &model->vertices;
+  case RGF_VERTEX_NORMAL:
+    *size = &model->normals_size;
+    return &model->normals;
+  case RGF_VERTEX_TANGENT:
+    *size = &model->tangents_size;
+    return &model->tangents;
+  case RGF_VERTEX_BITANGENT:
+    *size = &model->bitangents_size;
+    return &model->bitangents;
+  default:
+    *size = &model->uvs_size;
+    return &model->uvs;
+  }
+}
+
+/* Packs the attributes in attribute order without padding */
+RGF_API RGF_INLINE void rgf_vertex_layout_packed(rgf_vertex_layout *layout, unsigned long attributes)
+{
+  int attribute;
+
+  layout->attributes = attributes & ((1UL << RGF_VERTEX_ATTRIBUTES) - 1);
+  layout->stride = 0;
+
+  for (attribute = 0; attribute < RGF_VERTEX_ATTRIBUTES; ++attribute)
+  {
+    layout->offsets[attribute] = 0;
+
+    if (layout->attributes & RGF_VERTEX_BIT(attribute))
+    {
+      layout->offsets[attribute] = layout->stride;
+      layout->stride += rgf_vertex_components(attribute) * 4;
+    }
+  }
+}
+
+/* Sorts the attributes of a valid layout by offset, returns 0 for an invalid layout:
+   no attributes, unaligned or overlapping attributes, attributes outside of the stride.
+*/
+RGF_API RGF_INLINE int rgf_vertex_layout_order(rgf_vertex_layout *layout, int *order, unsigned long *order_size)
+{
+  unsigned long n = 0;
+  unsigned long i;
+  int attribute;
+
+  if (layout->attributes == 0 || layout->attributes >= (1UL << RGF_VERTEX_ATTRIBUTES) || layout->stride % 4 != 0)
+  {
+    return 0;
+  }
+
+  for (attribute = 0; attribute < RGF_VERTEX_ATTRIBUTES; ++attribute)
+  {
+    unsigned long offset = layout->offsets[attribute];
+
+    if (!(layout->attributes & RGF_VERTEX_BIT(attribute)))
+    {
+      continue;
+    }
+
+    if (offset % 4 != 0 || offset > layout->stride || rgf_vertex_components(attribute) * 4 > layout->stride - offset)
+    {
+      return 0;
+    }
+
+    /* Insertion sort, at most 5 attributes */
+    for (i = n; i > 0 && layout->offsets[order[i - 1]] > offset; --i)
+    {
+      order[i] = order[i - 1];
+    }
+
+    order[i] = attribute;
+    ++n;
+  }
+
+  for (i = 1; i < n; ++i)
+  {
+    if (layout->offsets[order[i - 1]] + rgf_vertex_components(order[i - 1]) * 4 > layout->offsets[order[i]])
+    {
+      /* overlapping attributes */
+      return 0;
+    }
+  }
+
+  *order_size = n;
+
+  return 1;
+}
+
+RGF_API RGF_INLINE void rgf_vertex_copy(float *out, float *in, unsigned long components)
+{
+  out[0] = in[0];
+  out[1] = in[1];
+
+  if (components == 3)
+  {
+    out[2] = in[2];
+  }
+}
+
+/* Copies 4 floats, the ones after the attribute have to be overwritten later (see
+   rgf_model_interleave). Loading all of them first lets compilers use one 16 byte move.
+*/
+RGF_API RGF_INLINE void rgf_vertex_copy4(float *out, float *in)
+{
+  float x = in[0];
+  float y = in[1];
+  float z = in[2];
+  float w = in[3];
+
+  out[0] = x;
+  out[1] = y;
+  out[2] = z;
+  out[3] = w;
+}
+
+/* Writes the attributes of the layout from the model arrays (SoA) into count = vertices_size / 3
+   interleaved vertices (AoS) in out, which needs count * stride bytes and 4 byte alignment.
+   Every attribute array needs count vertices. Every vertex is written in one pass in
+   ascending offset order. An attribute that is directly followed by the next one (or by
+   the first one of the next vertex) is written with a 16 byte copy, the spill is
+   overwritten by that attribute. Bytes that belong to no attribute are not touched.
+*/
+RGF_API RGF_INLINE int rgf_model_interleave(rgf_model *model, rgf_vertex_layout *layout, unsigned char *out)
+{
+  int order[RGF_VERTEX_ATTRIBUTES];
+  float *arrays[RGF_VERTEX_ATTRIBUTES];
+  unsigned long components[RGF_VERTEX_ATTRIBUTES];
+  int wide[RGF_VERTEX_ATTRIBUTES];
+  unsigned long order_size;
+  unsigned long count = model->vertices_size / 3;
+  unsigned long i;
+  unsigned long k;
+
+  if (!rgf_vertex_layout_order(layout, order, &order_size) || (rgf_address(out) & 3) != 0)
+  {
+    return 0;
+  }
+
+  rgf_model_apply_transform(model);
+
+  for (k = 0; k < order_size; ++k)
+  {
+    unsigned long *size;
+
+    arrays[k] = *rgf_vertex_attribute(model, order[k], &size);
+    components[k] = rgf_vertex_components(order[k]);
+
+    if (!arrays[k] || *size != count * components[k])
+    {
+      /* missing attribute */
+      return 0;
+    }
+  }
+
+  /* The spill of a 16 byte copy (at most 8 bytes) is covered by a following attribute */
+  for (k = 0; k < order_size; ++k)
+  {
+    unsigned long end = layout->offsets[order[k]] + components[k] * 4;
+
+    wide[k] = k + 1 < order_size ? end == layout->offsets[order[k + 1]] : end == layout->stride && layout->offsets[order[0]] == 0;
+  }
+
+  for (i = 0; i + 1 < count; ++i)
+  {
+    unsigned char *vertex = out + i * layout->stride;
+
+    for (k = 0; k < order_size; ++k)
+    {
+      float *attribute = (float *)(void *)(vertex + layout->offsets[order[k]]);
+
+      if (wide[k])
+      {
+        rgf_vertex_copy4(attribute, arrays[k] + i * components[k]);
+      }
+      else
+      {
+        rgf_vertex_copy(attribute, arrays[k] + i * components[k], components[k]);
+      }
+    }
+  }
+
+  /* The last vertex must not spill */
+  for (; i < count; ++i)
+  {
+    unsigned char *vertex = out + i * layout->stride;
+
+    for (k = 0; k < order_size; ++k)
+    {
+      rgf_vertex_copy((float *)(void *)(vertex + layout->offsets[order[k]]), arrays[k] + i * components[k], components[k]);
+    }
+  }
+
+  return 1;
+}
+
+/* Zeroes the bytes of count interleaved vertices that belong to no attribute of the layout */
+RGF_API RGF_INLINE void rgf_vertex_zero_padding(rgf_vertex_layout *layout, unsigned char *out, unsigned long count)
+{
+  int order[RGF_VERTEX_ATTRIBUTES];
+  unsigned long order_size;
+  unsigned long i;
+  unsigned long k;
+
+  if (!rgf_vertex_layout_order(layout, order, &order_size))
+  {
+    return;
+  }
+
+  for (i = 0; i < count; ++i)
+  {
+    unsigned char *vertex = out + i * layout->stride;
+    unsigned long end = 0;
+    unsigned long b;
+
+    for (k = 0; k < order_size; ++k)
+    {
+      for (b = end; b < layout->offsets[order[k]]; ++b)
+      {
+        vertex[b] = 0;
+      }
+
+      end = layout->offsets[order[k]] + rgf_vertex_components(order[k]) * 4;
+    }
+
+    for (b = end; b < layout->stride; ++b)
+    {
+      vertex[b] = 0;
+    }
+  }
+}
+
+/* Reads count interleaved vertices (AoS, 4 byte aligned) into the model arrays (SoA) of
+   the attributes of the layout, which need room for count vertices, and sets their sizes.
+   The copies spill into the next element of the array the same way. A pending transform
+   is dropped, unless arrays that it moves are kept, then it is applied first.
+*/
+RGF_API RGF_INLINE int rgf_model_deinterleave(rgf_model *model, rgf_vertex_layout *layout, unsigned char *in, unsigned long count)
+{
+  int order[RGF_VERTEX_ATTRIBUTES];
+  float *arrays[RGF_VERTEX_ATTRIBUTES];
+  unsigned long components[RGF_VERTEX_ATTRIBUTES];
+  unsigned long order_size;
+  unsigned long i;
+  unsigned long k;
+  int attribute;
+
+  if (!rgf_vertex_layout_order(layout, order, &order_size) || (rgf_address(in) & 3) != 0)
+  {
+    return 0;
+  }
+
+  /* The read arrays replace the ones the pending transform was for */
+  for (attribute = RGF_VERTEX_POSITION; attribute <= RGF_VERTEX_BITANGENT; ++attribute)
+  {
+    unsigned long *size;
+
+    if (*rgf_vertex_attribute(model, attribute, &size) && !(layout->attributes & RGF_VERTEX_BIT(attribute)))
+    {
+      rgf_model_apply_transform(model);
+    }
+  }
+
+  model->flags &= ~RGF_MODEL_FLAG_TRANSFORM_PENDING;
+
+  for (k = 0; k < order_size; ++k)
+  {
+    unsigned long *size;
+
+    arrays[k] = *rgf_vertex_attribute(model, order[k], &size);
+    components[k] = rgf_vertex_components(order[k]);
+
+    if (!arrays[k])
+    {
+      return 0;
+    }
+
+    *size = count * components[k];
+  }
+
+  for (i = 0; i + 1 < count; ++i)
+  {
+    unsigned char *vertex = in + i * layout->stride;
+
+    for (k = 0; k < order_size; ++k)
+    {
+      rgf_vertex_copy4(arrays[k] + i * components[k], (float *)(void *)(vertex + layout->offsets[order[k]]));
+    }
+  }
+
+  for (; i < count; ++i)
+  {
+    unsigned char *vertex = in + i * layout->stride;
+
+    for (k = 0; k < order_size; ++k)
+    {
+      rgf_vertex_copy(arrays[k] + i * components[k], (float *)(void *)(vertex + layout->offsets[order[k]]), components[k]);
+    }
+  }
+
+  return 1;
+}
+
+/* ########################################################## */
+/* # Binary En-/Decoding of rgf data                          */
+/* ########################################################## */
+#define RGF_BINARY_VERSION 2
+#define RGF_BINARY_VERSION_1 1 /* Legacy layout, decode only */
+#define RGF_BINARY_SIZE_MAGIC 4
+#define RGF_BINARY_SIZE_VERSION 4
+#define RGF_BINARY_SIZE_HEADER (RGF_BINARY_SIZE_MAGIC + RGF_BINARY_SIZE_VERSION)
+
+/* Version 2 layout, all fields little endian:
+
+     0  magic "RGF\0", u8 version, 3 zero bytes
+     8  u32 flags (RGF_MODEL_FLAG_*), u32 number of directory entries
+    16  f32 min xyz, max xyz, center xyz, original center xyz, original max dim, current scale
+    72  8 zero bytes
+    80  directory, one 40 byte entry per stored section:
+          u32 type (RGF_BINARY_SECTION_*), u32 encoding (RGF_BINARY_ENCODING_*),
+          u64 offset, u64 stored bytes, u64 element count, u32 FNV-1a of the stored bytes,
+          u32 compression (RGF_BINARY_COMPRESSION_*)
+        sections, each starting at a multiple of RGF_BINARY_ALIGNMENT (zero padded)
+
+   Raw sections are stored exactly like the model arrays (f32, i32 indices, rgf_submesh)
+   so decoding only points into the buffer. The directory allows to fetch or map only
+   the sections that are needed, see rgf_binary_decode_header.
+
+   Float sections can be stored quantized instead (see rgf_binary_encode_sections):
+     UNORM16     vertices, u16 per component of the min/max bounds in the header
+     OCTAHEDRAL  normals, tangents, bitangents, two snorm16 per unit vector
+     HALF        any float section (meant for uvs), IEEE binary16 per component
+   These sections can be uploaded as-is or are expanded by rgf_binary_decode_section_to.
+
+   Indices can be narrowed to INDEX16 (u16) or INDEX8 (u8) when every index fits (see
+   rgf_binary_index_encoding), by default they are stored at the model index width (see
+   rgf_model_narrow_indices). Decoding points to them as they are with the matching
+   model->index_width, so int indices stay readable as model->indices[i]. Or they are
+   stored lossless with TRIANGLE_FIFO (see rgf_binary_encode_triangles), the stored size
+   then depends on the mesh connectivity.
+
+   Vertex attributes can be stored as one INTERLEAVED section instead (see rgf_vertex_layout):
+   a 32 byte layout (u32 attribute bits, u32 stride, u32 offset per attribute, u32 zero)
+   followed by the vertices, ready for a vertex buffer. The element count of the section
+   is the number of floats of the attribute arrays it expands to.
+
+   Any encoded section can be compressed on top (see rgf_binary_compress), those are
+   expanded with rgf_binary_decompress_section before they are decoded.
+*/
+#define RGF_BINARY_ALIGNMENT 64
+#define RGF_BINARY_SIZE_HEADER_V2 80
+#define RGF_BINARY_SIZE_DIRECTORY_ENTRY 40
+
+#define RGF_BINARY_SECTION_VERTICES 0
+#define RGF_BINARY_SECTION_NORMALS 1
+#define RGF_BINARY_SECTION_TANGENTS 2
+#define RGF_BINARY_SECTION_BITANGENTS 3
+#define RGF_BINARY_SECTION_UVS 4
+#define RGF_BINARY_SECTION_INDICES 5
+#define RGF_BINARY_SECTION_SUBMESHES 6
+#define RGF_BINARY_SECTION_INTERLEAVED 7
+#define RGF_BINARY_SECTION_COUNT 8
+
+#define RGF_BINARY_SIZE_LAYOUT 32
+
+/* Section masks for rgf_binary_decode_sections */
+#define RGF_BINARY_SECTION_BIT(section) (1UL << (section))
+#define RGF_BINARY_SECTIONS_ALL ((1UL << RGF_BINARY_SECTION_COUNT) - 1)
+
+/* Enough bytes to decode the header and directory of every version 2 binary */
+#define RGF_BINARY_SIZE_HEADER_MAX (RGF_BINARY_SIZE_HEADER_V2 + RGF_BINARY_SECTION_COUNT * RGF_BINARY_SIZE_DIRECTORY_ENTRY)
+
+#define RGF_BINARY_ENCODING_RAW 0
+#define RGF_BINARY_ENCODING_UNORM16 1
+#define RGF_BINARY_ENCODING_OCTAHEDRAL 2
+#define RGF_BINARY_ENCODING_HALF 3
+#define RGF_BINARY_ENCODING_TRIANGLE_FIFO 4
+#define RGF_BINARY_ENCODING_INDEX16 5
+#define RGF_BINARY_ENCODING_INDEX8 6
+
+#define RGF_BINARY_COMPRESSION_NONE 0
+#define RGF_BINARY_COMPRESSION_LZ 1
+
+typedef struct rgf_binary_section
+{
+  unsigned long type;        /* RGF_BINARY_SECTION_*                   */
+  unsigned long encoding;    /* RGF_BINARY_ENCODING_*                  */
+  unsigned long compression; /* RGF_BINARY_COMPRESSION_*               */
+  unsigned long offset;      /* Byte offset from the start of the file */
+  unsigned long size;        /* Stored bytes                           */
+  unsigned long count;       /* Decoded elements                       */
+  unsigned long checksum;    /* FNV-1a of the stored bytes             */
+
+} rgf_binary_section;
+
+RGF_API RGF_INLINE int rgf_binary_is_little_endian(void)
+{
+  union
+  {
+    unsigned long l;
+    unsigned char c[sizeof(unsigned long)];
+  } u;
+
+  u.l = 1;
+
+  return u.c[0] == 1;
+}
+
+RGF_API RGF_INLINE unsigned long rgf_binary_align(unsigned long offset)
+{
+  return (offset + (RGF_BINARY_ALIGNMENT - 1)) & ~(unsigned long)(RGF_BINARY_ALIGNMENT - 1);
+}
+
+RGF_API RGF_INLINE unsigned long rgf_binary_element_size(int section)
+{
+  return section == RGF_BINARY_SECTION_SUBMESHES ? (unsigned long)sizeof(rgf_submesh) : 4;
+}
+
+/* Bytes per stored index of the encodings that store indices as they are used, else 0 */
+RGF_API RGF_INLINE unsigned long rgf_binary_encoding_index_width(unsigned long encoding)
+{
+  switch (encoding)
+  {
+  case RGF_BINARY_ENCODING_RAW:
+    return 4;
+  case RGF_BINARY_ENCODING_INDEX16:
+    return 2;
+  case RGF_BINARY_ENCODING_INDEX8:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+/* The model arrays in section order, arrays without data have a count of 0 */
+RGF_API RGF_INLINE void rgf_binary_sections(rgf_model *model, void **data, unsigned long *counts)
+{
+  int i;
+
+  data[RGF_BINARY_SECTION_VERTICES] = model->vertices;
+  data[RGF_BINARY_SECTION_NORMALS] = model->normals;
+  data[RGF_BINARY_SECTION_TANGENTS] = model->tangents;
+  data[RGF_BINARY_SECTION_BITANGENTS] = model->bitangents;
+  data[RGF_BINARY_SECTION_UVS] = model->uvs;
+  data[RGF_BINARY_SECTION_INDICES] = model->indices;
+  data[RGF_BINARY_SECTION_SUBMESHES] = model->submeshes;
+  data[RGF_BINARY_SECTION_INTERLEAVED] = 0;
+
+  counts[RGF_BINARY_SECTION_VERTICES] = model->vertices_size;
+  counts[RGF_BINARY_SECTION_NORMALS] = model->normals_size;
+  counts[RGF_BINARY_SECTION_TANGENTS] = model->tangents_size;
+  counts[RGF_BINARY_SECTION_BITANGENTS] = model->bitangents_size;
+  counts[RGF_BINARY_SECTION_UVS] = model->uvs_size;
+  counts[RGF_BINARY_SECTION_INDICES] = model->indices_size;
+  counts[RGF_BINARY_SECTION_SUBMESHES] = model->submeshes_size;
+  counts[RGF_BINARY_SECTION_INTERLEAVED] = 0;
+
+  for (i = 0; i < RGF_BINARY_SECTION_COUNT; ++i)
+  {
+    if (!data[i])
+    {
+      counts[i] = 0;
+    }
+  }
+}
+
+/* The 14 geometry fields of the header in storage order */
+RGF_API RGF_INLINE void rgf_binary_geometry_fields(rgf_model *model, float **fields)
+{
+  fields[0] = &model->min_x;
+  fields[1] = &model->min_y;
+  fields[2] = &model->min_z;
+  fields[3] = &model->max_x;
+  fields[4] = &model->max_y;
+  fields[5] = &model->max_z;
+  fields[6] = &model->center_x;
+  fields[7] = &model->center_y;
+  fields[8] = &model->center_z;
+  fields[9] = &model->original_center_x;
+  fields[10] = &model->original_center_y;
+  fields[11] = &model->original_center_z;
+  fields[12] = &model->original_max_dim;
+  fields[13] = &model->current_scale;
+}
+
+RGF_API RGF_INLINE unsigned long rgf_binary_float_bits(float f)
+{
+  union
+  {
+    unsigned int i;
+    float f;
+  } u;
+
+  u.f = f;
+
+  return u.i;
+}
+
+RGF_API RGF_INLINE void rgf_binary_write_u32(unsigned char *ptr, unsigned long value)
+{
+  ptr[0] = (unsigned char)(value & 0xFF);
+  ptr[1] = (unsigned char)((value >> 8) & 0xFF);
+  ptr[2] = (unsigned char)((value >> 16) & 0xFF);
+  ptr[3] = (unsigned char)((value >> 24) & 0xFF);
+}
+
+RGF_API RGF_INLINE void rgf_binary_write_u64(unsigned char *ptr, unsigned long value)
+{
+  rgf_binary_write_u32(ptr, value & 0xFFFFFFFFUL);
+  rgf_binary_write_u32(ptr + 4, (value >> 16) >> 16); /* Two shifts, unsigned long can be 32 bit */
+}
+
+RGF_API RGF_INLINE unsigned long rgf_binary_read_ul(unsigned char *ptr)
+{
+  return ((unsigned long)ptr[0]) |
+         ((unsigned long)ptr[1] << 8) |
+         ((unsigned long)ptr[2] << 16) |
+         ((unsigned long)ptr[3] << 24);
+}
+
+/* Reads a u64, returns 0 if the value does not fit into an unsigned long */
+RGF_API RGF_INLINE int rgf_binary_read_u64(unsigned char *ptr, unsigned long *value)
+{
+  unsigned long high = rgf_binary_read_ul(ptr + 4);
+
+  *value = rgf_binary_read_ul(ptr);
+
+  if (high)
+  {
+    if (sizeof(unsigned long) < 8)
+    {
+      return 0;
+    }
+
+    *value |= (high << 16) << 16;
+  }
+
+  return 1;
+}
+
+RGF_API RGF_INLINE float rgf_binary_read_float(unsigned char *ptr)
+{
+  union
+  {
+    unsigned int i;
+    float f;
+  } u;
+
+  u.i = (unsigned int)rgf_binary_read_ul(ptr);
+
+  return u.f;
+}
+
+RGF_API RGF_INLINE void rgf_binary_write_u16(unsigned char *ptr, unsigned long value)
+{
+  ptr[0] = (unsigned char)(value & 0xFF);
+  ptr[1] = (unsigned char)((value >> 8) & 0xFF);
+}
+
+/* Rounds to nearest even, out of range values become infinity */
+RGF_API RGF_INLINE unsigned long rgf_binary_float_to_half(float f)
+{
+  unsigned long bits = rgf_binary_float_bits(f);
+  unsigned long sign = (bits >> 16) & 0x8000UL;
+  unsigned long exponent = (bits >> 23) & 0xFFUL;
+  unsigned long mantissa = bits & 0x7FFFFFUL;
+  unsigned long half;
+  unsigned long remainder;
+  unsigned long halfway;
+  unsigned long shift;
+
+  if (exponent == 0xFF)
+  {
+    /* inf and nan */
+    return sign | 0x7C00UL | (mantissa ? 0x200UL : 0);
+  }
+
+  if (exponent > 142)
+  {
+    return sign | 0x7C00UL;
+  }
+
+  if (exponent >= 113)
+  {
+    /* A carry out of the mantissa correctly increments the exponent */
+    half = ((exponent - 112) << 10) | (mantissa >> 13);
+    remainder = mantissa & 0x1FFFUL;
+
+    if (remainder > 0x1000UL || (remainder == 0x1000UL && (half & 1)))
+    {
+      ++half;
+    }
+
+    return sign | half;
+  }
+
+  if (exponent < 102)
+  {
+    return sign;
+  }
+
+  /* Subnormal half */
+  mantissa |= 0x800000UL;
+  shift = 126 - exponent;
+  half = mantissa >> shift;
+  remainder = mantissa & ((1UL << shift) - 1);
+  halfway = 1UL << (shift - 1);
+
+  if (remainder > halfway || (remainder == halfway && (half & 1)))
+  {
+    ++half;
+  }
+
+  return sign | half;
+}
+
+/* Moves the half exponent into float range by a multiply with 2^112, which also
+   normalizes subnormal halfs. The SIMD paths below do the same per lane.
+*/
+RGF_API RGF_INLINE float rgf_binary_half_to_float(unsigned long h)
+{
+  unsigned long exponent_mantissa = h & 0x7FFFUL;
+  unsigned long bits = rgf_binary_float_bits(rgf_float_from_bits(exponent_mantissa << 13) * rgf_float_from_bits(0x77800000UL));
+
+  if (exponent_mantissa >= 0x7C00UL)
+  {
+    /* inf and nan */
+    bits |= 0x7F800000UL;
+  }
+
+  return rgf_float_from_bits(bits | ((h & 0x8000UL) << 16));
+}
+
+RGF_API RGF_INLINE long rgf_binary_round(float f)
+{
+  return (long)(f < 0.0f ? f - 0.5f : f + 0.5f);
+}
+
+/* Per axis offset and scale between the header bounds and the UNORM16 range */
+RGF_API RGF_INLINE void rgf_binary_unorm16_range(rgf_model *model, float *offset, float *scale)
+{
+  offset[0] = model->min_x;
+  offset[1] = model->min_y;
+  offset[2] = model->min_z;
+
+  scale[0] = (model->max_x - model->min_x) / 65535.0f;
+  scale[1] = (model->max_y - model->min_y) / 65535.0f;
+  scale[2] = (model->max_z - model->min_z) / 65535.0f;
+}
+
+/* Returns 0 if a position is outside of the bounds (or nan) */
+RGF_API RGF_INLINE int rgf_binary_quantize_unorm16(unsigned char *out, float *in, unsigned long count, rgf_model *model)
+{
+  float min[3];
+  float max[3];
+  float scale[3];
+  unsigned long i;
+
+  min[0] = model->min_x;
+  min[1] = model->min_y;
+  min[2] = model->min_z;
+  max[0] = model->max_x;
+  max[1] = model->max_y;
+  max[2] = model->max_z;
+
+  for (i = 0; i < 3; ++i)
+  {
+    scale[i] = max[i] > min[i] ? 65535.0f / (max[i] - min[i]) : 0.0f;
+  }
+
+  for (i = 0; i < count; ++i)
+  {
+    unsigned long axis = i % 3;
+    long q;
+
+    if (!(in[i] >= min[axis] && in[i] <= max[axis]))
+    {
+      return 0;
+    }
+
+    q = rgf_binary_round((in[i] - min[axis]) * scale[axis]);
+
+    rgf_binary_write_u16(out + i * 2, (unsigned long)(q > 65535 ? 65535 : q));
+  }
+
+  return 1;
+}
+
+RGF_API RGF_INLINE void rgf_binary_quantize_octahedral(unsigned char *out, float *in, unsigned long count)
+{
+  unsigned long i;
+
+  for (i = 0; i + 2 < count; i += 3)
+  {
+    float x = in[i];
+    float y = in[i + 1];
+    float z = in[i + 2];
+    float ax = x < 0.0f ? -x : x;
+    float ay = y < 0.0f ? -y : y;
+    float az = z < 0.0f ? -z : z;
+    float l1 = ax + ay + az;
+    long qx;
+    long qy;
+
+    if (l1 > 0.0f)
+    {
+      x /= l1;
+      y /= l1;
+    }
+
+    /* Fold the lower hemisphere over the diagonals */
+    if (z < 0.0f)
+    {
+      float fx = (1.0f - (y < 0.0f ? -y : y)) * (x < 0.0f ? -1.0f : 1.0f);
+      float fy = (1.0f - (x < 0.0f ? -x : x)) * (y < 0.0f ? -1.0f : 1.0f);
+      x = fx;
+      y = fy;
+    }
+
+    qx = rgf_binary_round(x * 32767.0f);
+    qy = rgf_binary_round(y * 32767.0f);
+
+    rgf_binary_write_u16(out + (i / 3) * 4, (unsigned long)(qx < -32767 ? -32767 : (qx > 32767 ? 32767 : qx)) & 0xFFFFUL);
+    rgf_binary_write_u16(out + (i / 3) * 4 + 2, (unsigned long)(qy < -32767 ? -32767 : (qy > 32767 ? 32767 : qy)) & 0xFFFFUL);
+  }
+}
+
+RGF_API RGF_INLINE void rgf_binary_quantize_half(unsigned char *out, float *in, unsigned long count)
+{
+  unsigned long i;
+
+  for (i = 0; i < count; ++i)
+  {
+    rgf_binary_write_u16(out + i * 2, rgf_binary_float_to_half(in[i]));
+  }
+}
+
+/* out[i] = offset[i % 3] + in[i] * scale[i % 3], 12 components (4 positions) per SIMD step */
+RGF_API RGF_INLINE void rgf_binary_dequantize_unorm16(float *out, unsigned short *in, unsigned long count, float *offset, float *scale)
+{
+  unsigned long i = 0;
+
+#if defined(RGF_SIMD_SSE2)
+  __m128i zero = _mm_setzero_si128();
+  __m128 o0 = _mm_setr_ps(offset[0], offset[1], offset[2], offset[0]);
+  __m128 o1 = _mm_setr_ps(offset[1], offset[2], offset[0], offset[1]);
+  __m128 o2 = _mm_setr_ps(offset[2], offset[0], offset[1], offset[2]);
+  __m128 s0 = _mm_setr_ps(scale[0], scale[1], scale[2], scale[0]);
+  __m128 s1 = _mm_setr_ps(scale[1], scale[2], scale[0], scale[1]);
+  __m128 s2 = _mm_setr_ps(scale[2], scale[0], scale[1], scale[2]);
+
+  for (; i + 12 <= count; i += 12)
+  {
+    __m128i q = _mm_loadu_si128((__m128i *)(void *)(in + i));
+    __m128i r = _mm_loadl_epi64((__m128i *)(void *)(in + i + 8));
+
+    _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(q, zero)), s0), o0));
+    _mm_storeu_ps(out + i + 4, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(q, zero)), s1), o1));
+    _mm_storeu_ps(out + i + 8, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(r, zero)), s2), o2));
+  }
+#elif defined(RGF_SIMD_NEON)
+  float pattern[24];
+  float32x4_t o0, o1, o2, s0, s1, s2;
+
+  for (i = 0; i < 12; ++i)
+  {
+    pattern[i] = offset[i % 3];
+    pattern[12 + i] = scale[i % 3];
+  }
+
+  o0 = vld1q_f32(pattern);
+  o1 = vld1q_f32(pattern + 4);
+  o2 = vld1q_f32(pattern + 8);
+  s0 = vld1q_f32(pattern + 12);
+  s1 = vld1q_f32(pattern + 16);
+  s2 = vld1q_f32(pattern + 20);
+
+  for (i = 0; i + 12 <= count; i += 12)
+  {
+    uint16x8_t q = vld1q_u16(in + i);
+    uint16x4_t r = vld1_u16(in + i + 8);
+
+    vst1q_f32(out + i, vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(q))), s0), o0));
+    vst1q_f32(out + i + 4, vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(q))), s1), o1));
+    vst1q_f32(out + i + 8, vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(r)), s2), o2));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    out[i] = (float)in[i] * scale[i % 3] + offset[i % 3];
+  }
+}
+
+#if defined(RGF_SIMD_SSE2)
+RGF_API RGF_INLINE __m128 rgf_binary_half_to_float_sse2(__m128i h)
+{
+  __m128i exponent_mantissa = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+  __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, exponent_mantissa), 16);
+  __m128 f = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponent_mantissa, 13)), _mm_castsi128_ps(_mm_set1_epi32(0x77800000)));
+  __m128i inf_nan = _mm_and_si128(_mm_cmpgt_epi32(exponent_mantissa, _mm_set1_epi32(0x7BFF)), _mm_set1_epi32(0x7F800000));
+
+  return _mm_castsi128_ps(_mm_or_si128(_mm_or_si128(_mm_castps_si128(f), inf_nan), sign));
+}
+#elif defined(RGF_SIMD_NEON)
+RGF_API RGF_INLINE float32x4_t rgf_binary_half_to_float_neon(uint32x4_t h)
+{
+  uint32x4_t exponent_mantissa = vandq_u32(h, vdupq_n_u32(0x7FFF));
+  uint32x4_t sign = vshlq_n_u32(veorq_u32(h, exponent_mantissa), 16);
+  float32x4_t f = vmulq_f32(vreinterpretq_f32_u32(vshlq_n_u32(exponent_mantissa, 13)), vreinterpretq_f32_u32(vdupq_n_u32(0x77800000)));
+  uint32x4_t inf_nan = vandq_u32(vcgtq_u32(exponent_mantissa, vdupq_n_u32(0x7BFF)), vdupq_n_u32(0x7F800000));
+
+  return vreinterpretq_f32_u32(vorrq_u32(vorrq_u32(vreinterpretq_u32_f32(f), inf_nan), sign));
+}
+#endif
+
+/* 8 halfs per SIMD step */
+RGF_API RGF_INLINE void rgf_binary_dequantize_half(float *out, unsigned short *in, unsigned long count)
+{
+  unsigned long i = 0;
+
+#if defined(RGF_SIMD_SSE2)
+  __m128i zero = _mm_setzero_si128();
+
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i h = _mm_loadu_si128((__m128i *)(void *)(in + i));
+
+    _mm_storeu_ps(out + i, rgf_binary_half_to_float_sse2(_mm_unpacklo_epi16(h, zero)));
+    _mm_storeu_ps(out + i + 4, rgf_binary_half_to_float_sse2(_mm_unpackhi_epi16(h, zero)));
+  }
+#elif defined(RGF_SIMD_NEON)
+  for (; i + 8 <= count; i += 8)
+  {
+    uint16x8_t h = vld1q_u16(in + i);
+
+    vst1q_f32(out + i, rgf_binary_half_to_float_neon(vmovl_u16(vget_low_u16(h))));
+    vst1q_f32(out + i + 4, rgf_binary_half_to_float_neon(vmovl_u16(vget_high_u16(h))));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    out[i] = rgf_binary_half_to_float(in[i]);
+  }
+}
+
+/* Unfolds two snorm16 per vector back to a unit vector, 4 vectors per SIMD step */
+RGF_API RGF_INLINE void rgf_binary_dequantize_octahedral(float *out, short *in, unsigned long count)
+{
+  unsigned long vectors = count / 3;
+  unsigned long v = 0;
+
+#if defined(RGF_SIMD_SSE2)
+  __m128 zero = _mm_setzero_ps();
+  __m128 one = _mm_set1_ps(1.0f);
+  __m128 inv = _mm_set1_ps(1.0f / 32767.0f);
+  __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+  for (; v + 4 <= vectors; v += 4)
+  {
+    float xyz[12];
+    unsigned long k;
+    __m128i q = _mm_loadu_si128((__m128i *)(void *)(in + v * 2));
+    __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(q, 16), 16)), inv);
+    __m128 y = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(q, 16)), inv);
+    __m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(sign_mask, x)), _mm_andnot_ps(sign_mask, y));
+    __m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+    __m128 inv_length;
+
+    /* x -= t with the sign of x */
+    x = _mm_sub_ps(x, _mm_or_ps(t, _mm_and_ps(x, sign_mask)));
+    y = _mm_sub_ps(y, _mm_or_ps(t, _mm_and_ps(y, sign_mask)));
+
+    inv_length = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+
+    _mm_storeu_ps(xyz, _mm_mul_ps(x, inv_length));
+    _mm_storeu_ps(xyz + 4, _mm_mul_ps(y, inv_length));
+    _mm_storeu_ps(xyz + 8, _mm_mul_ps(z, inv_length));
+
+    for (k = 0; k < 4; ++k)
+    {
+      out[(v + k) * 3] = xyz[k];
+      out[(v + k) * 3 + 1] = xyz[4 + k];
+      out[(v + k) * 3 + 2] = xyz[8 + k];
+    }
+  }
+#elif defined(RGF_SIMD_NEON)
+  float32x4_t zero = vdupq_n_f32(0.0f);
+  float32x4_t one = vdupq_n_f32(1.0f);
+  float32x4_t inv = vdupq_n_f32(1.0f / 32767.0f);
+  uint32x4_t sign_mask = vdupq_n_u32(0x80000000U);
+
+  for (; v + 4 <= vectors; v += 4)
+  {
+    int16x4x2_t q = vld2_s16(in + v * 2);
+    float32x4x3_t xyz;
+    float32x4_t x = vmulq_f32(vcvtq_f32_s32(vmovl_s16(q.val[0])), inv);
+    float32x4_t y = vmulq_f32(vcvtq_f32_s32(vmovl_s16(q.val[1])), inv);
+    float32x4_t z = vsubq_f32(vsubq_f32(one, vabsq_f32(x)), vabsq_f32(y));
+    float32x4_t t = vmaxq_f32(vnegq_f32(z), zero);
+    float32x4_t length_squared;
+    float32x4_t r;
+
+    x = vsubq_f32(x, vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(t), vandq_u32(vreinterpretq_u32_f32(x), sign_mask))));
+    y = vsubq_f32(y, vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(t), vandq_u32(vreinterpretq_u32_f32(y), sign_mask))));
+
+    /* Reciprocal square root estimate refined by two newton steps */
+    length_squared = vaddq_f32(vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y)), vmulq_f32(z, z));
+    r = vrsqrteq_f32(length_squared);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(length_squared, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(length_squared, r), r));
+
+    xyz.val[0] = vmulq_f32(x, r);
+    xyz.val[1] = vmulq_f32(y, r);
+    xyz.val[2] = vmulq_f32(z, r);
+    vst3q_f32(out + v * 3, xyz);
+  }
+#endif
+
+  for (; v < vectors; ++v)
+  {
+    float n[3];
+    float t;
+
+    n[0] = (float)in[v * 2] * (1.0f / 32767.0f);
+    n[1] = (float)in[v * 2 + 1] * (1.0f / 32767.0f);
+    n[2] = 1.0f - (n[0] < 0.0f ? -n[0] : n[0]) - (n[1] < 0.0f ? -n[1] : n[1]);
+    t = n[2] < 0.0f ? -n[2] : 0.0f;
+    n[0] += n[0] < 0.0f ? t : -t;
+    n[1] += n[1] < 0.0f ? t : -t;
+
+    rgf_v3_normalize(out + v * 3, n);
+  }
+}
+
+/* Lossless index codec in the spirit of edge/vertex FIFO codecs. Per triangle:
+
+     code byte  bits 5..7 edge e, bits 3..4 rotation r, bits 0..2 vertex code
+     r < 3      the triangle shares the reversed edge e of the last RGF_BINARY_TRIANGLE_EDGE_FIFO
+                edges, the edge starts at corner r and only the third corner is coded
+     r == 3     no shared edge, bits 5..7 and 0..2 code the first two corners and a second
+                byte the third corner
+
+   The varints of the coded corners follow the code bytes. A vertex code below
+   RGF_BINARY_TRIANGLE_VERTEX_FIFO selects one of the last explicit vertices, otherwise a
+   zigzag varint with the distance to the highest index seen so far + 1 follows and the
+   vertex enters the FIFO. The exact triangle order and corner rotation is kept.
+*/
+#define RGF_BINARY_TRIANGLE_EDGE_FIFO 8   /* Ring buffer of 8 edges                */
+#define RGF_BINARY_TRIANGLE_VERTEX_FIFO 7 /* Ring buffer of 8, 7 codes addressable */
+#define RGF_BINARY_TRIANGLE_EXPLICIT RGF_BINARY_TRIANGLE_VERTEX_FIFO
+
+/* Worst case of two code bytes and three 5 byte varints per triangle */
+RGF_API RGF_INLINE unsigned long rgf_binary_triangles_bound(unsigned long count)
+{
+  return count / 3 * 17;
+}
+
+RGF_API RGF_INLINE unsigned long rgf_binary_write_varint(unsigned char *out, unsigned long value)
+{
+  unsigned long size = 0;
+
+  while (value >= 0x80)
+  {
+    out[size++] = (unsigned char)((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+
+  out[size++] = (unsigned char)value;
+
+  return size;
+}
+
+/* Reads a varint of at most 32 bits, returns 0 if it is truncated or too long */
+RGF_API RGF_INLINE int rgf_binary_read_varint(unsigned char **ptr, unsigned char *end, unsigned long *value)
+{
+  unsigned char *p = *ptr;
+  unsigned long result = 0;
+  int shift = 0;
+
+  while (p < end)
+  {
+    unsigned long byte = *p++;
+
+    if (shift == 28 && byte > 0x0F)
+    {
+      return 0;
+    }
+
+    result |= (byte & 0x7F) << shift;
+
+    if (byte < 0x80)
+    {
+      *ptr = p;
+      *value = result;
+      return 1;
+    }
+
+    shift += 7;
+  }
+
+  return 0;
+}
+
+/* Codes a corner and updates the state like rgf_binary_triangle_read_vertex */
+RGF_API RGF_INLINE unsigned long rgf_binary_triangle_write_vertex(
+    unsigned char *out,
+    unsigned long *n,
+    int vertex,
+    int *vertex_fifo,
+    unsigned long *vertex_head,
+    unsigned long *next)
+{
+  unsigned long delta;
+  unsigned long k;
+
+  for (k = 0; k < RGF_BINARY_TRIANGLE_VERTEX_FIFO; ++k)
+  {
+    if (vertex_fifo[(*vertex_head - 1 - k) & 7] == vertex)
+    {
+      return k;
+    }
+  }
+
+  /* Zigzag varint of the distance to the highest index seen + 1 */
+  delta = ((unsigned long)vertex - *next) & 0xFFFFFFFFUL;
+  *n += rgf_binary_write_varint(out + *n, ((delta << 1) ^ ((delta & 0x80000000UL) ? 0xFFFFFFFFUL : 0)) & 0xFFFFFFFFUL);
+
+  if ((unsigned long)vertex + 1 > *next)
+  {
+    *next = (unsigned long)vertex + 1;
+  }
+
+  vertex_fifo[(*vertex_head)++ & 7] = vertex;
+
+  return RGF_BINARY_TRIANGLE_EXPLICIT;
+}
+
+/* rgf_binary_encode_triangles for indices of width bytes (see rgf_index_get) */
+RGF_API RGF_INLINE int rgf_binary_encode_triangles_width(unsigned char *out, void *indices, unsigned long width, unsigned long count, unsigned long *size)
+{
+  int edge_a[RGF_BINARY_TRIANGLE_EDGE_FIFO] = {0};
+  int edge_b[RGF_BINARY_TRIANGLE_EDGE_FIFO] = {0};
+  int vertex_fifo[8] = {0};
+  unsigned long edge_head = 0;
+  unsigned long vertex_head = 0;
+  unsigned long next = 0;
+  unsigned long n = 0;
+  unsigned long t;
+
+  for (t = 0; t + 2 < count; t += 3)
+  {
+    int triangle[3];
+    unsigned long code = n;
+    unsigned long e;
+    unsigned long r = 3;
+    unsigned long i;
+
+    for (i = 0; i < 3; ++i)
+    {
+      unsigned long index = rgf_index_get(indices, width, t + i);
+
+      if (index > 0x7FFFFFFFUL)
+      {
+        /* negative index */
+        return 0;
+      }
+
+      triangle[i] = (int)index;
+    }
+
+    for (e = 0; e < RGF_BINARY_TRIANGLE_EDGE_FIFO && r == 3; ++e)
+    {
+      unsigned long slot = (edge_head - 1 - e) & 7;
+
+      for (i = 0; i < 3; ++i)
+      {
+        if (triangle[i] == edge_a[slot] && triangle[(i + 1) % 3] == edge_b[slot])
+        {
+          r = i;
+          break;
+        }
+      }
+    }
+
+    /* The code bytes come first, the varints of the corners follow them */
+    if (r < 3)
+    {
+      n += 1;
+      out[code] = (unsigned char)(((e - 1) << 5) | (r << 3) | rgf_binary_triangle_write_vertex(out, &n, triangle[(r + 2) % 3], vertex_fifo, &vertex_head, &next));
+    }
+    else
+    {
+      unsigned long code_a;
+      unsigned long code_b;
+
+      n += 2;
+      code_a = rgf_binary_triangle_write_vertex(out, &n, triangle[0], vertex_fifo, &vertex_head, &next);
+      code_b = rgf_binary_triangle_write_vertex(out, &n, triangle[1], vertex_fifo, &vertex_head, &next);
+      out[code + 1] = (unsigned char)rgf_binary_triangle_write_vertex(out, &n, triangle[2], vertex_fifo, &vertex_head, &next);
+      out[code] = (unsigned char)((code_a << 5) | (3 << 3) | code_b);
+    }
+
+    for (i = 0; i < 3; ++i)
+    {
+      edge_a[edge_head & 7] = triangle[(i + 1) % 3];
+      edge_b[edge_head & 7] = triangle[i];
+      ++edge_head;
+    }
+  }
+
+  *size = n;
+
+  return 1;
+}
+
+/* Encodes count indices (a multiple of 3, all >= 0) into out, which needs
+   rgf_binary_triangles_bound(count) bytes. Returns 0 for negative indices.
+*/
+RGF_API RGF_INLINE int rgf_binary_encode_triangles(unsigned char *out, int *indices, unsigned long count, unsigned long *size)
+{
+  return rgf_binary_encode_triangles_width(out, indices, 4, count, size);
+}
+
+/* Reads the corner for a vertex code, explicit vertices enter the vertex FIFO */
+RGF_API RGF_INLINE int rgf_binary_triangle_read_vertex(
+    unsigned char **p,
+    unsigned char *end,
+    unsigned long code,
+    int *vertex_fifo,
+    unsigned long *vertex_head,
+    unsigned long *next,
+    int *vertex)
+{
+  unsigned long value;
+
+  if (code < RGF_BINARY_TRIANGLE_EXPLICIT)
+  {
+    *vertex = vertex_fifo[(*vertex_head - 1 - code) & 7];
+    return 1;
+  }
+
+  /* Most explicit vertices are close to the highest index seen and fit into one byte */
+  if (*p < end && **p < 0x80)
+  {
+    value = *(*p)++;
+  }
+  else if (!rgf_binary_read_varint(p, end, &value))
+  {
+    return 0;
+  }
+
+  value = (*next + ((value >> 1) ^ ((value & 1) ? 0xFFFFFFFFUL : 0))) & 0xFFFFFFFFUL;
+
+  if (value > 0x7FFFFFFFUL)
+  {
+    return 0;
+  }
+
+  if (value + 1 > *next)
+  {
+    *next = value + 1;
+  }
+
+  *vertex = (int)value;
+  vertex_fifo[(*vertex_head)++ & 7] = *vertex;
+
+  return 1;
+}
+
+/* Decodes count indices from the size bytes of data, returns 0 for corrupt data */
+RGF_API RGF_INLINE int rgf_binary_decode_triangles(int *out, unsigned char *data, unsigned long size, unsigned long count)
+{
+  int edge_a[RGF_BINARY_TRIANGLE_EDGE_FIFO] = {0};
+  int edge_b[RGF_BINARY_TRIANGLE_EDGE_FIFO] = {0};
+  int vertex_fifo[8] = {0};
+  unsigned long edge_head = 0;
+  unsigned long vertex_head = 0;
+  unsigned long next = 0;
+  unsigned char *p = data;
+  unsigned char *end = data + size;
+  unsigned long t;
+
+  for (t = 0; t + 2 < count; t += 3)
+  {
+    int *triangle = out + t;
+    unsigned long code;
+    int a, b, c;
+
+    if (p >= end)
+    {
+      return 0;
+    }
+
+    code = *p++;
+
+    if (((code >> 3) & 3) < 3)
+    {
+      /* Shared edge, the corner rotation is kept */
+      unsigned long slot = (edge_head - 1 - (code >> 5)) & 7;
+
+      if (!rgf_binary_triangle_read_vertex(&p, end, code & 7, vertex_fifo, &vertex_head, &next, &c))
+      {
+        return 0;
+      }
+
+      a = edge_a[slot];
+      b = edge_b[slot];
+
+      switch ((code >> 3) & 3)
+      {
+      case 0:
+        triangle[0] = a;
+        triangle[1] = b;
+        triangle[2] = c;
+        break;
+      case 1:
+        triangle[0] = c;
+        triangle[1] = a;
+        triangle[2] = b;
+        break;
+      default:
+        triangle[0] = b;
+        triangle[1] = c;
+        triangle[2] = a;
+        break;
+      }
+    }
+    else
+    {
+      unsigned long code_c;
+
+      if (p >= end || *p > RGF_BINARY_TRIANGLE_EXPLICIT)
+      {
+        return 0;
+      }
+
+      code_c = *p++;
+
+      if (!rgf_binary_triangle_read_vertex(&p, end, code >> 5, vertex_fifo, &vertex_head, &next, &a) ||
+          !rgf_binary_triangle_read_vertex(&p, end, code & 7, vertex_fifo, &vertex_head, &next, &b) ||
+          !rgf_binary_triangle_read_vertex(&p, end, code_c, vertex_fifo, &vertex_head, &next, &c))
+      {
+        return 0;
+      }
+
+      triangle[0] = a;
+      triangle[1] = b;
+      triangle[2] = c;
+    }
+
+    /* Reversed edges of the triangle as the neighbours see them */
+    edge_a[edge_head & 7] = triangle[1];
+    edge_b[edge_head & 7] = triangle[0];
+    edge_a[(edge_head + 1) & 7] = triangle[2];
+    edge_b[(edge_head + 1) & 7] = triangle[1];
+    edge_a[(edge_head + 2) & 7] = triangle[0];
+    edge_b[(edge_head + 2) & 7] = triangle[2];
+    edge_head += 3;
+  }
+
+  return p == end;
+}
+
+/* Block compression of a stored section (RGF_BINARY_COMPRESSION_LZ):
+
+     u32 decompressed bytes, u32 filter width (1, 2 or 4 bytes per element)
+     u32 per block: stored bytes, RGF_BINARY_BLOCK_STORED is set if the block was not compressed
+     the blocks, back to back
+
+   The encoded section is cut into RGF_BINARY_BLOCK_SIZE blocks (the last one is shorter)
+   that are filtered and compressed independently, so the blocks decode in parallel.
+   The filter splits a block into one plane per byte of an element, which brings the
+   sign/exponent bytes of floats and the high bytes of integers together, and stores
+   the difference to the previous byte in the plane. Width 1 is not filtered. Every
+   block then is a list of LZ sequences:
+
+     token       high nibble literal count, low nibble match length - 4 (15: continued)
+     [255 ...]   literal count continued, bytes are added until one is below 255
+     literals
+     u16 offset  distance back to the match, not present after the last literals
+     [255 ...]   match length continued
+*/
+#define RGF_BINARY_BLOCK_SIZE 16384
+#define RGF_BINARY_BLOCK_STORED 0x80000000UL
+#define RGF_BINARY_LZ_HASH_BITS 12
+#define RGF_BINARY_LZ_MIN_MATCH 4
+
+#ifndef RGF_BINARY_MAX_BLOCK_JOBS
+#define RGF_BINARY_MAX_BLOCK_JOBS 256
+#endif
+
+RGF_API RGF_INLINE unsigned long rgf_binary_block_count(unsigned long size)
+{
+  return size / RGF_BINARY_BLOCK_SIZE + (size % RGF_BINARY_BLOCK_SIZE != 0);
+}
+
+/* Bytes of the compressed stream header and block table */
+RGF_API RGF_INLINE unsigned long rgf_binary_block_table_size(unsigned long size)
+{
+  return 8 + rgf_binary_block_count(size) * 4;
+}
+
+/* Upper bound of the compressed bytes of size encoded bytes */
+RGF_API RGF_INLINE unsigned long rgf_binary_compressed_bound(unsigned long size)
+{
+  return rgf_binary_block_table_size(size) + size;
+}
+
+/* Bytes per element that the filter splits into planes */
+RGF_API RGF_INLINE unsigned long rgf_binary_filter_width(unsigned long encoding)
+{
+  switch (encoding)
+  {
+  case RGF_BINARY_ENCODING_RAW:
+    return 4;
+  case RGF_BINARY_ENCODING_TRIANGLE_FIFO:
+  case RGF_BINARY_ENCODING_INDEX8:
+    return 1;
+  default:
+    return 2;
+  }
+}
+
+RGF_API RGF_INLINE void rgf_binary_filter_block(unsigned char *out, unsigned char *in, unsigned long size, unsigned long width)
+{
+  unsigned long elements = size / width;
+  unsigned long plane;
+  unsigned long i;
+
+  for (plane = 0; plane < width; ++plane)
+  {
+    unsigned char previous = 0;
+
+    for (i = 0; i < elements; ++i)
+    {
+      unsigned char value = in[i * width + plane];
+
+      *out++ = (unsigned char)(value - previous);
+      previous = value;
+    }
+  }
+
+  for (i = elements * width; i < size; ++i)
+  {
+    *out++ = in[i];
+  }
+}
+
+RGF_API RGF_INLINE void rgf_binary_unfilter_block(unsigned char *out, unsigned char *in, unsigned long size, unsigned long width)
+{
+  unsigned long elements = size / width;
+  unsigned long plane;
+  unsigned long i;
+
+  for (plane = 0; plane < width; ++plane)
+  {
+    unsigned char value = 0;
+
+    for (i = 0; i < elements; ++i)
+    {
+      value = (unsigned char)(value + *in++);
+      out[i * width + plane] = value;
+    }
+  }
+
+  for (i = elements * width; i < size; ++i)
+  {
+    out[i] = *in++;
+  }
+}
+
+RGF_API RGF_INLINE unsigned long rgf_binary_lz_hash(unsigned char *p)
+{
+  unsigned long value = (unsigned long)p[0] | (unsigned long)p[1] << 8 | (unsigned long)p[2] << 16 | (unsigned long)p[3] << 24;
+
+  return ((value * 2654435761UL) & 0xFFFFFFFFUL) >> (32 - RGF_BINARY_LZ_HASH_BITS);
+}
+
+RGF_API RGF_INLINE unsigned long rgf_binary_lz_write_length(unsigned char *out, unsigned long length)
+{
+  unsigned long n = 0;
+
+  while (length >= 255)
+  {
+    out[n++] = 255;
+    length -= 255;
+  }
+
+  out[n++] = (unsigned char)length;
+
+  return n;
+}
+
+/* Appends literals and a match (match_length 0 for the last sequence) at out[*size],
+   returns 0 if the sequence does not fit into capacity
+*/
+RGF_API RGF_INLINE int rgf_binary_lz_write_sequence(
+    unsigned char *out,
+    unsigned long *size,
+    unsigned long capacity,
+    unsigned char *literals,
+    unsigned long literal_count,
+    unsigned long offset,
+    unsigned long match_length)
+{
+  unsigned long match_extra = match_length > 0 ? match_length - RGF_BINARY_LZ_MIN_MATCH : 0;
+  unsigned long n = *size;
+  unsigned char *token;
+
+  if (capacity - n < 1 + literal_count / 255 + 1 + literal_count + 2 + match_extra / 255 + 1)
+  {
+    return 0;
+  }
+
+  token = out + n++;
+  *token = (unsigned char)((literal_count < 15 ? literal_count : 15) << 4);
+
+  if (literal_count >= 15)
+  {
+    n += rgf_binary_lz_write_length(out + n, literal_count - 15);
+  }
+
+  rgf_binary_memcpy(out + n, literals, literal_count);
+  n += literal_count;
+
+  if (match_length > 0)
+  {
+    *token = (unsigned char)(*token | (match_extra < 15 ? match_extra : 15));
+
+    rgf_binary_write_u16(out + n, offset);
+    n += 2;
+
+    if (match_extra >= 15)
+    {
+      n += rgf_binary_lz_write_length(out + n, match_extra - 15);
+    }
+  }
+
+  *size = n;
+
+  return 1;
+}
+
+/* Compresses a block (at most RGF_BINARY_BLOCK_SIZE bytes) greedily with a hash table
+   of the last position of every 4 byte prefix. Returns the compressed bytes or 0 if
+   they do not fit into capacity.
+*/
+RGF_API RGF_INLINE unsigned long rgf_binary_lz_compress(unsigned char *out, unsigned long capacity, unsigned char *in, unsigned long size)
+{
+  unsigned short table[1 << RGF_BINARY_LZ_HASH_BITS];
+  unsigned long anchor = 0;
+  unsigned long n = 0;
+  unsigned long i = 0;
+
+  /* Positions are stored + 1, 0 is an empty slot */
+  for (i = 0; i < (1 << RGF_BINARY_LZ_HASH_BITS); ++i)
+  {
+    table[i] = 0;
+  }
+
+  i = 0;
+
+  while (i + RGF_BINARY_LZ_MIN_MATCH <= size)
+  {
+    unsigned long hash = rgf_binary_lz_hash(in + i);
+    unsigned long candidate = table[hash];
+    unsigned long length = 0;
+
+    table[hash] = (unsigned short)(i + 1);
+
+    if (candidate > 0)
+    {
+      unsigned char *match = in + candidate - 1;
+
+      while (i + length < size && match[length] == in[i + length])
+      {
+        ++length;
+      }
+    }
+
+    if (length < RGF_BINARY_LZ_MIN_MATCH)
+    {
+      ++i;
+      continue;
+    }
+
+    if (!rgf_binary_lz_write_sequence(out, &n, capacity, in + anchor, i - anchor, i - (candidate - 1), length))
+    {
+      return 0;
+    }
+
+    i += length;
+    anchor = i;
+  }
+
+  if (!rgf_binary_lz_write_sequence(out, &n, capacity, in + anchor, size - anchor, 0, 0))
+  {
+    return 0;
+  }
+
+  return n;
+}
+
+RGF_API RGF_INLINE int rgf_binary_lz_read_length(unsigned char **ptr, unsigned char *end, unsigned long *length)
+{
+  unsigned char *p = *ptr;
+  unsigned long byte;
+
+  do
+  {
+    if (p == end || *length > RGF_BINARY_BLOCK_SIZE)
+    {
+      return 0;
+    }
+
+    byte = *p++;
+    *length += byte;
+  } while (byte == 255);
+
+  *ptr = p;
+
+  return 1;
+}
+
+/* Decompresses a block into exactly size bytes, returns 0 for corrupt data */
+RGF_API RGF_INLINE int rgf_binary_lz_decompress(unsigned char *out, unsigned long size, unsigned char *in, unsigned long in_size)
+{
+  unsigned char *p = in;
+  unsigned char *end = in + in_size;
+  unsigned long n = 0;
+
+  while (p < end)
+  {
+    unsigned long token = *p++;
+    unsigned long literal_count = token >> 4;
+    unsigned long length = (token & 15) + RGF_BINARY_LZ_MIN_MATCH;
+    unsigned long offset;
+    unsigned long i;
+
+    if (literal_count == 15 && !rgf_binary_lz_read_length(&p, end, &literal_count))
+    {
+      return 0;
+    }
+
+    if (literal_count > (unsigned long)(end - p) || literal_count > size - n)
+    {
+      return 0;
+    }
+
+    rgf_binary_memcpy(out + n, p, literal_count);
+    p += literal_count;
+    n += literal_count;
+
+    if (p == end)
+    {
+      /* last sequence */
+      break;
+    }
+
+    if (end - p < 2)
+    {
+      return 0;
+    }
+
+    offset = (unsigned long)p[0] | (unsigned long)p[1] << 8;
+    p += 2;
+
+    if ((token & 15) == 15 && !rgf_binary_lz_read_length(&p, end, &length))
+    {
+      return 0;
+    }
+
+    if (offset == 0 || offset > n || length > size - n)
+    {
+      return 0;
+    }
+
+    /* Byte by byte, the match can overlap the bytes it writes */
+    for (i = 0; i < length; ++i)
+    {
+      out[n + i] = out[n + i - offset];
+    }
+
+    n += length;
+  }
+
+  return n == size;
+}
+
+/* Compresses size encoded bytes with elements of width bytes (see rgf_binary_filter_width)
+   into out, which needs rgf_binary_compressed_bound(size) bytes. Every block is stored
+   compressed only if that is smaller. in may also lie inside out, at least
+   rgf_binary_block_table_size(size) bytes after it: no block ever grows, so the
+   compressed bytes never overtake the bytes still to be read.
+*/
+RGF_API RGF_INLINE void rgf_binary_compress(
+    unsigned char *out,
+    unsigned long *out_size,
+    unsigned char *in,
+    unsigned long size,
+    unsigned long width)
+{
+  unsigned char filtered[RGF_BINARY_BLOCK_SIZE];
+  unsigned long block_count = rgf_binary_block_count(size);
+  unsigned long n = rgf_binary_block_table_size(size);
+  unsigned long block;
+
+  rgf_binary_write_u32(out, size);
+  rgf_binary_write_u32(out + 4, width);
+
+  for (block = 0; block < block_count; ++block)
+  {
+    unsigned long begin = block * RGF_BINARY_BLOCK_SIZE;
+    unsigned long block_size = size - begin < RGF_BINARY_BLOCK_SIZE ? size - begin : RGF_BINARY_BLOCK_SIZE;
+    unsigned long stored;
+
+    if (width > 1)
+    {
+      rgf_binary_filter_block(filtered, in + begin, block_size, width);
+    }
+    else
+    {
+      rgf_binary_memcpy(filtered, in + begin, block_size);
+    }
+
+    /* Compression has to save at least one byte */
+    stored = rgf_binary_lz_compress(out + n, block_size - 1, filtered, block_size);
+
+    if (stored == 0)
+    {
+      rgf_binary_memcpy(out + n, filtered, block_size);
+      rgf_binary_write_u32(out + 8 + block * 4, block_size | RGF_BINARY_BLOCK_STORED);
+      n += block_size;
+    }
+    else
+    {
+      rgf_binary_write_u32(out + 8 + block * 4, stored);
+      n += stored;
+    }
+  }
+
+  *out_size = n;
+}
+
+/* Bytes of the section after decompression, 0 for an invalid compressed stream */
+RGF_API RGF_INLINE int rgf_binary_decompressed_size(rgf_binary_section *section, unsigned char *data, unsigned long *size)
+{
+  unsigned long width;
+
+  if (section->compression != RGF_BINARY_COMPRESSION_LZ || section->size < 8)
+  {
+    return 0;
+  }
+
+  *size = rgf_binary_read_ul(data);
+  width = rgf_binary_read_ul(data + 4);
+
+  if (width != 1 && width != 2 && width != 4)
+  {
+    return 0;
+  }
+
+  return rgf_binary_block_count(*size) <= (section->size - 8) / 4;
+}
+
+typedef struct rgf_binary_block_range
+{
+  unsigned long begin;  /* First block                          */
+  unsigned long end;    /* One after the last block             */
+  unsigned long offset; /* Offset of the first block in the data */
+  int result;
+
+} rgf_binary_block_range;
+
+typedef struct rgf_binary_decompression
+{
+  unsigned char *data; /* Start of the compressed stream */
+  unsigned char *out;
+  unsigned long size; /* Decompressed bytes */
+  unsigned long width;
+  rgf_binary_block_range *ranges;
+
+} rgf_binary_decompression;
+
+RGF_API void rgf_binary_decompress_job(void *job_data, unsigned long job_index)
+{
+  rgf_binary_decompression *decompression = (rgf_binary_decompression *)job_data;
+  rgf_binary_block_range *range = &decompression->ranges[job_index];
+  unsigned char filtered[RGF_BINARY_BLOCK_SIZE];
+  unsigned char *stored = decompression->data + rgf_binary_block_table_size(decompression->size) + range->offset;
+  unsigned long block;
+
+  range->result = 1;
+
+  for (block = range->begin; block < range->end; ++block)
+  {
+    unsigned long begin = block * RGF_BINARY_BLOCK_SIZE;
+    unsigned long block_size = decompression->size - begin < RGF_BINARY_BLOCK_SIZE ? decompression->size - begin : RGF_BINARY_BLOCK_SIZE;
+    unsigned long entry = rgf_binary_read_ul(decompression->data + 8 + block * 4);
+    unsigned long stored_size = entry & ~RGF_BINARY_BLOCK_STORED;
+    unsigned char *out = decompression->width > 1 ? filtered : decompression->out + begin;
+
+    if (entry & RGF_BINARY_BLOCK_STORED)
+    {
+      rgf_binary_memcpy(out, stored, block_size);
+    }
+    else if (!rgf_binary_lz_decompress(out, block_size, stored, stored_size))
+    {
+      /* corrupt block */
+      range->result = 0;
+      return;
+    }
+
+    if (decompression->width > 1)
+    {
+      rgf_binary_unfilter_block(decompression->out + begin, filtered, block_size, decompression->width);
+    }
+
+    stored += stored_size;
+  }
+}
+
+/* Decompresses a RGF_BINARY_COMPRESSION_LZ section from data (its section->size stored
+   bytes) into out, which needs rgf_binary_decompressed_size bytes. The blocks are split
+   into ranges that are decompressed in parallel through the job system. decompressed
+   gets the section as if it was stored uncompressed in out, for rgf_binary_decode_section
+   or rgf_binary_decode_section_to. Its checksum stays the one of the compressed bytes.
+*/
+RGF_API RGF_INLINE int rgf_binary_decompress_section_parallel(
+    rgf_binary_section *section,      /* Compressed section                          */
+    unsigned char *data,              /* Stored bytes of the section                 */
+    unsigned char *out,               /* Output for the decompressed bytes           */
+    unsigned long out_capacity,       /* Capacity of out                             */
+    rgf_binary_section *decompressed, /* The section as stored in out                */
+    rgf_job_system *jobs              /* Job dispatcher, 0 decompresses serially     */
+)
+{
+  rgf_binary_block_range ranges[RGF_BINARY_MAX_BLOCK_JOBS];
+  rgf_binary_decompression decompression;
+  unsigned long block_count;
+  unsigned long range_count;
+  unsigned long offset = 0;
+  unsigned long block;
+  unsigned long i;
+
+  if (!rgf_binary_decompressed_size(section, data, &decompression.size) || decompression.size > out_capacity)
+  {
+    return 0;
+  }
+
+  decompression.data = data;
+  decompression.out = out;
+  decompression.width = rgf_binary_read_ul(data + 4);
+  decompression.ranges = ranges;
+
+  block_count = rgf_binary_block_count(decompression.size);
+  range_count = rgf_job_thread_count(jobs);
+
+  if (range_count > block_count)
+  {
+    range_count = block_count;
+  }
+
+  if (range_count > RGF_BINARY_MAX_BLOCK_JOBS)
+  {
+    range_count = RGF_BINARY_MAX_BLOCK_JOBS;
+  }
+
+  /* Validate the block table and find the offset of the first block of every range */
+  for (i = 0, block = 0; block < block_count; ++block)
+  {
+    unsigned long entry = rgf_binary_read_ul(data + 8 + block * 4);
+    unsigned long stored_size = entry & ~RGF_BINARY_BLOCK_STORED;
+    unsigned long block_size = decompression.size - block * RGF_BINARY_BLOCK_SIZE;
+
+    if (block_size > RGF_BINARY_BLOCK_SIZE)
+    {
+      block_size = RGF_BINARY_BLOCK_SIZE;
+    }
+
+    if (i < range_count && block == block_count * i / range_count)
+    {
+      ranges[i].begin = block;
+      ranges[i].end = block_count * (i + 1) / range_count;
+      ranges[i].offset = offset;
+      ++i;
+    }
+
+    if (((entry & RGF_BINARY_BLOCK_STORED) ? stored_size != block_size : stored_size >= block_size) || stored_size > section->size - offset)
+    {
+      /* corrupt block table */
+      return 0;
+    }
+
+    offset += stored_size;
+  }
+
+  if (offset != section->size - rgf_binary_block_table_size(decompression.size))
+  {
+    /* blocks do not fill the section */
+    return 0;
+  }
+
+  rgf_job_run(jobs, rgf_binary_decompress_job, &decompression, range_count);
+
+  for (i = 0; i < range_count; ++i)
+  {
+    if (!ranges[i].result)
+    {
+      return 0;
+    }
+  }
+
+  *decompressed = *section;
+  decompressed->compression = RGF_BINARY_COMPRESSION_NONE;
+  decompressed->size = decompression.size;
+
+  return 1;
+}
+
+RGF_API RGF_INLINE int rgf_binary_decompress_section(
+    rgf_binary_section *section,
+    unsigned char *data,
+    unsigned char *out,
+    unsigned long out_capacity,
+    rgf_binary_section *decompressed)
+{
+  return rgf_binary_decompress_section_parallel(section, data, out, out_capacity, decompressed, 0);
+}
+
+/* Stored bytes of count elements of a section type in an encoding (the upper bound for
+   TRIANGLE_FIFO). Returns 0 if the section can not be stored in that encoding.
+*/
+RGF_API RGF_INLINE int rgf_binary_encoded_size(unsigned long type, unsigned long encoding, unsigned long count, unsigned long *size)
+{
+  int is_direction = type == RGF_BINARY_SECTION_NORMALS || type == RGF_BINARY_SECTION_TANGENTS || type == RGF_BINARY_SECTION_BITANGENTS;
+
+  if (type >= RGF_BINARY_SECTION_COUNT || count > (unsigned long)-1 / (unsigned long)sizeof(rgf_submesh))
+  {
+    return 0;
+  }
+
+  switch (encoding)
+  {
+  case RGF_BINARY_ENCODING_RAW:
+    /* The size of interleaved vertices depends on their layout */
+    *size = count * rgf_binary_element_size((int)type);
+    return type != RGF_BINARY_SECTION_INTERLEAVED;
+  case RGF_BINARY_ENCODING_UNORM16:
+    *size = count * 2;
+    return type == RGF_BINARY_SECTION_VERTICES && count % 3 == 0;
+  case RGF_BINARY_ENCODING_OCTAHEDRAL:
+    *size = count / 3 * 4;
+    return is_direction && count % 3 == 0;
+  case RGF_BINARY_ENCODING_HALF:
+    *size = count * 2;
+    return type < RGF_BINARY_SECTION_INDICES;
+  case RGF_BINARY_ENCODING_TRIANGLE_FIFO:
+    *size = rgf_binary_triangles_bound(count);
+    return type == RGF_BINARY_SECTION_INDICES && count % 3 == 0;
+  case RGF_BINARY_ENCODING_INDEX16:
+    *size = count * 2;
+    return type == RGF_BINARY_SECTION_INDICES;
+  case RGF_BINARY_ENCODING_INDEX8:
+    *size = count;
+    return type == RGF_BINARY_SECTION_INDICES;
+  default:
+    return 0;
+  }
+}
+
+/* The narrowest encoding that holds every index of the model (INDEX8, INDEX16 or RAW) */
+RGF_API RGF_INLINE unsigned long rgf_binary_index_encoding(rgf_model *model)
+{
+  switch (rgf_index_width_for(rgf_model_index_max(model)))
+  {
+  case 1:
+    return RGF_BINARY_ENCODING_INDEX8;
+  case 2:
+    return RGF_BINARY_ENCODING_INDEX16;
+  default:
+    return RGF_BINARY_ENCODING_RAW;
+  }
+}
+
+/* The encoding of the indices at the model index width, the default of the encoders:
+   RAW for int indices, narrowed ones only after rgf_model_narrow_indices */
+RGF_API RGF_INLINE unsigned long rgf_binary_model_index_encoding(rgf_model *model)
+{
+  switch (rgf_model_index_width(model))
+  {
+  case 1:
+    return RGF_BINARY_ENCODING_INDEX8;
+  case 2:
+    return RGF_BINARY_ENCODING_INDEX16;
+  default:
+    return RGF_BINARY_ENCODING_RAW;
+  }
+}
+
+RGF_API RGF_INLINE void rgf_binary_write_layout(unsigned char *out, rgf_vertex_layout *layout)
+{
+  int attribute;
+
+  rgf_binary_write_u32(out, layout->attributes);
+  rgf_binary_write_u32(out + 4, layout->stride);
+
+  for (attribute = 0; attribute < RGF_VERTEX_ATTRIBUTES; ++attribute)
+  {
+    rgf_binary_write_u32(out + 8 + (unsigned long)attribute * 4, layout->offsets[attribute]);
+  }
+
+  rgf_binary_write_u32(out + 28, 0);
+}
+
+/* Writes the version 2 header for entries directory entries, which follow it */
+RGF_API RGF_INLINE void rgf_binary_write_header(unsigned char *out_binary, rgf_model *model, unsigned long entries)
+{
+  float *fields[14];
+  unsigned long i;
+
+  for (i = 0; i < RGF_BINARY_SIZE_HEADER_V2 + entries * RGF_BINARY_SIZE_DIRECTORY_ENTRY; ++i)
+  {
+    out_binary[i] = 0;
+  }
+
+  /* 4 byte magic */
+  out_binary[0] = 'R';
+  out_binary[1] = 'G';
+  out_binary[2] = 'F';
+  out_binary[3] = '\0';
+
+  /* 1 byte version + 3 byte padding */
+  out_binary[4] = RGF_BINARY_VERSION;
+
+  rgf_binary_write_u32(out_binary + 8, model->flags & ~RGF_MODEL_FLAGS_RUNTIME);
+  rgf_binary_write_u32(out_binary + 12, entries);
+
+  rgf_binary_geometry_fields(model, fields);
+
+  for (i = 0; i < 14; ++i)
+  {
+    rgf_binary_write_u32(out_binary + 16 + i * 4, rgf_binary_float_bits(*fields[i]));
+  }
+}
+
+RGF_API RGF_INLINE void rgf_binary_write_entry(unsigned char *entry, rgf_binary_section *section)
+{
+  rgf_binary_write_u32(entry, section->type);
+  rgf_binary_write_u32(entry + 4, section->encoding);
+  rgf_binary_write_u64(entry + 8, section->offset);
+  rgf_binary_write_u64(entry + 16, section->size);
+  rgf_binary_write_u64(entry + 24, section->count);
+  rgf_binary_write_u32(entry + 32, section->checksum);
+  rgf_binary_write_u32(entry + 36, section->compression);
+}
+
+/* Quantizes count floats of a section into one of the fixed size float encodings */
+RGF_API RGF_INLINE int rgf_binary_quantize(unsigned char *out, float *in, unsigned long count, unsigned long encoding, rgf_model *model)
+{
+  switch (encoding)
+  {
+  case RGF_BINARY_ENCODING_UNORM16:
+    return rgf_binary_quantize_unorm16(out, in, count, model);
+  case RGF_BINARY_ENCODING_OCTAHEDRAL:
+    rgf_binary_quantize_octahedral(out, in, count);
+    return 1;
+  default:
+    rgf_binary_quantize_half(out, in, count);
+    return 1;
+  }
+}
+
+/* How every section of a model is stored, see rgf_binary_plan_sections */
+typedef struct rgf_binary_plan
+{
+  rgf_model *model;
+  rgf_vertex_layout *layout;
+  void *data[RGF_BINARY_SECTION_COUNT];
+  unsigned long counts[RGF_BINARY_SECTION_COUNT];       /* Elements, 0 for no section             */
+  unsigned long bounds[RGF_BINARY_SECTION_COUNT];       /* Encoded bytes (at most for FIFO)       */
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT];    /* RGF_BINARY_ENCODING_*                  */
+  unsigned long compressions[RGF_BINARY_SECTION_COUNT]; /* RGF_BINARY_COMPRESSION_*               */
+  unsigned long entries;                                /* Sections with a directory entry        */
+
+} rgf_binary_plan;
+
+/* Validates the encodings of the sections of a model and their encoded sizes, the
+   parameters are the ones of rgf_binary_encode_sections
+*/
+RGF_API RGF_INLINE int rgf_binary_plan_sections(
+    rgf_binary_plan *plan,
+    rgf_model *model,
+    unsigned long *encodings,
+    unsigned long *compressions,
+    rgf_vertex_layout *layout)
+{
+  int order[RGF_VERTEX_ATTRIBUTES];
+  unsigned long order_size;
+  int section;
+
+  /* The sections are the in memory arrays, the format is little endian */
+  if (!rgf_binary_is_little_endian())
+  {
+    return 0;
+  }
+
+  plan->model = model;
+  plan->layout = layout;
+  plan->entries = 0;
+
+  rgf_model_apply_transform(model);
+
+  rgf_binary_sections(model, plan->data, plan->counts);
+
+  /* The interleaved attributes replace their own sections */
+  if (layout)
+  {
+    if (!rgf_vertex_layout_order(layout, order, &order_size))
+    {
+      /* invalid layout */
+      return 0;
+    }
+
+    for (section = 0; section < RGF_VERTEX_ATTRIBUTES; ++section)
+    {
+      unsigned long *size;
+
+      if (!(layout->attributes & RGF_VERTEX_BIT(section)))
+      {
+        continue;
+      }
+
+      if (!*rgf_vertex_attribute(model, section, &size) || *size != model->vertices_size / 3 * rgf_vertex_components(section))
+      {
+        /* missing attribute */
+        return 0;
+      }
+
+      plan->counts[RGF_BINARY_SECTION_INTERLEAVED] += *size;
+      plan->counts[section] = 0;
+    }
+  }
+
+  for (section = 0; section < RGF_BINARY_SECTION_COUNT; ++section)
+  {
+    unsigned long count = plan->counts[section];
+
+    plan->encodings[section] = encodings ? encodings[section] : RGF_BINARY_ENCODING_RAW;
+    plan->compressions[section] = compressions ? compressions[section] : RGF_BINARY_COMPRESSION_NONE;
+    plan->bounds[section] = 0;
+
+    if (plan->compressions[section] > RGF_BINARY_COMPRESSION_LZ)
+    {
+      /* unknown compression */
+      return 0;
+    }
+
+    /* Only sections with data get a directory entry */
+    if (count == 0)
+    {
+      continue;
+    }
+
+    ++plan->entries;
+
+    if (!encodings && section == RGF_BINARY_SECTION_INDICES)
+    {
+      plan->encodings[section] = rgf_binary_model_index_encoding(model);
+    }
+
+    if (section == RGF_BINARY_SECTION_INTERLEAVED)
+    {
+      if (plan->encodings[section] != RGF_BINARY_ENCODING_RAW || model->vertices_size / 3 > ((unsigned long)-1 - RGF_BINARY_SIZE_LAYOUT) / layout->stride)
+      {
+        return 0;
+      }
+
+      plan->bounds[section] = RGF_BINARY_SIZE_LAYOUT + model->vertices_size / 3 * layout->stride;
+    }
+    else if (!rgf_binary_encoded_size((unsigned long)section, plan->encodings[section], count, &plan->bounds[section]))
+    {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/* Items of a section that are encoded independently: vertices of interleaved sections,
+   else elements. The items of a TRIANGLE_FIFO section are only encoded all at once.
+*/
+RGF_API RGF_INLINE unsigned long rgf_binary_plan_items(rgf_binary_plan *plan, int section)
+{
+  return section == RGF_BINARY_SECTION_INTERLEAVED ? plan->model->vertices_size / 3 : plan->counts[section];
+}
+
+/* Sections with a stored size that is only known after encoding */
+RGF_API RGF_INLINE int rgf_binary_plan_is_variable(rgf_binary_plan *plan, int section)
+{
+  return plan->encodings[section] == RGF_BINARY_ENCODING_TRIANGLE_FIFO || plan->compressions[section] != RGF_BINARY_COMPRESSION_NONE;
+}
+
+/* Encodes the items [first, first + count) of a section of a fixed stored size (no
+   TRIANGLE_FIFO) into out, the start of the section
+*/
+RGF_API RGF_INLINE int rgf_binary_write_range(rgf_binary_plan *plan, int section, unsigned char *out, unsigned long first, unsigned long count)
+{
+  unsigned long encoding = plan->encodings[section];
+  unsigned long offset = 0;
+  unsigned long size = 0;
+
+  if (section == RGF_BINARY_SECTION_INTERLEAVED)
+  {
+    rgf_model *model = plan->model;
+    rgf_model view = *model;
+
+    if (first == 0)
+    {
+      rgf_binary_write_layout(out, plan->layout);
+    }
+
+    /* The same arrays starting at the first vertex */
+    view.vertices = model->vertices ? model->vertices + first * 3 : 0;
+    view.normals = model->normals ? model->normals + first * 3 : 0;
+    view.tangents = model->tangents ? model->tangents + first * 3 : 0;
+    view.bitangents = model->bitangents ? model->bitangents + first * 3 : 0;
+    view.uvs = model->uvs ? model->uvs + first * 2 : 0;
+    view.vertices_size = count * 3;
+    view.normals_size = count * 3;
+    view.tangents_size = count * 3;
+    view.bitangents_size = count * 3;
+    view.uvs_size = count * 2;
+
+    out += RGF_BINARY_SIZE_LAYOUT + first * plan->layout->stride;
+
+    if (!rgf_model_interleave(&view, plan->layout, out))
+    {
+      return 0;
+    }
+
+    /* Stored padding is zero, so equal models give equal files */
+    rgf_vertex_zero_padding(plan->layout, out, count);
+
+    return 1;
+  }
+
+  rgf_binary_encoded_size((unsigned long)section, encoding, first, &offset);
+  rgf_binary_encoded_size((unsigned long)section, encoding, count, &size);
+
+  if (section == RGF_BINARY_SECTION_INDICES)
+  {
+    unsigned long width = rgf_model_index_width(plan->model);
+
+    /* index does not fit into the width of the encoding */
+    return rgf_index_convert(out + offset, rgf_binary_encoding_index_width(encoding), (unsigned char *)plan->data[section] + first * width, width, count);
+  }
+
+  if (encoding == RGF_BINARY_ENCODING_RAW)
+  {
+    rgf_binary_memcpy(out + offset, (unsigned char *)plan->data[section] + offset, size);
+    return 1;
+  }
+
+  /* vertex outside of the bounds */
+  return rgf_binary_quantize(out + offset, (float *)plan->data[section] + first, count, encoding, plan->model);
+}
+
+/* The model array of a section that is stored as an exact copy of it (raw, not
+   interleaved, int indices), otherwise 0
+*/
+RGF_API RGF_INLINE unsigned char *rgf_binary_plan_raw_data(rgf_binary_plan *plan, int section)
+{
+  if (plan->encodings[section] != RGF_BINARY_ENCODING_RAW || section == RGF_BINARY_SECTION_INTERLEAVED ||
+      (section == RGF_BINARY_SECTION_INDICES && rgf_model_index_width(plan->model) != 4))
+  {
+    return 0;
+  }
+
+  return (unsigned char *)plan->data[section];
+}
+
+/* Checksum of the stored bytes of a section. Uncompressed raw copies are hashed from the
+   model array, large copies bypass the cache (see rgf_binary_memcpy) and reading them
+   back would come from memory.
+*/
+RGF_API RGF_INLINE unsigned long rgf_binary_plan_checksum(rgf_binary_plan *plan, int section, unsigned char *stored, unsigned long size)
+{
+  unsigned char *raw = plan->compressions[section] == RGF_BINARY_COMPRESSION_NONE ? rgf_binary_plan_raw_data(plan, section) : 0;
+
+  return rgf_hash_fnv1a(raw ? raw : stored, size);
+}
+
+/* Encodes and compresses a section into out, which needs room for its block table and
+   its bound, size gets the stored bytes
+*/
+RGF_API RGF_INLINE int rgf_binary_write_section(rgf_binary_plan *plan, int section, unsigned char *out, unsigned long *size)
+{
+  unsigned long table_size = 0;
+  unsigned char *encoded;
+
+  *size = plan->bounds[section];
+
+  /* Compressed sections are encoded behind the room for their block table */
+  if (plan->compressions[section] != RGF_BINARY_COMPRESSION_NONE)
+  {
+    table_size = rgf_binary_block_table_size(plan->bounds[section]);
+  }
+
+  encoded = out + table_size;
+
+  if (plan->encodings[section] == RGF_BINARY_ENCODING_TRIANGLE_FIFO)
+  {
+    if (!rgf_binary_encode_triangles_width(encoded, plan->data[section], rgf_model_index_width(plan->model), plan->counts[section], size))
+    {
+      /* negative index */
+      return 0;
+    }
+  }
+  else if (table_size > 0 && rgf_binary_plan_raw_data(plan, section))
+  {
+    /* Raw sections are compressed straight from the model */
+    encoded = rgf_binary_plan_raw_data(plan, section);
+  }
+  else if (!rgf_binary_write_range(plan, section, encoded, 0, rgf_binary_plan_items(plan, section)))
+  {
+    return 0;
+  }
+
+  if (table_size > 0)
+  {
+    rgf_binary_compress(out, size, encoded, *size, rgf_binary_filter_width(plan->encodings[section]));
+  }
+
+  return 1;
+}
+
+/* Encodes the model with an RGF_BINARY_ENCODING_* per section (RGF_BINARY_SECTION_COUNT
+   entries, 0 for raw sections with the indices at the model index width, see
+   rgf_binary_model_index_encoding; RAW indices are stored as int at any model index
+   width, rgf_binary_index_encoding gives the narrowest encoding). Quantized vertices need
+   bounds that contain every vertex, see rgf_model_calculate_boundaries, otherwise 0 is
+   returned. A TRIANGLE_FIFO section needs room for rgf_binary_triangles_bound bytes while
+   it is written. compressions has an RGF_BINARY_COMPRESSION_* per section (0 for none),
+   a compressed section needs room for rgf_binary_compressed_bound of its encoded size
+   while it is written. With a layout its attributes are stored as one raw INTERLEAVED
+   section (of every vertex, so all of them need vertices_size / 3 vertices) instead of
+   their own sections, which needs a 4 byte aligned out_binary.
+*/
+RGF_API RGF_INLINE int rgf_binary_encode_sections(
+    unsigned char *out_binary,         /* Output buffer for executable        */
+    unsigned long out_binary_capacity, /* Capacity of output buffer           */
+    unsigned long *out_binary_size,    /* Actual size of output binary buffer */
+    rgf_model *model,                  /* The rgf data                        */
+    unsigned long *encodings,          /* Encoding of every section or 0      */
+    unsigned long *compressions,       /* Compression of every section or 0   */
+    rgf_vertex_layout *layout          /* Interleaved vertex attributes or 0  */
+)
+{
+  rgf_binary_plan plan;
+  rgf_binary_section stored;
+  unsigned char *entry;
+  unsigned long size_total;
+  unsigned long i;
+  int section;
+
+  if (!rgf_binary_plan_sections(&plan, model, encodings, compressions, layout))
+  {
+    return 0;
+  }
+
+  size_total = RGF_BINARY_SIZE_HEADER_V2 + plan.entries * RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+
+  if (out_binary_capacity < size_total)
+  {
+    /* Binary buffer size cannot fit the rgf data */
+    return 0;
+  }
+
+  /* The padding between the sections is zeroed as they are written */
+  rgf_binary_write_header(out_binary, model, plan.entries);
+
+  entry = out_binary + RGF_BINARY_SIZE_HEADER_V2;
+
+  /* Every section starts aligned, the next offset is known once a section is written */
+  for (section = 0; section < RGF_BINARY_SECTION_COUNT; ++section)
+  {
+    unsigned long offset = rgf_binary_align(size_total);
+    unsigned long table_size = 0;
+
+    if (plan.counts[section] == 0)
+    {
+      continue;
+    }
+
+    if (plan.compressions[section] != RGF_BINARY_COMPRESSION_NONE)
+    {
+      table_size = rgf_binary_block_table_size(plan.bounds[section]);
+    }
+
+    if (offset > out_binary_capacity || table_size > out_binary_capacity - offset || plan.bounds[section] > out_binary_capacity - offset - table_size)
+    {
+      /* Binary buffer size cannot fit the rgf data */
+      return 0;
+    }
+
+    for (i = size_total; i < offset; ++i)
+    {
+      out_binary[i] = 0;
+    }
+
+    stored.type = (unsigned long)section;
+    stored.encoding = plan.encodings[section];
+    stored.compression = plan.compressions[section];
+    stored.offset = offset;
+    stored.count = plan.counts[section];
+
+    if (!rgf_binary_write_section(&plan, section, out_binary + offset, &stored.size))
+    {
+      return 0;
+    }
+
+    stored.checksum = rgf_binary_plan_checksum(&plan, section, out_binary + offset, stored.size);
+
+    rgf_binary_write_entry(entry, &stored);
+
+    entry += RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+    size_total = offset + stored.size;
+  }
+
+  *out_binary_size = size_total;
+
+  return 1;
+}
+
+RGF_API RGF_INLINE int rgf_binary_encode(
+    unsigned char *out_binary,         /* Output buffer for executable        */
+    unsigned long out_binary_capacity, /* Capacity of output buffer           */
+    unsigned long *out_binary_size,    /* Actual size of output binary buffer */
+    rgf_model *model                   /* The rgf data                        */
+)
+{
+  return rgf_binary_encode_sections(out_binary, out_binary_capacity, out_binary_size, model, 0, 0, 0);
+}
+
+/* Items per chunk job below which a section is not split further */
+#ifndef RGF_BINARY_CHUNK_ITEMS
+#define RGF_BINARY_CHUNK_ITEMS 16384
+#endif
+
+#ifndef RGF_BINARY_MAX_SECTION_JOBS
+#define RGF_BINARY_MAX_SECTION_JOBS 32
+#endif
+
+/* A range of items of one section that is encoded or decoded by one job */
+typedef struct rgf_binary_chunk
+{
+  int section;
+  unsigned long first;
+  unsigned long count;
+  int result;
+
+} rgf_binary_chunk;
+
+/* Appends the chunks of the items of a section to chunks, returns their number. Chunks
+   start at multiples of 48 items: whole vertices of every quantized encoding, expanded
+   in the same SIMD steps (and the same results) as the whole section.
+*/
+RGF_API RGF_INLINE unsigned long rgf_binary_split_section(rgf_binary_chunk *chunks, int section, unsigned long items, unsigned long threads)
+{
+  unsigned long chunk_count = (items + RGF_BINARY_CHUNK_ITEMS - 1) / RGF_BINARY_CHUNK_ITEMS;
+  unsigned long size = 0;
+  unsigned long i;
+
+  if (chunk_count > threads * 4)
+  {
+    chunk_count = threads * 4;
+  }
+
+  if (chunk_count > RGF_BINARY_MAX_SECTION_JOBS)
+  {
+    chunk_count = RGF_BINARY_MAX_SECTION_JOBS;
+  }
+
+  for (i = 0; i < chunk_count; ++i)
+  {
+    unsigned long first = items / chunk_count * i / 48 * 48;
+    unsigned long end = i + 1 == chunk_count ? items : items / chunk_count * (i + 1) / 48 * 48;
+
+    if (end > first)
+    {
+      chunks[size].section = section;
+      chunks[size].first = first;
+      chunks[size].count = end - first;
+      ++size;
+    }
+  }
+
+  return size;
+}
+
+/* Copies size bytes to a lower, possibly overlapping address */
+RGF_API RGF_INLINE void rgf_binary_move_down(unsigned char *dest, unsigned char *src, unsigned long size)
+{
+  unsigned long distance = (unsigned long)(src - dest);
+  unsigned long done;
+
+  if (distance == 0)
+  {
+    return;
+  }
+
+  /* Pieces of at most distance bytes do not overlap */
+  for (done = 0; done < size; done += distance)
+  {
+    rgf_binary_memcpy(dest + done, src + done, size - done < distance ? size - done : distance);
+  }
+}
+
+typedef struct rgf_binary_parallel_encoding
+{
+  rgf_binary_plan *plan;
+  rgf_binary_section *stored; /* Entry of every section type, the offset is the one while encoding */
+  rgf_binary_chunk *chunks;
+  unsigned char *out;
+
+} rgf_binary_parallel_encoding;
+
+/* Encodes a chunk of a section with a fixed stored size, or a whole variable section with its checksum */
+RGF_API void rgf_binary_encode_chunk_job(void *job_data, unsigned long job_index)
+{
+  rgf_binary_parallel_encoding *encoding = (rgf_binary_parallel_encoding *)job_data;
+  rgf_binary_chunk *chunk = &encoding->chunks[job_index];
+  rgf_binary_section *stored = &encoding->stored[chunk->section];
+  unsigned char *out = encoding->out + stored->offset;
+
+  if (!rgf_binary_plan_is_variable(encoding->plan, chunk->section))
+  {
+    chunk->result = rgf_binary_write_range(encoding->plan, chunk->section, out, chunk->first, chunk->count);
+    return;
+  }
+
+  chunk->result = rgf_binary_write_section(encoding->plan, chunk->section, out, &stored->size);
+
+  if (chunk->result)
+  {
+    stored->checksum = rgf_hash_fnv1a(out, stored->size);
+  }
+}
+
+/* Checksum of a section with a fixed stored size once all its chunks are written */
+RGF_API void rgf_binary_checksum_job(void *job_data, unsigned long job_index)
+{
+  rgf_binary_parallel_encoding *encoding = (rgf_binary_parallel_encoding *)job_data;
+  int section = encoding->chunks[job_index].section;
+  rgf_binary_section *stored = &encoding->stored[section];
+
+  stored->checksum = rgf_binary_plan_checksum(encoding->plan, section, encoding->out + stored->offset, stored->size);
+}
+
+/* Same binary as rgf_binary_encode_sections, encoded through the job system. All section
+   offsets are computed up front from the encoded sizes, so the sections and the chunks
+   of every section are encoded concurrently. TRIANGLE_FIFO and compressed sections are
+   encoded as a whole by one job each into a region of their bound (and block table) and
+   moved down behind the previous section once all jobs are done. So out_binary_capacity
+   has to hold every section at its bound at once, the binary ends up the same size.
+*/
+RGF_API RGF_INLINE int rgf_binary_encode_sections_parallel(
+    unsigned char *out_binary,         /* Output buffer for executable             */
+    unsigned long out_binary_capacity, /* Capacity of output buffer                */
+    unsigned long *out_binary_size,    /* Actual size of output binary buffer      */
+    rgf_model *model,                  /* The rgf data                             */
+    unsigned long *encodings,          /* Encoding of every section or 0           */
+    unsigned long *compressions,       /* Compression of every section or 0        */
+    rgf_vertex_layout *layout,         /* Interleaved vertex attributes or 0       */
+    rgf_job_system *jobs               /* Job dispatcher, 0 encodes serially       */
+)
+{
+  rgf_binary_chunk chunks[RGF_BINARY_SECTION_COUNT * RGF_BINARY_MAX_SECTION_JOBS];
+  rgf_binary_chunk fixed[RGF_BINARY_SECTION_COUNT];
+  rgf_binary_section stored[RGF_BINARY_SECTION_COUNT];
+  rgf_binary_parallel_encoding encoding;
+  rgf_binary_plan plan;
+  unsigned long threads = rgf_job_thread_count(jobs);
+  unsigned long chunk_count = 0;
+  unsigned long fixed_count = 0;
+  unsigned long size_total;
+  unsigned long end;
+  unsigned long i;
+  unsigned char *entry;
+  int section;
+
+  if (!rgf_binary_plan_sections(&plan, model, encodings, compressions, layout))
+  {
+    return 0;
+  }
+
+  size_total = RGF_BINARY_SIZE_HEADER_V2 + plan.entries * RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+
+  if (out_binary_capacity < size_total)
+  {
+    /* Binary buffer size cannot fit the rgf data */
+    return 0;
+  }
+
+  /* Every section gets the region of its bound, variable sections are encoded first */
+  for (section = 0; section < RGF_BINARY_SECTION_COUNT; ++section)
+  {
+    unsigned long region = plan.bounds[section];
+
+    if (plan.counts[section] == 0)
+    {
+      continue;
+    }
+
+    if (plan.compressions[section] != RGF_BINARY_COMPRESSION_NONE)
+    {
+      region += rgf_binary_block_table_size(plan.bounds[section]);
+    }
+
+    stored[section].type = (unsigned long)section;
+    stored[section].encoding = plan.encodings[section];
+    stored[section].compression = plan.compressions[section];
+    stored[section].offset = rgf_binary_align(size_total);
+    stored[section].size = plan.bounds[section];
+    stored[section].count = plan.counts[section];
+
+    if (stored[section].offset > out_binary_capacity || region > out_binary_capacity - stored[section].offset)
+    {
+      /* Binary buffer size cannot fit the rgf data */
+      return 0;
+    }
+
+    size_total = stored[section].offset + region;
+
+    if (rgf_binary_plan_is_variable(&plan, section))
+    {
+      chunks[chunk_count].section = section;
+      chunks[chunk_count].first = 0;
+      chunks[chunk_count].count = plan.counts[section];
+      ++chunk_count;
+    }
+    else
+    {
+      fixed[fixed_count++].section = section;
+    }
+  }
+
+  for (i = 0; i < fixed_count; ++i)
+  {
+    section = fixed[i].section;
+    chunk_count += rgf_binary_split_section(chunks + chunk_count, section, rgf_binary_plan_items(&plan, section), threads);
+  }
+
+  encoding.plan = &plan;
+  encoding.stored = stored;
+  encoding.chunks = chunks;
+  encoding.out = out_binary;
+
+  rgf_job_run(jobs, rgf_binary_encode_chunk_job, &encoding, chunk_count);
+
+  for (i = 0; i < chunk_count; ++i)
+  {
+    if (!chunks[i].result)
+    {
+      return 0;
+    }
+  }
+
+  /* The FNV-1a checksum is sequential within a section */
+  encoding.chunks = fixed;
+
+  rgf_job_run(jobs, rgf_binary_checksum_job, &encoding, fixed_count);
+
+  /* Close the gaps behind the variable sections, the padding is zeroed */
+  rgf_binary_write_header(out_binary, model, plan.entries);
+
+  entry = out_binary + RGF_BINARY_SIZE_HEADER_V2;
+  end = RGF_BINARY_SIZE_HEADER_V2 + plan.entries * RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+
+  for (section = 0; section < RGF_BINARY_SECTION_COUNT; ++section)
+  {
+    unsigned long offset = rgf_binary_align(end);
+
+    if (plan.counts[section] == 0)
+    {
+      continue;
+    }
+
+    rgf_binary_move_down(out_binary + offset, out_binary + stored[section].offset, stored[section].size);
+
+    for (i = end; i < offset; ++i)
+    {
+      out_binary[i] = 0;
+    }
+
+    stored[section].offset = offset;
+
+    rgf_binary_write_entry(entry, &stored[section]);
+
+    entry += RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+    end = offset + stored[section].size;
+  }
+
+  *out_binary_size = end;
+
+  return 1;
+}
+
+/* Receives the binary piece by piece from rgf_binary_encode_stream. Every call passes a
+   list of buffers (like an iovec) to write in order, returns 0 to abort the encoding.
+*/
+typedef int (*rgf_binary_write_function)(
+    void *write_context,     /* User context (e.g. a file or socket) */
+    unsigned char **buffers, /* Buffers to write, in order          */
+    unsigned long *sizes,    /* Bytes of every buffer               */
+    unsigned long count      /* Number of buffers                   */
+);
+
+/* Floats quantized per write of rgf_binary_encode_stream, a multiple of 3 */
+#ifndef RGF_BINARY_STREAM_FLOATS
+#define RGF_BINARY_STREAM_FLOATS 3072
+#endif
+
+/* Passes the stored bytes of a section to write, padding_size zero bytes in front.
+   Without write the bytes are only hashed into section->checksum.
+*/
+RGF_API RGF_INLINE int rgf_binary_stream_section(
+    rgf_binary_section *section,
+    void *data,
+    rgf_model *model,
+    unsigned long padding_size,
+    rgf_binary_write_function write,
+    void *write_context)
+{
+  unsigned char padding[RGF_BINARY_ALIGNMENT];
+  unsigned char chunk[RGF_BINARY_STREAM_FLOATS * 2];
+  unsigned char *buffers[2];
+  unsigned long sizes[2];
+  unsigned long hash = RGF_HASH_FNV1A_BASIS;
+  unsigned long step = RGF_BINARY_STREAM_FLOATS;
+  unsigned long index_width = 0;
+  unsigned long i;
+  unsigned long n;
+  int is_raw = section->encoding == RGF_BINARY_ENCODING_RAW;
+
+  for (i = 0; i < RGF_BINARY_ALIGNMENT; ++i)
+  {
+    padding[i] = 0;
+  }
+
+  /* Indices are raw if they are stored with the width of the model */
+  if (section->type == RGF_BINARY_SECTION_INDICES)
+  {
+    index_width = rgf_binary_encoding_index_width(section->encoding);
+
+    if (index_width == 0)
+    {
+      /* TRIANGLE_FIFO is not streamable */
+      return 0;
+    }
+
+    is_raw = index_width == rgf_model_index_width(model);
+    step = (unsigned long)sizeof(chunk) / index_width;
+  }
+
+  /* Raw sections are written straight from the model arrays */
+  if (is_raw)
+  {
+    n = 0;
+
+    if (padding_size > 0)
+    {
+      buffers[n] = padding;
+      sizes[n++] = padding_size;
+    }
+
+    buffers[n] = (unsigned char *)data;
+    sizes[n++] = section->size;
+
+    if (write)
+    {
+      return write(write_context, buffers, sizes, n);
+    }
+
+    section->checksum = rgf_hash_fnv1a(data, section->size);
+    return 1;
+  }
+
+  /* Quantized or narrowed sections go through the chunk, once for the checksum and once for writing */
+  for (i = 0; i < section->count; i += step)
+  {
+    unsigned long floats = section->count - i < step ? section->count - i : step;
+    unsigned long size = 0;
+
+    if (index_width > 0)
+    {
+      if (!rgf_index_convert(chunk, index_width, (unsigned char *)data + i * rgf_model_index_width(model), rgf_model_index_width(model), floats))
       {
-        for (j = 1; j < face_vertices_count - 1; ++j)
-        {
-          model->indices[f_index++] = face_indices_temp[0];
-          model->indices[f_index++] = face_indices_temp[j];
-          model->indices[f_index++] = face_indices_temp[j + 1];
-        }
+        return 0;
       }
     }
+    else if (!rgf_binary_quantize(chunk, (float *)data + i, floats, section->encoding, model))
+    {
+      return 0;
+    }
 
-    while (i < obj_binary_size && obj_binary[i] != '\n')
+    if (!rgf_binary_encoded_size(section->type, section->encoding, floats, &size))
     {
-      i++;
+      return 0;
     }
-    i++;
-  }
 
-  model->center_x = (model->min_x + model->max_x) * 0.5f;
-  model->center_y = (model->min_y + model->max_y) * 0.5f;
-  model->center_z = (model->min_z + model->max_z) * 0.5f;
+    n = 0;
 
-  /* Store the original center position */
-  model->original_center_x = model->center_x;
-  model->original_center_y = model->center_y;
-  model->original_center_z = model->center_z;
+    if (i == 0 && padding_size > 0)
+    {
+      buffers[n] = padding;
+      sizes[n++] = padding_size;
+    }
 
-  /* Calculate the initial dimensions and set scale */
-  model->original_max_dim = model->max_x - model->min_x;
+    buffers[n] = chunk;
+    sizes[n++] = size;
 
-  if (model->max_y - model->min_y > model->original_max_dim)
-  {
-    model->original_max_dim = model->max_y - model->min_y;
-  }
+    if (write && !write(write_context, buffers, sizes, n))
+    {
+      return 0;
+    }
 
-  if (model->max_z - model->min_z > model->original_max_dim)
-  {
-    model->original_max_dim = model->max_z - model->min_z;
+    hash = rgf_hash_fnv1a_update(hash, chunk, size);
   }
 
-  model->current_scale = 1.0f;
+  section->checksum = hash;
 
   return 1;
 }
 
-/* ########################################################## */
-/* # Geometry manipulation functions                          */
-/* ########################################################## */
-RGF_API RGF_INLINE void rgf_model_calculate_boundaries(rgf_model *model)
+/* Encodes the model like rgf_binary_encode_sections, but instead of one buffer for the
+   whole binary the bytes are passed to write as they are produced (to a file, a socket,
+   ...). Raw sections are passed straight from the model arrays and the quantized ones
+   through a small chunk on the stack, so the extra memory does not depend on the model
+   size. Every section is read twice, the directory checksums are written first. Only
+   RAW, UNORM16, OCTAHEDRAL, HALF, INDEX16 and INDEX8 sections without compression can
+   be streamed.
+*/
+RGF_API RGF_INLINE int rgf_binary_encode_stream(
+    rgf_model *model,                  /* The rgf data                            */
+    unsigned long *encodings,          /* Encoding of every section or 0          */
+    rgf_binary_write_function write,   /* Receives the binary piece by piece      */
+    void *write_context,               /* Passed to every write                   */
+    unsigned long *out_binary_size     /* Bytes written in total                  */
+)
 {
+  unsigned char header[RGF_BINARY_SIZE_HEADER_MAX];
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  void *data[RGF_BINARY_SECTION_COUNT];
+  unsigned long counts[RGF_BINARY_SECTION_COUNT];
+  unsigned char *buffers[1];
+  unsigned long sizes[1];
+  unsigned long entries = 0;
+  unsigned long size_total;
   unsigned long i;
-  float dim_x, dim_y, dim_z;
+  int section;
 
-  if (!model || !model->vertices || model->vertices_size == 0)
+  if (!rgf_binary_is_little_endian())
   {
-    return;
+    return 0;
   }
 
-  /* Initialize min/max with the coordinates of the first vertex. */
-  model->min_x = model->max_x = model->vertices[0];
-  model->min_y = model->max_y = model->vertices[1];
-  model->min_z = model->max_z = model->vertices[2];
+  rgf_model_apply_transform(model);
+  rgf_binary_sections(model, data, counts);
 
-  /* Iterate through the rest of the vertices to find the true min/max. */
-  for (i = 3; i < model->vertices_size; i += 3)
+  for (section = 0; section < RGF_BINARY_SECTION_COUNT; ++section)
   {
-    float x = model->vertices[i];
-    float y = model->vertices[i + 1];
-    float z = model->vertices[i + 2];
-
-    if (x < model->min_x)
+    if (counts[section] > 0)
     {
-      model->min_x = x;
+      ++entries;
     }
+  }
 
-    if (x > model->max_x)
-    {
-      model->max_x = x;
-    }
+  size_total = RGF_BINARY_SIZE_HEADER_V2 + entries * RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+
+  /* First pass: place every section and hash its stored bytes */
+  for (entries = 0, section = 0; section < RGF_BINARY_SECTION_COUNT; ++section)
+  {
+    rgf_binary_section *stored = &sections[entries];
 
-    if (y < model->min_y)
+    if (counts[section] == 0)
     {
-      model->min_y = y;
+      continue;
     }
 
-    if (y > model->max_y)
+    stored->type = (unsigned long)section;
+    stored->encoding = encodings ? encodings[section] : RGF_BINARY_ENCODING_RAW;
+    stored->compression = RGF_BINARY_COMPRESSION_NONE;
+
+    if (!encodings && section == RGF_BINARY_SECTION_INDICES)
     {
-      model->max_y = y;
+      stored->encoding = rgf_binary_model_index_encoding(model);
     }
+    stored->offset = rgf_binary_align(size_total);
+    stored->count = counts[section];
 
-    if (z < model->min_z)
+    if (stored->encoding == RGF_BINARY_ENCODING_TRIANGLE_FIFO ||
+        !rgf_binary_encoded_size(stored->type, stored->encoding, stored->count, &stored->size) ||
+        !rgf_binary_stream_section(stored, data[section], model, 0, 0, 0))
     {
-      model->min_z = z;
+      /* not streamable or vertex outside of the bounds */
+      return 0;
     }
 
-    if (z > model->max_z)
+    size_total = stored->offset + stored->size;
+    ++entries;
+  }
+
+  rgf_binary_write_header(header, model, entries);
+
+  for (i = 0; i < entries; ++i)
+  {
+    rgf_binary_write_entry(header + RGF_BINARY_SIZE_HEADER_V2 + i * RGF_BINARY_SIZE_DIRECTORY_ENTRY, &sections[i]);
+  }
+
+  buffers[0] = header;
+  sizes[0] = RGF_BINARY_SIZE_HEADER_V2 + entries * RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+  size_total = sizes[0];
+
+  if (!write(write_context, buffers, sizes, 1))
+  {
+    return 0;
+  }
+
+  /* Second pass: write the sections */
+  for (i = 0; i < entries; ++i)
+  {
+    if (!rgf_binary_stream_section(&sections[i], data[sections[i].type], model, sections[i].offset - size_total, write, write_context))
     {
-      model->max_z = z;
+      return 0;
     }
+
+    size_total = sections[i].offset + sections[i].size;
   }
 
-  /* Calculate the center of the model. */
-  model->center_x = model->min_x + (model->max_x - model->min_x) / 2.0f;
-  model->center_y = model->min_y + (model->max_y - model->min_y) / 2.0f;
-  model->center_z = model->min_z + (model->max_z - model->min_z) / 2.0f;
+  *out_binary_size = size_total;
 
-  /* Set the original properties (as this is the initial calculation). */
-  model->original_center_x = model->center_x;
-  model->original_center_y = model->center_y;
-  model->original_center_z = model->center_z;
+  return 1;
+}
 
-  /* Calculate the dimensions and find the largest one. */
-  dim_x = model->max_x - model->min_x;
-  dim_y = model->max_y - model->min_y;
-  dim_z = model->max_z - model->min_z;
+/* Checks magic and padding, returns the version or 0 for no rgf binary */
+RGF_API RGF_INLINE int rgf_binary_version(unsigned char *in_binary, unsigned long in_binary_size)
+{
+  if (in_binary_size < RGF_BINARY_SIZE_HEADER)
+  {
+    /* no valid rgf binary */
+    return 0;
+  }
 
-  model->original_max_dim = dim_x;
-  
-  if (dim_y > model->original_max_dim)
+  if (in_binary[0] != 'R' || in_binary[1] != 'G' || in_binary[2] != 'F' || in_binary[3] != '\0')
   {
-    model->original_max_dim = dim_y;
+    /* no right magic */
+    return 0;
   }
-  if (dim_z > model->original_max_dim)
+
+  if (in_binary[5] != 0 || in_binary[6] != 0 || in_binary[7] != 0)
   {
-    model->original_max_dim = dim_z;
+    /* no right padding */
+    return 0;
   }
 
-  /* Set the initial scale. */
-  model->current_scale = 1.0f;
+  return in_binary[4];
 }
 
-RGF_API RGF_INLINE void rgf_model_calculate_normals(rgf_model *model)
+/* The arrays can only point into 4 byte aligned little endian data */
+RGF_API RGF_INLINE int rgf_binary_is_addressable(unsigned char *data)
+{
+  return (rgf_address(data) & 3) == 0 && rgf_binary_is_little_endian();
+}
+
+/* Reads the 6 counts of a version 1 binary with fields of width bytes (4 or 8) and returns
+   its total size, 0 if the counts do not fit in_binary_size
+*/
+RGF_API RGF_INLINE unsigned long rgf_binary_v1_size(unsigned char *in_binary, unsigned long in_binary_size, unsigned long width, unsigned long *counts)
 {
+  unsigned long size_total = RGF_BINARY_SIZE_HEADER + 6 * width + 14 * 4;
   unsigned long i;
-  float v1[3], v2[3], v3[3];
-  float edge1[3], edge2[3];
-  float face_normal[3];
-  int idx1, idx2, idx3;
 
-  if (!model->vertices || !model->indices || !model->normals)
+  if (in_binary_size < size_total)
   {
-    return;
+    return 0;
   }
 
-  /* Initialize all normals to zero */
-  for (i = 0; i < model->vertices_size; ++i)
+  for (i = 0; i < 6; ++i)
   {
-    model->normals[i] = 0.0f;
-  }
+    unsigned char *field = in_binary + RGF_BINARY_SIZE_HEADER + i * width;
 
-  /* Iterate through each triangle in the model */
-  for (i = 0; i < model->indices_size; i += 3)
-  {
-    /* Get the indices for the three vertices of the current triangle */
-    idx1 = model->indices[i + 0];
-    idx2 = model->indices[i + 1];
-    idx3 = model->indices[i + 2];
+    counts[i] = rgf_binary_read_ul(field);
+
+    if (width == 8 && !rgf_binary_read_u64(field, &counts[i]))
+    {
+      return 0;
+    }
 
-    /* Get the vertex positions */
-    v1[0] = model->vertices[idx1 * 3 + 0];
-    v1[1] = model->vertices[idx1 * 3 + 1];
-    v1[2] = model->vertices[idx1 * 3 + 2];
+    if (counts[i] > (in_binary_size - size_total) / 4)
+    {
+      return 0;
+    }
 
-    v2[0] = model->vertices[idx2 * 3 + 0];
-    v2[1] = model->vertices[idx2 * 3 + 1];
-    v2[2] = model->vertices[idx2 * 3 + 2];
+    size_total += counts[i] * 4;
+  }
 
-    v3[0] = model->vertices[idx3 * 3 + 0];
-    v3[1] = model->vertices[idx3 * 3 + 1];
-    v3[2] = model->vertices[idx3 * 3 + 2];
+  return size_total;
+}
 
-    /* Calculate the two edge vectors for the triangle */
-    rgf_v3_sub(edge1, v2, v1);
-    rgf_v3_sub(edge2, v3, v1);
+/* Decodes the legacy version 1 layout: no alignment, no submeshes. Its size fields were
+   written as unsigned long, 4 bytes wide on LLP64 and 32 bit hosts and 8 bytes on LP64.
+   The width is the one for which the counts add up to in_binary_size exactly, the one
+   of this host is tried first.
+*/
+RGF_API RGF_INLINE int rgf_binary_decode_v1(
+    unsigned char *in_binary,
+    unsigned long in_binary_size,
+    rgf_model *model)
+{
+  unsigned char *binary_ptr;
+  unsigned long counts[6];
+  unsigned long width = (unsigned long)sizeof(unsigned long) == 8 ? 8 : 4;
+  float *fields[14];
+  unsigned long i;
 
-    /* Compute the cross product to get the face normal */
-    rgf_v3_cross(face_normal, edge1, edge2);
+  if (rgf_binary_v1_size(in_binary, in_binary_size, width, counts) != in_binary_size)
+  {
+    width = 12 - width;
 
-    /* Add this face normal to the vertex normals of all three vertices */
-    rgf_v3_add(&model->normals[idx1 * 3], &model->normals[idx1 * 3], face_normal);
-    rgf_v3_add(&model->normals[idx2 * 3], &model->normals[idx2 * 3], face_normal);
-    rgf_v3_add(&model->normals[idx3 * 3], &model->normals[idx3 * 3], face_normal);
+    if (rgf_binary_v1_size(in_binary, in_binary_size, width, counts) != in_binary_size)
+    {
+      /* no valid rgf binary */
+      return 0;
+    }
   }
 
-  /* Normalize each vertex normal to get the final smooth normal */
-  for (i = 0; i < model->vertices_size; i += 3)
+  binary_ptr = in_binary + RGF_BINARY_SIZE_HEADER + 6 * width;
+
+  rgf_binary_geometry_fields(model, fields);
+
+  for (i = 0; i < 14; ++i)
   {
-    rgf_v3_normalize(&model->normals[i], &model->normals[i]);
+    *fields[i] = rgf_binary_read_float(binary_ptr);
+    binary_ptr += 4;
   }
+
+  model->vertices_size = counts[RGF_BINARY_SECTION_VERTICES];
+  model->normals_size = counts[RGF_BINARY_SECTION_NORMALS];
+  model->tangents_size = counts[RGF_BINARY_SECTION_TANGENTS];
+  model->bitangents_size = counts[RGF_BINARY_SECTION_BITANGENTS];
+  model->uvs_size = counts[RGF_BINARY_SECTION_UVS];
+  model->indices_size = counts[RGF_BINARY_SECTION_INDICES];
+  model->index_width = 4;
+  model->submeshes_size = 0;
+  model->flags = model->normals_size > 0 ? RGF_MODEL_FLAG_NORMALS_PROVIDED : 0;
+
+  model->vertices = model->vertices_size > 0 ? (float *)binary_ptr : 0;
+  binary_ptr += model->vertices_size * 4;
+  model->normals = model->normals_size > 0 ? (float *)binary_ptr : 0;
+  binary_ptr += model->normals_size * 4;
+  model->tangents = model->tangents_size > 0 ? (float *)binary_ptr : 0;
+  binary_ptr += model->tangents_size * 4;
+  model->bitangents = model->bitangents_size > 0 ? (float *)binary_ptr : 0;
+  binary_ptr += model->bitangents_size * 4;
+  model->uvs = model->uvs_size > 0 ? (float *)binary_ptr : 0;
+  binary_ptr += model->uvs_size * 4;
+  model->indices = model->indices_size > 0 ? (int *)binary_ptr : 0;
+  model->submeshes = 0;
+
+  return 1;
 }
 
-RGF_API RGF_INLINE void rgf_model_calculate_tangents_bitangents(rgf_model *model)
+/* Decodes the header and the section directory of a version 2 binary.
+   in_binary only has to hold the first RGF_BINARY_SIZE_HEADER_MAX bytes (less for
+   smaller directories), so a reader can fetch the header first and then read or map
+   only the sections it needs. The model gets the header fields, all arrays are
+   cleared until the sections are passed to rgf_binary_decode_section.
+*/
+RGF_API RGF_INLINE int rgf_binary_decode_header(
+    unsigned char *in_binary,          /* Start of the binary                          */
+    unsigned long in_binary_size,      /* Available bytes, at least the directory      */
+    rgf_model *model,                  /* The rgf data model                           */
+    rgf_binary_section *sections,      /* RGF_BINARY_SECTION_COUNT directory entries   */
+    unsigned long *sections_size       /* Number of sections stored in the binary      */
+)
 {
+  unsigned long entries;
+  unsigned long directory_end;
+  unsigned long seen = 0;
+  float *fields[14];
   unsigned long i;
 
-  if (!model || !model->vertices || !model->indices || !model->uvs || !model->tangents || !model->bitangents)
+  if (rgf_binary_version(in_binary, in_binary_size) != RGF_BINARY_VERSION || in_binary_size < RGF_BINARY_SIZE_HEADER_V2)
   {
-    return;
+    /* no right version */
+    return 0;
   }
 
-  model->tangents_size = model->vertices_size;
-  model->bitangents_size = model->vertices_size;
+  entries = rgf_binary_read_ul(in_binary + 12);
+  directory_end = RGF_BINARY_SIZE_HEADER_V2 + entries * RGF_BINARY_SIZE_DIRECTORY_ENTRY;
 
-  /* Initialize to zero */
-  for (i = 0; i < model->vertices_size; ++i)
+  if (entries > RGF_BINARY_SECTION_COUNT || in_binary_size < directory_end)
   {
-    model->tangents[i] = 0.0f;
-    model->bitangents[i] = 0.0f;
+    /* no complete directory */
+    return 0;
   }
 
-  /* Loop through each triangle */
-  for (i = 0; i < model->indices_size; i += 3)
+  for (i = 0; i < entries; ++i)
   {
-    unsigned long j;
+    unsigned char *entry = in_binary + RGF_BINARY_SIZE_HEADER_V2 + i * RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+    rgf_binary_section *section = &sections[i];
+
+    section->type = rgf_binary_read_ul(entry);
+    section->encoding = rgf_binary_read_ul(entry + 4);
+    section->checksum = rgf_binary_read_ul(entry + 32);
+    section->compression = rgf_binary_read_ul(entry + 36);
+
+    if (!rgf_binary_read_u64(entry + 8, &section->offset) ||
+        !rgf_binary_read_u64(entry + 16, &section->size) ||
+        !rgf_binary_read_u64(entry + 24, &section->count))
+    {
+      return 0;
+    }
+
+    if (section->type >= RGF_BINARY_SECTION_COUNT || (seen & RGF_BINARY_SECTION_BIT(section->type)))
+    {
+      /* unknown or duplicated section */
+      return 0;
+    }
 
-    int i1 = model->indices[i + 0];
-    int i2 = model->indices[i + 1];
-    int i3 = model->indices[i + 2];
+    if (section->offset < directory_end || section->offset % 4 != 0 || section->size > (unsigned long)-1 - section->offset)
+    {
+      /* section overlaps the header or can not be addressed */
+      return 0;
+    }
 
-    /* Vertex positions */
-    float *v0 = &model->vertices[i1 * 3];
-    float *v1 = &model->vertices[i2 * 3];
-    float *v2 = &model->vertices[i3 * 3];
+    seen |= RGF_BINARY_SECTION_BIT(section->type);
+  }
 
-    /* UV coordinates */
-    float *uv0 = &model->uvs[i1 * 2];
-    float *uv1 = &model->uvs[i2 * 2];
-    float *uv2 = &model->uvs[i3 * 2];
+  rgf_binary_geometry_fields(model, fields);
 
-    /* Edges of the triangle : position delta */
-    float deltaPos1[3], deltaPos2[3];
+  for (i = 0; i < 14; ++i)
+  {
+    *fields[i] = rgf_binary_read_float(in_binary + 16 + i * 4);
+  }
 
-    /* UV delta */
-    float deltaUV1[2];
-    float deltaUV2[2];
+  /* Set again when the normals section is decoded */
+  model->flags = rgf_binary_read_ul(in_binary + 8) & ~(RGF_MODEL_FLAG_NORMALS_PROVIDED | RGF_MODEL_FLAGS_RUNTIME);
 
-    /* Calculate r = 1 / (determinant of UV matrix) */
-    float r;
+  model->vertices_size = 0;
+  model->normals_size = 0;
+  model->tangents_size = 0;
+  model->bitangents_size = 0;
+  model->uvs_size = 0;
+  model->indices_size = 0;
+  model->index_width = 4;
+  model->submeshes_size = 0;
 
-    float tangent[3];
-    float bitangent[3];
+  model->vertices = 0;
+  model->normals = 0;
+  model->tangents = 0;
+  model->bitangents = 0;
+  model->uvs = 0;
+  model->indices = 0;
+  model->submeshes = 0;
 
-    deltaUV1[0] = uv1[0] - uv0[0];
-    deltaUV1[1] = uv1[1] - uv0[1];
+  *sections_size = entries;
 
-    deltaUV2[0] = uv2[0] - uv0[0];
-    deltaUV2[1] = uv2[1] - uv0[1];
+  return 1;
+}
 
-    r = deltaUV1[0] * deltaUV2[1] - deltaUV1[1] * deltaUV2[0];
-    r = r != 0.0f ? 1.0f / r : 0.0f;
+/* Returns 1 if the stored bytes of a section match its directory checksum */
+RGF_API RGF_INLINE int rgf_binary_section_verify(rgf_binary_section *section, unsigned char *data)
+{
+  return rgf_hash_fnv1a(data, section->size) == section->checksum;
+}
 
-    rgf_v3_sub(deltaPos1, v1, v0);
-    rgf_v3_sub(deltaPos2, v2, v0);
+RGF_API RGF_INLINE void rgf_binary_assign_section(rgf_model *model, unsigned long type, void *data, unsigned long count)
+{
+  switch (type)
+  {
+  case RGF_BINARY_SECTION_VERTICES:
+    model->vertices = (float *)data;
+    model->vertices_size = count;
+    break;
+  case RGF_BINARY_SECTION_NORMALS:
+    model->normals = (float *)data;
+    model->normals_size = count;
+    model->flags |= RGF_MODEL_FLAG_NORMALS_PROVIDED;
+    break;
+  case RGF_BINARY_SECTION_TANGENTS:
+    model->tangents = (float *)data;
+    model->tangents_size = count;
+    break;
+  case RGF_BINARY_SECTION_BITANGENTS:
+    model->bitangents = (float *)data;
+    model->bitangents_size = count;
+    break;
+  case RGF_BINARY_SECTION_UVS:
+    model->uvs = (float *)data;
+    model->uvs_size = count;
+    break;
+  case RGF_BINARY_SECTION_INDICES:
+    model->indices = (int *)data;
+    model->indices_size = count;
+    model->index_width = 4;
+    break;
+  default:
+    model->submeshes = (rgf_submesh *)data;
+    model->submeshes_size = count;
+    break;
+  }
+}
 
-    /* Tangent & Bitangent */
-    tangent[0] = (deltaPos1[0] * deltaUV2[1] - deltaPos2[0] * deltaUV1[1]) * r;
-    tangent[1] = (deltaPos1[1] * deltaUV2[1] - deltaPos2[1] * deltaUV1[1]) * r;
-    tangent[2] = (deltaPos1[2] * deltaUV2[1] - deltaPos2[2] * deltaUV1[1]) * r;
+/* Returns 1 if the stored size matches the elements in the encoding of the section
+   (for compressed sections if the stream can be decompressed into that encoding)
+*/
+RGF_API RGF_INLINE int rgf_binary_section_valid(rgf_binary_section *section)
+{
+  unsigned long size;
 
-    bitangent[0] = (deltaPos2[0] * deltaUV1[0] - deltaPos1[0] * deltaUV2[0]) * r;
-    bitangent[1] = (deltaPos2[1] * deltaUV1[0] - deltaPos1[1] * deltaUV2[0]) * r;
-    bitangent[2] = (deltaPos2[2] * deltaUV1[0] - deltaPos1[2] * deltaUV2[0]) * r;
+  if (section->type == RGF_BINARY_SECTION_INTERLEAVED)
+  {
+    /* Checked against the layout by rgf_binary_read_layout */
+    size = RGF_BINARY_SIZE_LAYOUT;
 
-    /* Add tangent and bitangent to each vertex of the triangle */
-    for (j = 0; j < 3; ++j)
+    if (section->encoding != RGF_BINARY_ENCODING_RAW)
     {
-      model->tangents[(model->indices[i + j]) * 3 + 0] += tangent[0];
-      model->tangents[(model->indices[i + j]) * 3 + 1] += tangent[1];
-      model->tangents[(model->indices[i + j]) * 3 + 2] += tangent[2];
-
-      model->bitangents[(model->indices[i + j]) * 3 + 0] += bitangent[0];
-      model->bitangents[(model->indices[i + j]) * 3 + 1] += bitangent[1];
-      model->bitangents[(model->indices[i + j]) * 3 + 2] += bitangent[2];
+      return 0;
     }
   }
+  else if (!rgf_binary_encoded_size(section->type, section->encoding, section->count, &size))
+  {
+    return 0;
+  }
 
-  /* Normalize tangents and bitangents */
-  for (i = 0; i < model->vertices_size; i += 3)
+  if (section->compression != RGF_BINARY_COMPRESSION_NONE)
+  {
+    /* The block table is checked while decompressing */
+    return section->compression == RGF_BINARY_COMPRESSION_LZ && section->size >= 8;
+  }
+
+  if (section->type == RGF_BINARY_SECTION_INTERLEAVED)
   {
-    rgf_v3_normalize(&model->tangents[i], &model->tangents[i]);
-    rgf_v3_normalize(&model->bitangents[i], &model->bitangents[i]);
+    return section->size >= size;
   }
+
+  return section->encoding == RGF_BINARY_ENCODING_TRIANGLE_FIFO ? section->size <= size : section->size == size;
 }
 
-RGF_API RGF_INLINE void rgf_model_center(
-    rgf_model *model,
-    float center_x,
-    float center_y,
-    float center_z)
+/* Reads the layout of an INTERLEAVED section from its stored bytes, the vertex_count
+   vertices follow at data + RGF_BINARY_SIZE_LAYOUT (e.g. for a vertex buffer upload)
+*/
+RGF_API RGF_INLINE int rgf_binary_read_layout(rgf_binary_section *section, unsigned char *data, rgf_vertex_layout *layout, unsigned long *vertex_count)
 {
-  float current_center_x, current_center_y, current_center_z;
-  float offset_x, offset_y, offset_z;
+  int order[RGF_VERTEX_ATTRIBUTES];
+  unsigned long order_size;
+  unsigned long floats = 0;
   unsigned long i;
 
-  if (!model->vertices)
+  if (section->type != RGF_BINARY_SECTION_INTERLEAVED || section->compression != RGF_BINARY_COMPRESSION_NONE || !rgf_binary_section_valid(section))
   {
-    return;
+    return 0;
   }
 
-  /* Calculate the current center of the model's bounding box */
-  current_center_x = (model->min_x + model->max_x) / 2.0f;
-  current_center_y = (model->min_y + model->max_y) / 2.0f;
-  current_center_z = (model->min_z + model->max_z) / 2.0f;
+  layout->attributes = rgf_binary_read_ul(data);
+  layout->stride = rgf_binary_read_ul(data + 4);
+
+  for (i = 0; i < RGF_VERTEX_ATTRIBUTES; ++i)
+  {
+    layout->offsets[i] = rgf_binary_read_ul(data + 8 + i * 4);
+  }
 
-  /* Determine the offset needed to move to the new center */
-  offset_x = center_x - current_center_x;
-  offset_y = center_y - current_center_y;
-  offset_z = center_z - current_center_z;
+  if (!rgf_vertex_layout_order(layout, order, &order_size))
+  {
+    return 0;
+  }
 
-  /* Apply the offset to every vertex */
-  for (i = 0; i < model->vertices_size; i += 3)
+  for (i = 0; i < order_size; ++i)
   {
-    model->vertices[i + 0] += offset_x;
-    model->vertices[i + 1] += offset_y;
-    model->vertices[i + 2] += offset_z;
+    floats += rgf_vertex_components(order[i]);
   }
 
-  /* Update the model's bounding box and center properties */
-  model->min_x += offset_x;
-  model->max_x += offset_x;
-  model->min_y += offset_y;
-  model->max_y += offset_y;
-  model->min_z += offset_z;
-  model->max_z += offset_z;
-  model->center_x = center_x;
-  model->center_y = center_y;
-  model->center_z = center_z;
+  *vertex_count = section->count / floats;
+
+  if (section->count % floats != 0 || *vertex_count > (section->size - RGF_BINARY_SIZE_LAYOUT) / layout->stride ||
+      section->size - RGF_BINARY_SIZE_LAYOUT != *vertex_count * layout->stride)
+  {
+    /* size does not match the layout */
+    return 0;
+  }
+
+  return 1;
 }
 
-RGF_API RGF_INLINE void rgf_model_center_reset(
-    rgf_model *model)
+/* Points the model array of the section to data, the section->size stored bytes of
+   the section wherever they were read or mapped to. Without copying, so data has to
+   stay alive and be 4 byte aligned. Only raw sections and narrowed indices (which set
+   model->index_width), quantized sections are used
+   as-is (e.g. as vertex attributes on the GPU) or expanded by rgf_binary_decode_section_to,
+   like interleaved vertices. Compressed sections are passed here after rgf_binary_decompress_section.
+*/
+RGF_API RGF_INLINE int rgf_binary_decode_section(
+    rgf_model *model,
+    rgf_binary_section *section,
+    unsigned char *data)
 {
-  float current_center_x, current_center_y, current_center_z;
-  float offset_x, offset_y, offset_z;
-  unsigned long i;
+  if (rgf_binary_encoding_index_width(section->encoding) == 0 || section->compression != RGF_BINARY_COMPRESSION_NONE ||
+      section->type == RGF_BINARY_SECTION_INTERLEAVED || !rgf_binary_section_valid(section))
+  {
+    /* unsupported section */
+    return 0;
+  }
 
-  if (!model->vertices)
+  if (!rgf_binary_is_addressable(data))
   {
-    return;
+    /* arrays can not point into the binary */
+    return 0;
+  }
+
+  rgf_binary_assign_section(model, section->type, data, section->count);
+
+  if (section->type == RGF_BINARY_SECTION_INDICES)
+  {
+    /* Narrowed indices are used as they are stored */
+    model->index_width = rgf_binary_encoding_index_width(section->encoding);
+  }
+
+  return 1;
+}
+
+/* Bytes of the decoded model array of a section */
+RGF_API RGF_INLINE unsigned long rgf_binary_section_decoded_size(rgf_binary_section *section)
+{
+  return section->count * rgf_binary_element_size((int)section->type);
+}
+
+/* Points the arrays of the attributes of an interleaved layout to out, one after the other */
+RGF_API RGF_INLINE void rgf_binary_assign_interleaved(rgf_model *model, rgf_vertex_layout *layout, void *out, unsigned long vertex_count)
+{
+  int attribute;
+
+  for (attribute = 0; attribute < RGF_VERTEX_ATTRIBUTES; ++attribute)
+  {
+    if (layout->attributes & RGF_VERTEX_BIT(attribute))
+    {
+      rgf_binary_assign_section(model, (unsigned long)attribute, out, vertex_count * rgf_vertex_components(attribute));
+      out = (float *)out + vertex_count * rgf_vertex_components(attribute);
+    }
+  }
+}
+
+/* Expands the items [first, first + count) of a valid uncompressed section from data (the
+   start of the section) into the model arrays it is assigned to. Items are vertices of
+   interleaved sections (with their layout), else elements, see rgf_binary_split_section.
+   TRIANGLE_FIFO sections are only expanded as a whole.
+*/
+RGF_API RGF_INLINE int rgf_binary_read_range(
+    rgf_model *model,
+    rgf_binary_section *section,
+    unsigned char *data,
+    rgf_vertex_layout *layout,
+    unsigned long first,
+    unsigned long count)
+{
+  void *arrays[RGF_BINARY_SECTION_COUNT];
+  unsigned long counts[RGF_BINARY_SECTION_COUNT];
+  float offset[3];
+  float scale[3];
+  unsigned long position = 0;
+  unsigned char *out;
+
+  if (section->type == RGF_BINARY_SECTION_INTERLEAVED)
+  {
+    rgf_model view = *model;
+
+    /* The same arrays starting at the first vertex */
+    view.vertices = model->vertices ? model->vertices + first * 3 : 0;
+    view.normals = model->normals ? model->normals + first * 3 : 0;
+    view.tangents = model->tangents ? model->tangents + first * 3 : 0;
+    view.bitangents = model->bitangents ? model->bitangents + first * 3 : 0;
+    view.uvs = model->uvs ? model->uvs + first * 2 : 0;
+
+    return rgf_model_deinterleave(&view, layout, data + RGF_BINARY_SIZE_LAYOUT + first * layout->stride, count);
+  }
+
+  rgf_binary_sections(model, arrays, counts);
+
+  out = (unsigned char *)arrays[section->type] + first * rgf_binary_element_size((int)section->type);
+
+  if (section->encoding == RGF_BINARY_ENCODING_TRIANGLE_FIFO)
+  {
+    /* corrupt indices */
+    return rgf_binary_decode_triangles((int *)(void *)out, data, section->size, count);
   }
 
-  /* Recalculate the current center of the model's bounding box */
-  current_center_x = (model->min_x + model->max_x) / 2.0f;
-  current_center_y = (model->min_y + model->max_y) / 2.0f;
-  current_center_z = (model->min_z + model->max_z) / 2.0f;
+  rgf_binary_encoded_size(section->type, section->encoding, first, &position);
+  data += position;
 
-  /* Determine the offset needed to move to the original center */
-  offset_x = model->original_center_x - current_center_x;
-  offset_y = model->original_center_y - current_center_y;
-  offset_z = model->original_center_z - current_center_z;
-
-  /* Apply the offset to every vertex */
-  for (i = 0; i < model->vertices_size; i += 3)
+  switch (section->encoding)
   {
-    model->vertices[i + 0] += offset_x;
-    model->vertices[i + 1] += offset_y;
-    model->vertices[i + 2] += offset_z;
+  case RGF_BINARY_ENCODING_UNORM16:
+    rgf_binary_unorm16_range(model, offset, scale);
+    rgf_binary_dequantize_unorm16((float *)(void *)out, (unsigned short *)(void *)data, count, offset, scale);
+    break;
+  case RGF_BINARY_ENCODING_OCTAHEDRAL:
+    rgf_binary_dequantize_octahedral((float *)(void *)out, (short *)(void *)data, count);
+    break;
+  case RGF_BINARY_ENCODING_HALF:
+    rgf_binary_dequantize_half((float *)(void *)out, (unsigned short *)(void *)data, count);
+    break;
+  case RGF_BINARY_ENCODING_INDEX16:
+  case RGF_BINARY_ENCODING_INDEX8:
+    rgf_index_convert(out, 4, data, rgf_binary_encoding_index_width(section->encoding), count);
+    break;
+  default:
+    rgf_binary_memcpy(out, data, count * rgf_binary_element_size((int)section->type));
+    break;
   }
 
-  /* Update the model's bounding box and center properties */
-  model->min_x += offset_x;
-  model->max_x += offset_x;
-  model->min_y += offset_y;
-  model->max_y += offset_y;
-  model->min_z += offset_z;
-  model->max_z += offset_z;
-  model->center_x = model->original_center_x;
-  model->center_y = model->original_center_y;
-  model->center_z = model->original_center_z;
+  return 1;
 }
 
-RGF_API RGF_INLINE void rgf_model_scale(
+/* Expands a section of any encoding from data into out and points the model array to
+   out. out needs rgf_binary_section_decoded_size bytes and 4 byte alignment. UNORM16
+   vertices use the bounds that rgf_binary_decode_header stored in the model. Interleaved
+   vertices are split into the arrays of their attributes, one after the other in out.
+   Compressed sections have to be decompressed first, see rgf_binary_decompress_section.
+*/
+RGF_API RGF_INLINE int rgf_binary_decode_section_to(
     rgf_model *model,
-    float scale)
+    rgf_binary_section *section,
+    unsigned char *data,
+    void *out)
 {
-  unsigned long i;
-  float new_scale_factor;
+  rgf_vertex_layout layout;
+  unsigned long vertex_count;
 
-  /* Handle degenerate case of no vertices */
-  if (!model->vertices || model->original_max_dim <= 0.0f)
+  if (section->compression != RGF_BINARY_COMPRESSION_NONE || !rgf_binary_section_valid(section))
   {
-    return;
+    /* unsupported section */
+    return 0;
   }
 
-  /* Calculate the desired scaling factor */
-  new_scale_factor = scale / model->original_max_dim;
-
-  /* Avoid redundant scaling if already at the desired scale */
-  if (new_scale_factor == model->current_scale)
+  if (!rgf_binary_is_addressable(data) || !rgf_binary_is_addressable((unsigned char *)out))
   {
-    return;
+    /* unaligned data or output */
+    return 0;
   }
 
-  /* Calculate the actual scaling factor to apply incrementally */
-  new_scale_factor = new_scale_factor / model->current_scale;
-
-  /* Apply the new scaling factor to all vertices */
-  for (i = 0; i < model->vertices_size; i++)
+  if (section->type == RGF_BINARY_SECTION_INTERLEAVED)
   {
-    model->vertices[i] *= new_scale_factor;
+    if (!rgf_binary_read_layout(section, data, &layout, &vertex_count))
+    {
+      /* corrupt layout */
+      return 0;
+    }
+
+    rgf_binary_assign_interleaved(model, &layout, out, vertex_count);
+
+    return rgf_binary_read_range(model, section, data, &layout, 0, vertex_count);
   }
 
-  /* Update the model's bounding box and scale properties */
-  model->min_x *= new_scale_factor;
-  model->max_x *= new_scale_factor;
-  model->min_y *= new_scale_factor;
-  model->max_y *= new_scale_factor;
-  model->min_z *= new_scale_factor;
-  model->max_z *= new_scale_factor;
-  model->center_x *= new_scale_factor;
-  model->center_y *= new_scale_factor;
-  model->center_z *= new_scale_factor;
-  model->current_scale *= new_scale_factor;
+  rgf_binary_assign_section(model, section->type, out, section->count);
+
+  return rgf_binary_read_range(model, section, data, 0, 0, section->count);
 }
 
-RGF_API RGF_INLINE void rgf_model_scale_reset(
-    rgf_model *model)
+typedef struct rgf_binary_parallel_decoding
+{
+  rgf_model *model;
+  rgf_binary_section *sections; /* Entry of every section type */
+  rgf_vertex_layout *layout;
+  rgf_binary_chunk *chunks;
+  unsigned char *in;
+
+} rgf_binary_parallel_decoding;
+
+RGF_API void rgf_binary_decode_chunk_job(void *job_data, unsigned long job_index)
 {
+  rgf_binary_parallel_decoding *decoding = (rgf_binary_parallel_decoding *)job_data;
+  rgf_binary_chunk *chunk = &decoding->chunks[job_index];
+  rgf_binary_section *section = &decoding->sections[chunk->section];
+
+  chunk->result = rgf_binary_read_range(decoding->model, section, decoding->in + section->offset, decoding->layout, chunk->first, chunk->count);
+}
+
+/* Decodes a version 2 binary that is completely in memory or mapped with sections of
+   any encoding into out, like rgf_binary_decode_section_to for every section. All
+   arrays are placed in out up front, so the sections and the chunks of every section
+   are expanded concurrently through the job system. out needs the sum of the
+   rgf_binary_section_decoded_size of all sections, each RGF_BINARY_ALIGNMENT aligned.
+   Compressed sections return 0, see rgf_binary_decompress_section_parallel.
+*/
+RGF_API RGF_INLINE int rgf_binary_decode_parallel(
+    unsigned char *in_binary,     /* Start of the binary, 4 byte aligned       */
+    unsigned long in_binary_size, /* Size of the binary                        */
+    rgf_model *model,             /* The rgf data model                        */
+    unsigned char *out,           /* Output for the model arrays               */
+    unsigned long out_capacity,   /* Capacity of out                           */
+    rgf_job_system *jobs          /* Job dispatcher, 0 decodes serially        */
+)
+{
+  rgf_binary_chunk chunks[RGF_BINARY_SECTION_COUNT * RGF_BINARY_MAX_SECTION_JOBS];
+  rgf_binary_section entries[RGF_BINARY_SECTION_COUNT];
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  rgf_binary_parallel_decoding decoding;
+  rgf_vertex_layout layout;
+  unsigned long threads = rgf_job_thread_count(jobs);
+  unsigned long chunk_count = 0;
+  unsigned long sections_size;
+  unsigned long used = 0;
+  unsigned long assigned = 0; /* RGF_BINARY_SECTION_BIT of every assigned model array */
   unsigned long i;
-  float reset_factor;
 
-  /* Handle degenerate cases */
-  if (!model->vertices || model->original_max_dim <= 0.0f || model->current_scale == 1.0f)
+  if (!rgf_binary_is_addressable(in_binary) || !rgf_binary_is_addressable(out))
   {
-    return;
+    /* unaligned data or output */
+    return 0;
   }
 
-  /* Calculate the inverse of the current scale to revert to original size */
-  reset_factor = 1.0f / model->current_scale;
-
-  /* Apply the reset factor to all vertices */
-  for (i = 0; i < model->vertices_size; i++)
+  if (!rgf_binary_decode_header(in_binary, in_binary_size, model, entries, &sections_size))
   {
-    model->vertices[i] *= reset_factor;
+    return 0;
   }
 
-  /* Recalculate the bounds from the new vertices */
-  model->min_x = model->vertices[0];
-  model->max_x = model->vertices[0];
-  model->min_y = model->vertices[1];
-  model->max_y = model->vertices[1];
-  model->min_z = model->vertices[2];
-  model->max_z = model->vertices[2];
-
-  for (i = 3; i < model->vertices_size; i += 3)
+  /* Validate every section and assign its array before any job runs */
+  for (i = 0; i < sections_size; ++i)
   {
-    if (model->vertices[i] < model->min_x)
+    rgf_binary_section *section = &sections[entries[i].type];
+    unsigned char *data;
+    unsigned long offset = rgf_binary_align(used);
+    unsigned long size = rgf_binary_section_decoded_size(&entries[i]);
+    unsigned long items = entries[i].count;
+
+    *section = entries[i];
+
+    if (section->offset > in_binary_size || section->size > in_binary_size - section->offset)
+    {
+      /* no space for data */
+      return 0;
+    }
+
+    data = in_binary + section->offset;
+
+    if (section->compression != RGF_BINARY_COMPRESSION_NONE || !rgf_binary_section_valid(section))
     {
-      model->min_x = model->vertices[i];
+      /* unsupported section */
+      return 0;
     }
-    if (model->vertices[i] > model->max_x)
+
+    if (section->count > ((unsigned long)-1) / rgf_binary_element_size((int)section->type) || offset < used || offset > out_capacity ||
+        size > out_capacity - offset)
     {
-      model->max_x = model->vertices[i];
+      /* no space for the arrays */
+      return 0;
     }
-    if (model->vertices[i + 1] < model->min_y)
+
+    if (section->type == RGF_BINARY_SECTION_INTERLEAVED)
     {
-      model->min_y = model->vertices[i + 1];
+      if (!rgf_binary_read_layout(section, data, &layout, &items))
+      {
+        /* corrupt layout */
+        return 0;
+      }
+
+      /* The attribute bits are the bits of their sections */
+      if (assigned & layout.attributes)
+      {
+        /* an attribute is also stored in its own section */
+        return 0;
+      }
+
+      assigned |= layout.attributes;
+      rgf_binary_assign_interleaved(model, &layout, out + offset, items);
     }
-    if (model->vertices[i + 1] > model->max_y)
+    else
     {
-      model->max_y = model->vertices[i + 1];
+      /* The jobs run after all sections are assigned, so an array must not be reassigned */
+      if (assigned & RGF_BINARY_SECTION_BIT(section->type))
+      {
+        /* an attribute is also stored in the interleaved section */
+        return 0;
+      }
+
+      assigned |= RGF_BINARY_SECTION_BIT(section->type);
+      rgf_binary_assign_section(model, section->type, out + offset, section->count);
     }
-    if (model->vertices[i + 2] < model->min_z)
+
+    if (section->encoding == RGF_BINARY_ENCODING_TRIANGLE_FIFO)
     {
-      model->min_z = model->vertices[i + 2];
+      chunks[chunk_count].section = (int)section->type;
+      chunks[chunk_count].first = 0;
+      chunks[chunk_count].count = items;
+      ++chunk_count;
     }
-    if (model->vertices[i + 2] > model->max_z)
+    else
     {
-      model->max_z = model->vertices[i + 2];
+      chunk_count += rgf_binary_split_section(chunks + chunk_count, (int)section->type, items, threads);
     }
+
+    used = offset + size;
   }
 
-  /* Update the center and current scale */
-  model->center_x = (model->min_x + model->max_x) / 2.0f;
-  model->center_y = (model->min_y + model->max_y) / 2.0f;
-  model->center_z = (model->min_z + model->max_z) / 2.0f;
-  model->current_scale = 1.0f;
-}
+  decoding.model = model;
+  decoding.sections = sections;
+  decoding.layout = &layout;
+  decoding.chunks = chunks;
+  decoding.in = in_binary;
 
-/* ########################################################## */
-/* # Binary En-/Decoding of rgf data                          */
-/* ########################################################## */
-#define RGF_BINARY_VERSION 1
-#define RGF_BINARY_SIZE_MAGIC 4
-#define RGF_BINARY_SIZE_VERSION 4
-#define RGF_BINARY_SIZE_HEADER (RGF_BINARY_SIZE_MAGIC + RGF_BINARY_SIZE_VERSION)
+  rgf_job_run(jobs, rgf_binary_decode_chunk_job, &decoding, chunk_count);
 
-RGF_API RGF_INLINE void *rgf_binary_memcpy(void *dest, void *src, unsigned long count)
-{
-  char *dest8 = (char *)dest;
-  char *src8 = (char *)src;
-  while (count--)
+  for (i = 0; i < chunk_count; ++i)
   {
-    *dest8++ = *src8++;
+    if (!chunks[i].result)
+    {
+      return 0;
+    }
   }
 
-  return dest;
+  return 1;
 }
 
-RGF_API RGF_INLINE int rgf_binary_encode(
-    unsigned char *out_binary,         /* Output buffer for executable        */
-    unsigned long out_binary_capacity, /* Capacity of output buffer           */
-    unsigned long *out_binary_size,    /* Actual size of output binary buffer */
-    rgf_model *model                   /* The rgf data                        */
-)
+/* Decodes only the sections in section_mask (RGF_BINARY_SECTION_BIT of each wanted
+   section) of a version 2 binary that is completely in memory or mapped. Only the
+   pages of the requested sections are touched. The other arrays stay empty.
+*/
+RGF_API RGF_INLINE int rgf_binary_decode_sections(
+    unsigned char *in_binary,
+    unsigned long in_binary_size,
+    rgf_model *model,
+    unsigned long section_mask)
 {
-  unsigned char *ptr = out_binary;
-
-  unsigned long size_total =
-      (unsigned long)(RGF_BINARY_SIZE_HEADER +    /* Header                                      */
-                      6 * sizeof(unsigned long) + /* Vertices/Normals/Indices/... sizes          */
-                      14 * sizeof(int)            /* Boundaries of geometry (min,max,center,...) */
-      );
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long sections_size;
+  unsigned long i;
 
-  /* Depending on which data is set in the rgf model we calculate the total size needed to store */
-  if (model->vertices && model->vertices_size > 0)
+  if (!rgf_binary_decode_header(in_binary, in_binary_size, model, sections, &sections_size))
   {
-    size_total += (unsigned long)(model->vertices_size * sizeof(float));
+    return 0;
   }
 
-  if (model->normals && model->normals_size > 0)
+  for (i = 0; i < sections_size; ++i)
   {
-    size_total += (unsigned long)(model->normals_size * sizeof(float));
-  }
+    if (!(section_mask & RGF_BINARY_SECTION_BIT(sections[i].type)))
+    {
+      continue;
+    }
 
-  if (model->tangents && model->tangents_size > 0)
-  {
-    size_total += (unsigned long)(model->tangents_size * sizeof(float));
-  }
+    if (sections[i].offset > in_binary_size || sections[i].size > in_binary_size - sections[i].offset)
+    {
+      /* no space for data */
+      return 0;
+    }
 
-  if (model->bitangents && model->bitangents_size > 0)
-  {
-    size_total += (unsigned long)(model->bitangents_size * sizeof(float));
+    if (!rgf_binary_decode_section(model, &sections[i], in_binary + sections[i].offset))
+    {
+      return 0;
+    }
   }
 
-  if (model->uvs && model->uvs_size > 0)
-  {
-    size_total += (unsigned long)(model->uvs_size * sizeof(float));
-  }
+  return 1;
+}
 
-  if (model->indices && model->indices_size > 0)
-  {
-    size_total += (unsigned long)(model->indices_size * sizeof(int));
-  }
+/* Decodes without copying: the model arrays point into in_binary, which has to stay alive.
+   in_binary has to be 4 byte aligned, with a RGF_BINARY_ALIGNMENT aligned buffer (like a
+   mapped file) every array is RGF_BINARY_ALIGNMENT aligned. The cost does not depend on
+   the model size. Binaries with quantized or compressed sections return 0, they are
+   decoded section by section with rgf_binary_decode_header and rgf_binary_decode_section_to.
+*/
+RGF_API RGF_INLINE int rgf_binary_decode(
+    unsigned char *in_binary,     /* Output buffer for executable        */
+    unsigned long in_binary_size, /* Actual size of output binary buffer */
+    rgf_model *model              /* The rgf data model                  */
+)
+{
+  int version = rgf_binary_version(in_binary, in_binary_size);
 
-  if (out_binary_capacity < size_total)
+  if (!rgf_binary_is_addressable(in_binary))
   {
-    /* Binary buffer size cannot fit the rgf data */
+    /* arrays can not point into the binary */
     return 0;
   }
 
-  /* 4 byte magic */
-  ptr[0] = 'R';
-  ptr[1] = 'G';
-  ptr[2] = 'F';
-  ptr[3] = '\0';
-
-  /* 1 byte version + 3 byte padding */
-  ptr[4] = RGF_BINARY_VERSION;
-  ptr[5] = 0;
-  ptr[6] = 0;
-  ptr[7] = 0;
-
-  ptr += RGF_BINARY_SIZE_HEADER;
-
-  rgf_binary_memcpy(ptr, &model->vertices_size, (unsigned long)sizeof(unsigned long));
-  ptr += sizeof(unsigned long);
-  rgf_binary_memcpy(ptr, &model->normals_size, (unsigned long)sizeof(unsigned long));
-  ptr += sizeof(unsigned long);
-  rgf_binary_memcpy(ptr, &model->tangents_size, (unsigned long)sizeof(unsigned long));
-  ptr += sizeof(unsigned long);
-  rgf_binary_memcpy(ptr, &model->bitangents_size, (unsigned long)sizeof(unsigned long));
-  ptr += sizeof(unsigned long);
-  rgf_binary_memcpy(ptr, &model->uvs_size, (unsigned long)sizeof(unsigned long));
-  ptr += sizeof(unsigned long);
-  rgf_binary_memcpy(ptr, &model->indices_size, (unsigned long)sizeof(unsigned long));
-  ptr += sizeof(unsigned long);
-
-  rgf_binary_memcpy(ptr, &model->min_x, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->min_y, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->min_z, 4);
-  ptr += 4;
-
-  rgf_binary_memcpy(ptr, &model->max_x, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->max_y, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->max_z, 4);
-  ptr += 4;
-
-  rgf_binary_memcpy(ptr, &model->center_x, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->center_y, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->center_z, 4);
-  ptr += 4;
-
-  rgf_binary_memcpy(ptr, &model->original_center_x, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->original_center_y, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->original_center_z, 4);
-  ptr += 4;
-
-  rgf_binary_memcpy(ptr, &model->original_max_dim, 4);
-  ptr += 4;
-  rgf_binary_memcpy(ptr, &model->current_scale, 4);
-  ptr += 4;
-
-  /* Depending on which data is set in the rgf model we copy the data into the binary buffer */
-  if (model->vertices && model->vertices_size > 0)
+  if (version == RGF_BINARY_VERSION_1)
   {
-    unsigned long size = model->vertices_size * sizeof(float);
-    rgf_binary_memcpy(ptr, model->vertices, size);
-    ptr += size;
+    return rgf_binary_decode_v1(in_binary, in_binary_size, model);
   }
 
-  if (model->normals && model->normals_size > 0)
-  {
-    unsigned long size = model->normals_size * sizeof(float);
-    rgf_binary_memcpy(ptr, model->normals, size);
-    ptr += size;
-  }
+  return rgf_binary_decode_sections(in_binary, in_binary_size, model, RGF_BINARY_SECTIONS_ALL);
+}
 
-  if (model->tangents && model->tangents_size > 0)
+/* ########################################################## */
+/* # Pack archive of many models (.rgfpak)                    */
+/* ########################################################## */
+/* Many small models in one file, so a viewer maps one file instead of opening one
+   file per model. All fields little endian:
+
+     0  magic "RGFP", u8 version, 3 zero bytes
+     8  u32 number of models, u32 number of hash slots (a power of two)
+    16  hash slots, u32 per slot: index of the model + 1, 0 for an empty slot
+        model entries (8 byte aligned), 32 bytes per model:
+          u32 FNV-1a of the name, u32 name length, u64 name offset,
+          u64 binary offset, u64 binary size
+        the name (not terminated) and the version 2 binary of every model,
+        each binary starting at a multiple of RGF_BINARY_ALIGNMENT
+
+   A name is found by linear probing from its hash slot, so a lookup touches the slots,
+   one entry and the name in the common case. The slots are at most half full.
+*/
+#define RGF_PAK_VERSION 1
+#define RGF_PAK_SIZE_HEADER 16
+#define RGF_PAK_SIZE_ENTRY 32
+
+typedef struct rgf_pak_builder
+{
+  unsigned char *out;
+  unsigned long capacity;
+  unsigned long size;      /* Bytes of the pack so far, the pack is complete after every add */
+  unsigned long count;     /* Models added                                               */
+  unsigned long max_count; /* Models the directory has room for                          */
+  unsigned long slot_count;
+
+} rgf_pak_builder;
+
+RGF_API RGF_INLINE unsigned long rgf_pak_entries_offset(unsigned long slot_count)
+{
+  return (RGF_PAK_SIZE_HEADER + slot_count * 4 + 7) & ~7UL;
+}
+
+/* Starts a pack in out (RGF_BINARY_ALIGNMENT aligned) with room for max_count models */
+RGF_API RGF_INLINE int rgf_pak_begin(rgf_pak_builder *builder, unsigned char *out, unsigned long capacity, unsigned long max_count)
+{
+  unsigned long slot_count = 1;
+  unsigned long directory_end;
+  unsigned long i;
+
+  if (max_count > (unsigned long)-1 / (RGF_PAK_SIZE_ENTRY * 4))
   {
-    unsigned long size = model->tangents_size * sizeof(float);
-    rgf_binary_memcpy(ptr, model->tangents, size);
-    ptr += size;
+    return 0;
   }
 
-  if (model->bitangents && model->bitangents_size > 0)
+  while (slot_count < max_count * 2)
   {
-    unsigned long size = model->bitangents_size * sizeof(float);
-    rgf_binary_memcpy(ptr, model->bitangents, size);
-    ptr += size;
+    slot_count *= 2;
   }
 
-  if (model->uvs && model->uvs_size > 0)
+  directory_end = rgf_pak_entries_offset(slot_count) + max_count * RGF_PAK_SIZE_ENTRY;
+
+  if (capacity < directory_end)
   {
-    unsigned long size = model->uvs_size * sizeof(float);
-    rgf_binary_memcpy(ptr, model->uvs, size);
-    ptr += size;
+    /* no room for the directory */
+    return 0;
   }
 
-  if (model->indices && model->indices_size > 0)
+  for (i = 0; i < directory_end; ++i)
   {
-    unsigned long size = model->indices_size * sizeof(int);
-    rgf_binary_memcpy(ptr, model->indices, size);
-    ptr += size;
+    out[i] = 0;
   }
 
-  *out_binary_size = size_total;
+  out[0] = 'R';
+  out[1] = 'G';
+  out[2] = 'F';
+  out[3] = 'P';
+  out[4] = RGF_PAK_VERSION;
 
-  return 1;
-}
+  rgf_binary_write_u32(out + 12, slot_count);
 
-RGF_API RGF_INLINE unsigned long rgf_binary_read_ul(unsigned char *ptr)
-{
-  return ((unsigned long)ptr[0]) |
-         ((unsigned long)ptr[1] << 8) |
-         ((unsigned long)ptr[2] << 16) |
-         ((unsigned long)ptr[3] << 24);
+  builder->out = out;
+  builder->capacity = capacity;
+  builder->size = directory_end;
+  builder->count = 0;
+  builder->max_count = max_count;
+  builder->slot_count = slot_count;
+
+  return 1;
 }
 
-RGF_API RGF_INLINE float rgf_binary_read_float(unsigned char *ptr)
+/* Checks the header of a pack and its directory bounds */
+RGF_API RGF_INLINE int rgf_pak_header(unsigned char *pak, unsigned long pak_size, unsigned long *count, unsigned long *slot_count)
 {
-  union
+  if (pak_size < RGF_PAK_SIZE_HEADER || pak[0] != 'R' || pak[1] != 'G' || pak[2] != 'F' || pak[3] != 'P' ||
+      pak[4] != RGF_PAK_VERSION || pak[5] != 0 || pak[6] != 0 || pak[7] != 0)
   {
-    unsigned long l;
-    float f;
-  } u;
+    /* no rgf pack */
+    return 0;
+  }
 
-  u.l = rgf_binary_read_ul(ptr);
+  *count = rgf_binary_read_ul(pak + 8);
+  *slot_count = rgf_binary_read_ul(pak + 12);
 
-  return u.f;
+  if (*slot_count == 0 || (*slot_count & (*slot_count - 1)) != 0 || *slot_count > (pak_size - RGF_PAK_SIZE_HEADER) / 4 ||
+      rgf_pak_entries_offset(*slot_count) > pak_size || *count >= *slot_count ||
+      *count > (pak_size - rgf_pak_entries_offset(*slot_count)) / RGF_PAK_SIZE_ENTRY)
+  {
+    /* no complete directory */
+    return 0;
+  }
+
+  return 1;
 }
 
-RGF_API RGF_INLINE int rgf_binary_decode(
-    unsigned char *in_binary,     /* Output buffer for executable        */
-    unsigned long in_binary_size, /* Actual size of output binary buffer */
-    rgf_model *model              /* The rgf data model                  */
-)
+/* Returns the name and the binary of the model at index, both pointing into the pack */
+RGF_API RGF_INLINE int rgf_pak_entry(
+    unsigned char *pak,
+    unsigned long pak_size,
+    unsigned long index,
+    char **name,
+    unsigned long *name_length,
+    unsigned char **binary,
+    unsigned long *binary_size)
 {
-  unsigned char *binary_ptr;
-
-  unsigned long size_total;
+  unsigned long count;
+  unsigned long slot_count;
+  unsigned long name_offset;
+  unsigned long binary_offset;
+  unsigned char *entry;
 
-  if (in_binary_size < RGF_BINARY_SIZE_HEADER)
+  if (!rgf_pak_header(pak, pak_size, &count, &slot_count) || index >= count)
   {
-    /* no valid rgf binary */
     return 0;
   }
 
-  if (in_binary[0] != 'R' || in_binary[1] != 'G' || in_binary[2] != 'F' || in_binary[3] != '\0')
-  {
-    /* no right magic */
-    return 0;
-  }
-  if (in_binary[4] != RGF_BINARY_VERSION)
+  entry = pak + rgf_pak_entries_offset(slot_count) + index * RGF_PAK_SIZE_ENTRY;
+  *name_length = rgf_binary_read_ul(entry + 4);
+
+  if (!rgf_binary_read_u64(entry + 8, &name_offset) ||
+      !rgf_binary_read_u64(entry + 16, &binary_offset) ||
+      !rgf_binary_read_u64(entry + 24, binary_size))
   {
-    /* no right version */
     return 0;
   }
 
-  if (in_binary[5] != 0 || in_binary[6] != 0 || in_binary[7] != 0)
+  if (name_offset > pak_size || *name_length > pak_size - name_offset ||
+      binary_offset > pak_size || *binary_size > pak_size - binary_offset)
   {
-    /* no right padding */
+    /* entry outside of the pack */
     return 0;
   }
 
-  binary_ptr = in_binary + RGF_BINARY_SIZE_HEADER;
+  *name = (char *)pak + name_offset;
+  *binary = pak + binary_offset;
 
-  model->vertices_size = rgf_binary_read_ul(binary_ptr);
-  binary_ptr += sizeof(unsigned long);
-  model->normals_size = rgf_binary_read_ul(binary_ptr);
-  binary_ptr += sizeof(unsigned long);
-  model->tangents_size = rgf_binary_read_ul(binary_ptr);
-  binary_ptr += sizeof(unsigned long);
-  model->bitangents_size = rgf_binary_read_ul(binary_ptr);
-  binary_ptr += sizeof(unsigned long);
-  model->uvs_size = rgf_binary_read_ul(binary_ptr);
-  binary_ptr += sizeof(unsigned long);
-  model->indices_size = rgf_binary_read_ul(binary_ptr);
-  binary_ptr += sizeof(unsigned long);
+  return 1;
+}
 
-  size_total =
-      (unsigned long)(RGF_BINARY_SIZE_HEADER +    /* Header                                  */
-                      6 * sizeof(unsigned long) + /* Vertices/Normals/Indices count           */
-                      14 * sizeof(float)          /* Boundaries of geometry (min,max,center) */
-      );
+RGF_API RGF_INLINE int rgf_pak_name_equals(char *a, char *b, unsigned long length)
+{
+  unsigned long i;
 
-  /* Depending on which data is set in the rgf model we calculate the total size needed to store */
-  if (model->vertices_size > 0)
+  for (i = 0; i < length; ++i)
   {
-    size_total += (unsigned long)(model->vertices_size * sizeof(float));
+    if (a[i] != b[i])
+    {
+      return 0;
+    }
   }
 
-  if (model->normals_size > 0)
+  return 1;
+}
+
+/* Finds the model name in the pack, returns its index or -1 */
+RGF_API RGF_INLINE long rgf_pak_find(unsigned char *pak, unsigned long pak_size, char *name, unsigned long name_length)
+{
+  unsigned long hash = rgf_hash_fnv1a((unsigned char *)name, name_length);
+  unsigned long count;
+  unsigned long slot_count;
+  unsigned long slot;
+  unsigned long probes;
+
+  if (!rgf_pak_header(pak, pak_size, &count, &slot_count))
   {
-    size_total += (unsigned long)(model->normals_size * sizeof(float));
+    return -1;
   }
 
-  if (model->tangents_size > 0)
+  slot = hash & (slot_count - 1);
+
+  for (probes = 0; probes < slot_count; ++probes)
   {
-    size_total += (unsigned long)(model->tangents_size * sizeof(float));
+    unsigned long index = rgf_binary_read_ul(pak + RGF_PAK_SIZE_HEADER + slot * 4);
+    unsigned char *entry;
+    char *entry_name;
+    unsigned long entry_name_length;
+    unsigned char *binary;
+    unsigned long binary_size;
+
+    if (index == 0)
+    {
+      return -1;
+    }
+
+    entry = pak + rgf_pak_entries_offset(slot_count) + (index - 1) * RGF_PAK_SIZE_ENTRY;
+
+    if (index <= count && rgf_binary_read_ul(entry) == hash &&
+        rgf_pak_entry(pak, pak_size, index - 1, &entry_name, &entry_name_length, &binary, &binary_size) &&
+        entry_name_length == name_length && rgf_pak_name_equals(entry_name, name, name_length))
+    {
+      return (long)(index - 1);
+    }
+
+    slot = (slot + 1) & (slot_count - 1);
   }
 
-  if (model->bitangents_size > 0)
+  return -1;
+}
+
+/* Decodes the named model without copying, the arrays point into the pack (e.g. a file
+   mapped with rgf_platform_map), which has to stay alive
+*/
+RGF_API RGF_INLINE int rgf_pak_load(unsigned char *pak, unsigned long pak_size, char *name, unsigned long name_length, rgf_model *model)
+{
+  long index = rgf_pak_find(pak, pak_size, name, name_length);
+  char *entry_name;
+  unsigned long entry_name_length;
+  unsigned char *binary;
+  unsigned long binary_size;
+
+  if (index < 0 || !rgf_pak_entry(pak, pak_size, (unsigned long)index, &entry_name, &entry_name_length, &binary, &binary_size))
   {
-    size_total += (unsigned long)(model->bitangents_size * sizeof(float));
+    return 0;
   }
 
-  if (model->uvs_size > 0)
+  return rgf_binary_decode(binary, binary_size, model);
+}
+
+/* Stores the name of the next model and returns the aligned offset of its binary, the
+   model is only added by rgf_pak_add_entry once its binary is stored
+*/
+RGF_API RGF_INLINE int rgf_pak_add_name(rgf_pak_builder *builder, char *name, unsigned long name_length, unsigned long *binary_offset)
+{
+  unsigned long i;
+
+  if (builder->count == builder->max_count || name_length > builder->capacity - builder->size)
   {
-    size_total += (unsigned long)(model->uvs_size * sizeof(float));
+    /* no room for the model */
+    return 0;
   }
 
-  if (model->indices_size > 0)
+  if (rgf_pak_find(builder->out, builder->size, name, name_length) >= 0)
   {
-    size_total += (unsigned long)(model->indices_size * sizeof(int));
+    /* duplicated name */
+    return 0;
   }
 
-  if (in_binary_size < size_total)
+  *binary_offset = rgf_binary_align(builder->size + name_length);
+
+  if (*binary_offset > builder->capacity)
   {
-    /* no space for data */
     return 0;
   }
 
-  model->min_x = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->min_y = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->min_z = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-
-  model->max_x = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->max_y = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->max_z = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
+  rgf_binary_memcpy(builder->out + builder->size, name, name_length);
 
-  model->center_x = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->center_y = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->center_z = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
+  for (i = builder->size + name_length; i < *binary_offset; ++i)
+  {
+    builder->out[i] = 0;
+  }
 
-  model->original_center_x = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->original_center_y = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->original_center_z = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
+  return 1;
+}
 
-  model->original_max_dim = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
-  model->current_scale = rgf_binary_read_float(binary_ptr);
-  binary_ptr += 4;
+/* Writes the hash slot and the entry of the model stored by rgf_pak_add_name */
+RGF_API RGF_INLINE void rgf_pak_add_entry(rgf_pak_builder *builder, char *name, unsigned long name_length, unsigned long binary_offset, unsigned long binary_size)
+{
+  unsigned long hash = rgf_hash_fnv1a((unsigned char *)name, name_length);
+  unsigned long slot = hash & (builder->slot_count - 1);
+  unsigned char *entry = builder->out + rgf_pak_entries_offset(builder->slot_count) + builder->count * RGF_PAK_SIZE_ENTRY;
 
-  if (model->vertices_size > 0)
+  while (rgf_binary_read_ul(builder->out + RGF_PAK_SIZE_HEADER + slot * 4) != 0)
   {
-    model->vertices = (float *)binary_ptr;
-    binary_ptr += model->vertices_size * sizeof(float);
+    slot = (slot + 1) & (builder->slot_count - 1);
   }
 
-  if (model->normals_size > 0)
-  {
-    model->normals = (float *)binary_ptr;
-    binary_ptr += model->normals_size * sizeof(float);
-  }
+  rgf_binary_write_u32(builder->out + RGF_PAK_SIZE_HEADER + slot * 4, builder->count + 1);
+  rgf_binary_write_u32(entry, hash);
+  rgf_binary_write_u32(entry + 4, name_length);
+  rgf_binary_write_u64(entry + 8, builder->size);
+  rgf_binary_write_u64(entry + 16, binary_offset);
+  rgf_binary_write_u64(entry + 24, binary_size);
 
-  if (model->tangents_size > 0)
-  {
-    model->tangents = (float *)binary_ptr;
-    binary_ptr += model->tangents_size * sizeof(float);
-  }
+  builder->count++;
+  builder->size = binary_offset + binary_size;
 
-  if (model->bitangents_size > 0)
-  {
-    model->bitangents = (float *)binary_ptr;
-    binary_ptr += model->bitangents_size * sizeof(float);
-  }
+  rgf_binary_write_u32(builder->out + 8, builder->count);
+}
 
-  if (model->uvs_size > 0)
+/* Encodes the model into the pack under a unique name */
+RGF_API RGF_INLINE int rgf_pak_add(rgf_pak_builder *builder, char *name, unsigned long name_length, rgf_model *model)
+{
+  unsigned long binary_offset;
+  unsigned long binary_size;
+
+  if (!rgf_pak_add_name(builder, name, name_length, &binary_offset) ||
+      !rgf_binary_encode(builder->out + binary_offset, builder->capacity - binary_offset, &binary_size, model))
   {
-    model->uvs = (float *)binary_ptr;
-    binary_ptr += model->uvs_size * sizeof(float);
+    return 0;
   }
 
-  if (model->indices_size > 0)
+  rgf_pak_add_entry(builder, name, name_length, binary_offset, binary_size);
+
+  return 1;
+}
+
+/* Copies an already encoded binary (e.g. a .rgf file) into the pack under a unique name */
+RGF_API RGF_INLINE int rgf_pak_add_binary(rgf_pak_builder *builder, char *name, unsigned long name_length, unsigned char *binary, unsigned long binary_size)
+{
+  unsigned long binary_offset;
+
+  if (!rgf_pak_add_name(builder, name, name_length, &binary_offset) || binary_size > builder->capacity - binary_offset)
   {
-    model->indices = (int *)binary_ptr;
-    binary_ptr += model->indices_size * sizeof(int);
+    return 0;
   }
 
+  rgf_binary_memcpy(builder->out + binary_offset, binary, binary_size);
+  rgf_pak_add_entry(builder, name, name_length, binary_offset, binary_size);
+
   return 1;
 }
 
@@ -1450,7 +8594,7 @@ RGF_API RGF_INLINE void rgf_write_float_array(float *arr, unsigned long size, ch
   rgf_append_str("\n};\n\n", buffer, current_size, capacity);
 }
 
-RGF_API RGF_INLINE void rgf_write_int_array(int *arr, unsigned long size, char *name_prefix, char *suffix, unsigned char *buffer, unsigned long *current_size, unsigned long capacity)
+RGF_API RGF_INLINE void rgf_write_int_array(int *arr, unsigned long width, unsigned long size, char *name_prefix, char *suffix, unsigned char *buffer, unsigned long *current_size, unsigned long capacity)
 {
   unsigned long i;
   char temp_buffer[64];
@@ -1462,7 +8606,7 @@ RGF_API RGF_INLINE void rgf_write_int_array(int *arr, unsigned long size, char *
 
   for (i = 0; i < size; ++i)
   {
-    rgf_ltoa(arr[i], temp_buffer);
+    rgf_ltoa(width == 4 ? (long)arr[i] : (long)rgf_index_get(arr, width, i), temp_buffer);
     rgf_append_str(temp_buffer, buffer, current_size, capacity);
     if (i < size - 1)
     {
@@ -1529,6 +8673,8 @@ RGF_API RGF_INLINE void rgf_convert_to_c_header(rgf_model *model, char *header_n
     return;
   }
 
+  rgf_model_apply_transform(model);
+
   /* 1. Create the header guard name (e.g., "myrgffile" -> "MYRGFFILE_H") */
   while (header_name[i] != '\0' && i < (int)(sizeof(guard_name) - 3))
   {
@@ -1580,7 +8726,7 @@ RGF_API RGF_INLINE void rgf_convert_to_c_header(rgf_model *model, char *header_n
   }
   if (model->indices && model->indices_size > 0)
   {
-    rgf_write_int_array(model->indices, model->indices_size, header_name, "_indices", binary_buffer, binary_buffer_size, binary_buffer_capacity);
+    rgf_write_int_array(model->indices, rgf_model_index_width(model), model->indices_size, header_name, "_indices", binary_buffer, binary_buffer_size, binary_buffer_capacity);
   }
 
   /* 4. Write static scalar variables */
@@ -1591,6 +8737,7 @@ RGF_API RGF_INLINE void rgf_convert_to_c_header(rgf_model *model, char *header_n
   rgf_write_static_ulong(header_name, "_bitangents_size", model->bitangents_size, binary_buffer, binary_buffer_size, binary_buffer_capacity);
   rgf_write_static_ulong(header_name, "_uvs_size", model->uvs_size, binary_buffer, binary_buffer_size, binary_buffer_capacity);
   rgf_write_static_ulong(header_name, "_indices_size", model->indices_size, binary_buffer, binary_buffer_size, binary_buffer_capacity);
+  rgf_write_static_ulong(header_name, "_flags", model->flags & ~RGF_MODEL_FLAGS_RUNTIME, binary_buffer, binary_buffer_size, binary_buffer_capacity);
   rgf_write_static_float(header_name, "_min_x", model->min_x, binary_buffer, binary_buffer_size, binary_buffer_capacity);
   rgf_write_static_float(header_name, "_min_y", model->min_y, binary_buffer, binary_buffer_size, binary_buffer_capacity);
   rgf_write_static_float(header_name, "_min_z", model->min_z, binary_buffer, binary_buffer_size, binary_buffer_capacity);
@@ -35,6 +35,15 @@ LICENSE
 #define RGF_PLATFORM_API static
 #endif
 
+/* 64 bit file offsets (C89 has no portable "long long") */
+#if defined(_MSC_VER)
+typedef unsigned __int64 rgf_platform_u64;
+#elif defined(__GNUC__) || defined(__clang__)
+__extension__ typedef unsigned long long rgf_platform_u64;
+#else
+typedef unsigned long rgf_platform_u64; /* Assumes a LP64 target */
+#endif
+
 #ifdef _WIN32
 #define RGF_PLATFORM_WIN32_INVALID_HANDLE ((void *)-1)
 #define RGF_PLATFORM_WIN32_GENERIC_WRITE (0x40000000L)
@@ -47,6 +56,25 @@ LICENSE
 #define RGF_PLATFORM_WIN32_GENERIC_READ (0x80000000L)
 #define RGF_PLATFORM_WIN32_FILE_SHARE_READ 0x00000001
 #define RGF_PLATFORM_WIN32_OPEN_EXISTING 3
+#define RGF_PLATFORM_WIN32_FILE_BEGIN 0
+#define RGF_PLATFORM_WIN32_INVALID_SET_FILE_POINTER ((unsigned long)0xffffffff)
+#define RGF_PLATFORM_WIN32_NO_ERROR 0
+
+/* IO map */
+#define RGF_PLATFORM_WIN32_PAGE_READONLY 0x02
+#define RGF_PLATFORM_WIN32_FILE_MAP_READ 0x0004
+#define RGF_PLATFORM_WIN32_FILE_FLAG_SEQUENTIAL_SCAN 0x08000000
+
+/* OVERLAPPED, only used for the file offset of positional writes */
+typedef struct rgf_platform_win32_overlapped
+{
+    void *Internal;
+    void *InternalHigh;
+    unsigned long Offset;
+    unsigned long OffsetHigh;
+    void *hEvent;
+
+} rgf_platform_win32_overlapped;
 
 #ifndef _WINDOWS_
 #define RGF_PLATFORM_WIN32_API(r) __declspec(dllimport) r __stdcall
@@ -86,6 +114,37 @@ ReadFile(
     unsigned long *lpNumberOfBytesRead,
     void *lpOverlapped);
 
+RGF_PLATFORM_WIN32_API(unsigned long)
+SetFilePointer(
+    void *hFile,
+    long lDistanceToMove,
+    long *lpDistanceToMoveHigh,
+    unsigned long dwMoveMethod);
+
+RGF_PLATFORM_WIN32_API(unsigned long)
+GetLastError(void);
+
+/* IO map */
+RGF_PLATFORM_WIN32_API(void *)
+CreateFileMappingA(
+    void *hFile,
+    void *lpFileMappingAttributes,
+    unsigned long flProtect,
+    unsigned long dwMaximumSizeHigh,
+    unsigned long dwMaximumSizeLow,
+    const char *lpName);
+
+RGF_PLATFORM_WIN32_API(void *)
+MapViewOfFile(
+    void *hFileMappingObject,
+    unsigned long dwDesiredAccess,
+    unsigned long dwFileOffsetHigh,
+    unsigned long dwFileOffsetLow,
+    unsigned long dwNumberOfBytesToMap);
+
+RGF_PLATFORM_WIN32_API(int)
+UnmapViewOfFile(const void *lpBaseAddress);
+
 #endif /* _WINDOWS_ */
 
 RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_write(char *filename, unsigned char *buffer, unsigned long size)
@@ -149,12 +208,196 @@ RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_read(char *filename, unsig
     return 1;
 }
 
+/* Reads at most size bytes starting at offset without reading the rest of the file.
+   The buffer is not null-terminated, bytes_read is less than size at the end of the file.
+*/
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_read_range(char *filename, unsigned long offset, unsigned char *buffer, unsigned long size, unsigned long *bytes_read)
+{
+    void *hFile;
+    long offset_high = 0;
+    unsigned long result;
+    unsigned long total = 0;
+
+    hFile = CreateFileA(filename, RGF_PLATFORM_WIN32_GENERIC_READ, RGF_PLATFORM_WIN32_FILE_SHARE_READ, 0, RGF_PLATFORM_WIN32_OPEN_EXISTING, RGF_PLATFORM_WIN32_FILE_ATTRIBUTE_NORMAL, 0);
+
+    if (hFile == RGF_PLATFORM_WIN32_INVALID_HANDLE)
+    {
+        return 0;
+    }
+
+    if (SetFilePointer(hFile, (long)offset, &offset_high, RGF_PLATFORM_WIN32_FILE_BEGIN) == RGF_PLATFORM_WIN32_INVALID_SET_FILE_POINTER && GetLastError() != RGF_PLATFORM_WIN32_NO_ERROR)
+    {
+        CloseHandle(hFile);
+        return 0;
+    }
+
+    /* ReadFile may return less than requested before the end of the file */
+    while (total < size)
+    {
+        if (!ReadFile(hFile, buffer + total, size - total, &result, 0))
+        {
+            CloseHandle(hFile);
+            return 0;
+        }
+
+        if (result == 0)
+        {
+            break;
+        }
+
+        total += result;
+    }
+
+    *bytes_read = total;
+
+    CloseHandle(hFile);
+
+    return 1;
+}
+
+/* Maps the file read only instead of copying it, the buffer is not null-terminated.
+   Empty files can not be mapped and return 0. Release it with rgf_platform_unmap.
+*/
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_map(char *filename, unsigned char **file_buffer, unsigned long *file_buffer_size)
+{
+    void *hFile;
+    void *hMapping;
+    unsigned long fileSize;
+
+    hFile = CreateFileA(filename, RGF_PLATFORM_WIN32_GENERIC_READ, RGF_PLATFORM_WIN32_FILE_SHARE_READ, 0, RGF_PLATFORM_WIN32_OPEN_EXISTING, RGF_PLATFORM_WIN32_FILE_FLAG_SEQUENTIAL_SCAN, 0);
+
+    if (hFile == RGF_PLATFORM_WIN32_INVALID_HANDLE)
+    {
+        return 0;
+    }
+
+    fileSize = GetFileSize(hFile, 0);
+
+    if (fileSize == RGF_PLATFORM_WIN32_INVALID_FILE_SIZE || fileSize == 0)
+    {
+        CloseHandle(hFile);
+        return 0;
+    }
+
+    hMapping = CreateFileMappingA(hFile, 0, RGF_PLATFORM_WIN32_PAGE_READONLY, 0, 0, 0);
+    CloseHandle(hFile);
+
+    if (!hMapping)
+    {
+        return 0;
+    }
+
+    /* The view keeps the mapping alive */
+    *file_buffer = (unsigned char *)MapViewOfFile(hMapping, RGF_PLATFORM_WIN32_FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(hMapping);
+
+    if (!*file_buffer)
+    {
+        return 0;
+    }
+
+    *file_buffer_size = fileSize;
+
+    return 1;
+}
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE void rgf_platform_unmap(unsigned char *file_buffer, unsigned long file_buffer_size)
+{
+    (void)file_buffer_size;
+
+    UnmapViewOfFile(file_buffer);
+}
+
+/* A file that a binary is written to piece by piece (see rgf_binary_encode_stream) */
+typedef struct rgf_platform_writer
+{
+    void *handle;
+    rgf_platform_u64 position; /* Where the next append starts, WriteFile at an offset moves the file pointer */
+
+} rgf_platform_writer;
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_writer_open(rgf_platform_writer *writer, char *filename)
+{
+    writer->handle = CreateFileA(filename, RGF_PLATFORM_WIN32_GENERIC_WRITE, 0, 0, RGF_PLATFORM_WIN32_CREATE_ALWAYS, RGF_PLATFORM_WIN32_FILE_ATTRIBUTE_NORMAL, 0);
+    writer->position = 0;
+
+    return writer->handle != RGF_PLATFORM_WIN32_INVALID_HANDLE;
+}
+
+/* Writes a buffer at a 64 bit offset, WriteFile may write less than requested */
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_win32_write_at(void *hFile, rgf_platform_u64 offset, unsigned char *buffer, unsigned long size)
+{
+    rgf_platform_win32_overlapped overlapped = {0};
+    unsigned long bytes_written;
+    unsigned long total;
+
+    for (total = 0; total < size; total += bytes_written)
+    {
+        overlapped.Offset = (unsigned long)((offset + total) & 0xffffffffUL);
+        overlapped.OffsetHigh = (unsigned long)((offset + total) >> 32);
+
+        if (!WriteFile(hFile, buffer + total, size - total, &bytes_written, &overlapped) || bytes_written == 0)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* Appends the buffers in order, matches rgf_binary_write_function */
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_writer_write(void *writer, unsigned char **buffers, unsigned long *sizes, unsigned long count)
+{
+    rgf_platform_writer *file = (rgf_platform_writer *)writer;
+    unsigned long i;
+
+    for (i = 0; i < count; ++i)
+    {
+        if (!rgf_platform_win32_write_at(file->handle, file->position, buffers[i], sizes[i]))
+        {
+            return 0;
+        }
+
+        file->position += sizes[i];
+    }
+
+    return 1;
+}
+
+/* Writes a buffer at offset, rgf_platform_writer_write keeps appending behind the last
+   appended byte (the writer tracks that position itself)
+*/
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_writer_write_at(rgf_platform_writer *writer, rgf_platform_u64 offset, unsigned char *buffer, unsigned long size)
+{
+    return rgf_platform_win32_write_at(writer->handle, offset, buffer, size);
+}
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_writer_close(rgf_platform_writer *writer)
+{
+    return CloseHandle(writer->handle);
+}
+
 #elif defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__HAIKU__)
 
+/* Strict C89 builds hide madvise and pwrite on glibc and musl, request them before the first
+   system header. Programs that include system headers before this file (rgf.h does for the
+   SIMD intrinsics) have to define it themselves.
+*/
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+
+/* Included after a system header that hid it, pwrite can not be declared here */
+#if defined(__GLIBC__) && !defined(__USE_UNIX98) && !defined(__USE_XOPEN2K8)
+#error "rgf_platform_io: define _DEFAULT_SOURCE before including any system header (pwrite is hidden)"
+#endif
 
 RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_write(char *filename, unsigned char *buffer, unsigned long size)
 {
@@ -211,6 +454,188 @@ RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_read(char *filename, unsig
     return 1;
 }
 
+/* Reads at most size bytes starting at offset without reading the rest of the file.
+   The buffer is not null-terminated, bytes_read is less than size at the end of the file.
+*/
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_read_range(char *filename, unsigned long offset, unsigned char *buffer, unsigned long size, unsigned long *bytes_read)
+{
+    int fd;
+    ssize_t result;
+    unsigned long total = 0;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    if (lseek(fd, (off_t)offset, SEEK_SET) == (off_t)-1)
+    {
+        close(fd);
+        return 0;
+    }
+
+    /* read may return less than requested before the end of the file */
+    while (total < size)
+    {
+        result = read(fd, buffer + total, (size_t)(size - total));
+
+        if (result < 0)
+        {
+            close(fd);
+            return 0;
+        }
+
+        if (result == 0)
+        {
+            break;
+        }
+
+        total += (unsigned long)result;
+    }
+
+    *bytes_read = total;
+
+    close(fd);
+    return 1;
+}
+
+/* Maps the file read only instead of copying it, the buffer is not null-terminated.
+   Empty files can not be mapped and return 0. Release it with rgf_platform_unmap.
+*/
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_map(char *filename, unsigned char **file_buffer, unsigned long *file_buffer_size)
+{
+    int fd;
+    struct stat st;
+    void *mapping;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return 0;
+    }
+
+    mapping = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /* The mapping keeps the file open */
+
+    if (mapping == MAP_FAILED)
+    {
+        return 0;
+    }
+
+#ifdef MADV_SEQUENTIAL
+    /* Parsers read front to back: aggressive read ahead, start reading now */
+    madvise(mapping, (size_t)st.st_size, MADV_SEQUENTIAL);
+    madvise(mapping, (size_t)st.st_size, MADV_WILLNEED);
+#endif
+
+    *file_buffer = (unsigned char *)mapping;
+    *file_buffer_size = (unsigned long)st.st_size;
+
+    return 1;
+}
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE void rgf_platform_unmap(unsigned char *file_buffer, unsigned long file_buffer_size)
+{
+    munmap(file_buffer, (size_t)file_buffer_size);
+}
+
+/* A file that a binary is written to piece by piece (see rgf_binary_encode_stream) */
+typedef struct rgf_platform_writer
+{
+    int fd;
+
+} rgf_platform_writer;
+
+#ifndef RGF_PLATFORM_WRITER_IOVECS
+#define RGF_PLATFORM_WRITER_IOVECS 16
+#endif
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_writer_open(rgf_platform_writer *writer, char *filename)
+{
+    writer->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    return writer->fd >= 0;
+}
+
+/* Appends the buffers in order with one writev per RGF_PLATFORM_WRITER_IOVECS buffers,
+   matches rgf_binary_write_function
+*/
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_writer_write(void *writer, unsigned char **buffers, unsigned long *sizes, unsigned long count)
+{
+    int fd = ((rgf_platform_writer *)writer)->fd;
+    struct iovec iov[RGF_PLATFORM_WRITER_IOVECS];
+    unsigned long done = 0; /* Bytes of buffers[i] that are written */
+    unsigned long i = 0;
+    ssize_t written;
+    int n;
+
+    for (;;)
+    {
+        /* Skip the written (and empty) buffers */
+        while (i < count && done >= sizes[i])
+        {
+            done -= sizes[i];
+            ++i;
+        }
+
+        if (i == count)
+        {
+            return 1;
+        }
+
+        for (n = 0; n < RGF_PLATFORM_WRITER_IOVECS && i + (unsigned long)n < count; ++n)
+        {
+            iov[n].iov_base = buffers[i + (unsigned long)n] + (n == 0 ? done : 0);
+            iov[n].iov_len = (size_t)(sizes[i + (unsigned long)n] - (n == 0 ? done : 0));
+        }
+
+        written = writev(fd, iov, n);
+
+        if (written <= 0)
+        {
+            return 0;
+        }
+
+        /* writev may write less than requested, continue behind the last written byte */
+        done += (unsigned long)written;
+    }
+}
+
+/* Writes a buffer at offset without moving the append position (pwrite leaves the file
+   offset as it is), e.g. from multiple threads
+*/
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_writer_write_at(rgf_platform_writer *writer, rgf_platform_u64 offset, unsigned char *buffer, unsigned long size)
+{
+    unsigned long total = 0;
+    ssize_t written;
+
+    while (total < size)
+    {
+        written = pwrite(writer->fd, buffer + total, (size_t)(size - total), (off_t)(offset + total));
+
+        if (written <= 0)
+        {
+            return 0;
+        }
+
+        total += (unsigned long)written;
+    }
+
+    return 1;
+}
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE int rgf_platform_writer_close(rgf_platform_writer *writer)
+{
+    return close(writer->fd) == 0;
+}
+
 #else
 #error "rgf_platform_io: unsupported operating system. please provide your own write binary file implementation"
 #endif
@@ -0,0 +1,322 @@
+/* rgf_platform_thread.h - v0.2 - public domain data structures - nickscha 2025
+
+A C89 standard compliant, single header, nostdlib (no C Standard Library) job dispatcher for rgf_job_system using OS-specific thread APIs.
+
+Supports:
+ - Windows (Win32 API)
+ - Linux / macOS (POSIX threads)
+ - BSDs (FreeBSD, NetBSD, OpenBSD, Haiku)
+
+USAGE
+    rgf_platform_threads threads;
+    rgf_job_system jobs;
+
+    rgf_platform_threads_init(&threads, 0); // 0 = number of online processors
+    jobs.dispatch = rgf_platform_threads_dispatch;
+    jobs.dispatch_context = &threads;
+    jobs.thread_count = threads.thread_count;
+
+LICENSE
+
+  Placed in the public domain and also MIT licensed.
+  See end of file for detailed license information.
+
+*/
+#ifndef RGF_PLATFORM_THREAD_H
+#define RGF_PLATFORM_THREAD_H
+
+/* #############################################################################
+ * # COMPILER SETTINGS
+ * #############################################################################
+ */
+/* Check if using C99 or later (inline is supported) */
+#if __STDC_VERSION__ >= 199901L
+#define RGF_PLATFORM_INLINE inline
+#define RGF_PLATFORM_API extern
+#elif defined(__GNUC__) || defined(__clang__)
+#define RGF_PLATFORM_INLINE __inline__
+#define RGF_PLATFORM_API static
+#elif defined(_MSC_VER)
+#define RGF_PLATFORM_INLINE __inline
+#define RGF_PLATFORM_API static
+#else
+#define RGF_PLATFORM_INLINE
+#define RGF_PLATFORM_API static
+#endif
+
+#ifndef RGF_PLATFORM_THREADS_MAX
+#define RGF_PLATFORM_THREADS_MAX 64
+#endif
+
+typedef struct rgf_platform_threads
+{
+    unsigned long thread_count; /* Threads used per dispatch (including the calling thread) */
+
+} rgf_platform_threads;
+
+/* The work of one thread: jobs thread_index, thread_index + thread_count, ... */
+typedef struct rgf_platform_threads_work
+{
+    void (*job)(void *job_data, unsigned long job_index);
+    void *job_data;
+    unsigned long job_count;
+    unsigned long thread_index;
+    unsigned long thread_count;
+
+} rgf_platform_threads_work;
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE void rgf_platform_threads_run(rgf_platform_threads_work *work)
+{
+    unsigned long i;
+
+    for (i = work->thread_index; i < work->job_count; i += work->thread_count)
+    {
+        work->job(work->job_data, i);
+    }
+}
+
+#ifdef _WIN32
+
+#define RGF_PLATFORM_WIN32_INFINITE 0xFFFFFFFF
+#define RGF_PLATFORM_WIN32_ALL_PROCESSOR_GROUPS 0xFFFF
+
+#ifdef _WIN64
+#if defined(_MSC_VER)
+typedef unsigned __int64 rgf_platform_size;
+#else
+__extension__ typedef unsigned long long rgf_platform_size;
+#endif
+#else
+typedef unsigned long rgf_platform_size;
+#endif
+
+#ifndef _WINDOWS_
+#define RGF_PLATFORM_WIN32_THREAD_API(r) __declspec(dllimport) r __stdcall
+
+RGF_PLATFORM_WIN32_THREAD_API(void *)
+CreateThread(
+    void *lpThreadAttributes,
+    rgf_platform_size dwStackSize,
+    unsigned long(__stdcall *lpStartAddress)(void *),
+    void *lpParameter,
+    unsigned long dwCreationFlags,
+    unsigned long *lpThreadId);
+
+RGF_PLATFORM_WIN32_THREAD_API(unsigned long)
+WaitForSingleObject(
+    void *hHandle,
+    unsigned long dwMilliseconds);
+
+RGF_PLATFORM_WIN32_THREAD_API(int)
+CloseHandle(void *hObject);
+
+RGF_PLATFORM_WIN32_THREAD_API(unsigned long)
+GetActiveProcessorCount(unsigned short GroupNumber);
+
+#endif /* _WINDOWS_ */
+
+static unsigned long __stdcall rgf_platform_threads_entry(void *parameter)
+{
+    rgf_platform_threads_run((rgf_platform_threads_work *)parameter);
+    return 0;
+}
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE unsigned long rgf_platform_processor_count(void)
+{
+    unsigned long count = GetActiveProcessorCount(RGF_PLATFORM_WIN32_ALL_PROCESSOR_GROUPS);
+    return count > 0 ? count : 1;
+}
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE void rgf_platform_threads_dispatch(void *dispatch_context, void (*job)(void *job_data, unsigned long job_index), void *job_data, unsigned long job_count)
+{
+    rgf_platform_threads *threads = (rgf_platform_threads *)dispatch_context;
+    rgf_platform_threads_work work[RGF_PLATFORM_THREADS_MAX];
+    void *handles[RGF_PLATFORM_THREADS_MAX];
+    unsigned long thread_count = threads->thread_count;
+    unsigned long i;
+
+    if (job_count == 0)
+    {
+        return;
+    }
+
+    if (thread_count > job_count)
+    {
+        thread_count = job_count;
+    }
+
+    if (thread_count > RGF_PLATFORM_THREADS_MAX)
+    {
+        thread_count = RGF_PLATFORM_THREADS_MAX;
+    }
+
+    if (thread_count < 1)
+    {
+        thread_count = 1;
+    }
+
+    for (i = 0; i < thread_count; ++i)
+    {
+        work[i].job = job;
+        work[i].job_data = job_data;
+        work[i].job_count = job_count;
+        work[i].thread_index = i;
+        work[i].thread_count = thread_count;
+    }
+
+    /* Thread 0 is the calling thread, if a thread can not be created its jobs run here as well */
+    for (i = 1; i < thread_count; ++i)
+    {
+        handles[i] = CreateThread(0, 0, rgf_platform_threads_entry, &work[i], 0, 0);
+    }
+
+    rgf_platform_threads_run(&work[0]);
+
+    for (i = 1; i < thread_count; ++i)
+    {
+        if (handles[i])
+        {
+            WaitForSingleObject(handles[i], RGF_PLATFORM_WIN32_INFINITE);
+            CloseHandle(handles[i]);
+        }
+        else
+        {
+            rgf_platform_threads_run(&work[i]);
+        }
+    }
+}
+
+#elif defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__HAIKU__)
+
+#include <pthread.h>
+#include <unistd.h>
+
+static void *rgf_platform_threads_entry(void *parameter)
+{
+    rgf_platform_threads_run((rgf_platform_threads_work *)parameter);
+    return 0;
+}
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE unsigned long rgf_platform_processor_count(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned long)count : 1;
+}
+
+RGF_PLATFORM_API RGF_PLATFORM_INLINE void rgf_platform_threads_dispatch(void *dispatch_context, void (*job)(void *job_data, unsigned long job_index), void *job_data, unsigned long job_count)
+{
+    rgf_platform_threads *threads = (rgf_platform_threads *)dispatch_context;
+    rgf_platform_threads_work work[RGF_PLATFORM_THREADS_MAX];
+    pthread_t handles[RGF_PLATFORM_THREADS_MAX];
+    int created[RGF_PLATFORM_THREADS_MAX];
+    unsigned long thread_count = threads->thread_count;
+    unsigned long i;
+
+    if (job_count == 0)
+    {
+        return;
+    }
+
+    if (thread_count > job_count)
+    {
+        thread_count = job_count;
+    }
+
+    if (thread_count > RGF_PLATFORM_THREADS_MAX)
+    {
+        thread_count = RGF_PLATFORM_THREADS_MAX;
+    }
+
+    if (thread_count < 1)
+    {
+        thread_count = 1;
+    }
+
+    for (i = 0; i < thread_count; ++i)
+    {
+        work[i].job = job;
+        work[i].job_data = job_data;
+        work[i].job_count = job_count;
+        work[i].thread_index = i;
+        work[i].thread_count = thread_count;
+    }
+
+    /* Thread 0 is the calling thread, if a thread can not be created its jobs run here as well */
+    for (i = 1; i < thread_count; ++i)
+    {
+        created[i] = pthread_create(&handles[i], 0, rgf_platform_threads_entry, &work[i]) == 0;
+    }
+
+    rgf_platform_threads_run(&work[0]);
+
+    for (i = 1; i < thread_count; ++i)
+    {
+        if (created[i])
+        {
+            pthread_join(handles[i], 0);
+        }
+        else
+        {
+            rgf_platform_threads_run(&work[i]);
+        }
+    }
+}
+
+#else
+#error "rgf_platform_thread: unsupported operating system. please provide your own job dispatch implementation"
+#endif
+
+/* thread_count = 0 uses the number of online processors */
+RGF_PLATFORM_API RGF_PLATFORM_INLINE void rgf_platform_threads_init(rgf_platform_threads *threads, unsigned long thread_count)
+{
+    threads->thread_count = thread_count > 0 ? thread_count : rgf_platform_processor_count();
+
+    if (threads->thread_count > RGF_PLATFORM_THREADS_MAX)
+    {
+        threads->thread_count = RGF_PLATFORM_THREADS_MAX;
+    }
+}
+
+#endif /* RGF_PLATFORM_THREAD_H */
+
+/*
+   ------------------------------------------------------------------------------
+   This software is available under 2 licenses -- choose whichever you prefer.
+   ------------------------------------------------------------------------------
+   ALTERNATIVE A - MIT License
+   Copyright (c) 2025 nickscha
+   Permission is hereby granted, free of charge, to any person obtaining a copy of
+   this software and associated documentation files (the "Software"), to deal in
+   the Software without restriction, including without limitation the rights to
+   use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+   of the Software, and to permit persons to whom the Software is furnished to do
+   so, subject to the following conditions:
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+   ------------------------------------------------------------------------------
+   ALTERNATIVE B - Public Domain (www.unlicense.org)
+   This is free and unencumbered software released into the public domain.
+   Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+   software, either in source code form or as a compiled binary, for any purpose,
+   commercial or non-commercial, and by any means.
+   In jurisdictions that recognize copyright laws, the author or authors of this
+   software dedicate any and all copyright interest in the software to the public
+   domain. We make this dedication for the benefit of the public at large and to
+   the detriment of our heirs and successors. We intend this dedication to be an
+   overt act of relinquishment in perpetuity of all present and future rights to
+   this software under copyright law.
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+   WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+   ------------------------------------------------------------------------------
+*/
@@ -0,0 +1,1129 @@
+/* rgf.h - v0.2 - public domain data structures - nickscha 2025
+
+A C89 standard compliant, single header, nostdlib (no C Standard Library) raw geometry format (RGF).
+
+This Benchmark measures the throughput of the performance critical rgf functions against "head.obj"
+scaled up to RGF_BENCH_TARGET_SIZE bytes.
+
+LICENSE
+
+  Placed in the public domain and also MIT licensed.
+  See end of file for detailed license information.
+
+*/
+#ifndef _WIN32
+#define _DEFAULT_SOURCE /* clock_gettime and, for rgf_platform_io.h, madvise and pwrite */
+#endif
+
+#include "../rgf.h"                 /* Raw Geometry Format                                      */
+#include "../rgf_platform_io.h"     /* Optional: OS-Specific read/write file implementations    */
+#include "../rgf_platform_thread.h" /* Optional: OS-Specific job dispatcher for multi-threading */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef RGF_BENCH_TARGET_SIZE
+#define RGF_BENCH_TARGET_SIZE (1024UL * 1024UL * 1024UL)
+#endif
+
+#ifndef RGF_BENCH_RUNS
+#define RGF_BENCH_RUNS 3
+#endif
+
+#ifndef RGF_BENCH_ATOF_SIZE
+#define RGF_BENCH_ATOF_SIZE (256UL * 1024UL * 1024UL)
+#endif
+
+#ifndef RGF_BENCH_INDEX_DECODES
+#define RGF_BENCH_INDEX_DECODES 200
+#endif
+
+#define RGF_BENCH_OBJ_CAPACITY 1500000
+
+#ifdef _WIN32
+#ifndef _WINDOWS_
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(void *lpPerformanceCount);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(void *lpFrequency);
+#endif
+
+static double bench_time(void)
+{
+  rgf_u64 counter, frequency;
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  return (double)counter / (double)frequency;
+}
+#else
+#include <time.h>
+
+static double bench_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+#endif
+
+static void bench_report(char *name, unsigned long bytes, double seconds)
+{
+  printf("[BENCH] %-40s %10.3f ms %10.2f MB/s\n", name, seconds * 1000.0, ((double)bytes / (1024.0 * 1024.0)) / seconds);
+}
+
+/* The byte wise counting pass rgf_parse_obj used before rgf_obj_count */
+static void bench_obj_count_scalar(rgf_obj_counts *counts, unsigned char *obj_binary, unsigned long obj_binary_size)
+{
+  unsigned long i = 0;
+  int face_vertices_count;
+
+  counts->vertex_count = 0;
+  counts->uv_count = 0;
+  counts->triangle_count = 0;
+
+  while (i < obj_binary_size)
+  {
+    if (obj_binary[i] == 'v' && obj_binary[i + 1] == ' ')
+    {
+      counts->vertex_count++;
+    }
+    else if (obj_binary[i] == 'v' && obj_binary[i + 1] == 't')
+    {
+      counts->uv_count++;
+    }
+    else if (obj_binary[i] == 'f' && obj_binary[i + 1] == ' ')
+    {
+      unsigned long j = i + 2;
+
+      face_vertices_count = 0;
+
+      while (j < obj_binary_size && obj_binary[j] != '\n' && obj_binary[j] != '\r')
+      {
+        if ((obj_binary[j] >= '0' && obj_binary[j] <= '9') || obj_binary[j] == '-')
+        {
+          face_vertices_count++;
+          while (j < obj_binary_size && obj_binary[j] != ' ' && obj_binary[j] != '\n' && obj_binary[j] != '\r')
+          {
+            j++;
+          }
+        }
+        else
+        {
+          j++;
+        }
+      }
+
+      if (face_vertices_count >= 3)
+      {
+        counts->triangle_count += (unsigned long)(face_vertices_count - 2);
+      }
+    }
+
+    while (i < obj_binary_size && obj_binary[i] != '\n')
+    {
+      i++;
+    }
+    i++;
+  }
+}
+
+/* The multiply-add float parser rgf_atof used before rgf_atof_n (not correctly rounded, no exponents) */
+static float bench_atof_legacy(char *s, int *consumed)
+{
+  int i = 0;
+  int sign = 1;
+  float value = 0.0f;
+  float frac = 0.0f;
+  float divisor = 1.0f;
+
+  if (s[i] == '-')
+  {
+    sign = -1;
+    i++;
+  }
+  else if (s[i] == '+')
+  {
+    i++;
+  }
+
+  while (s[i] >= '0' && s[i] <= '9')
+  {
+    value = value * 10.0f + (float)(s[i] - '0');
+    i++;
+  }
+
+  if (s[i] == '.')
+  {
+    i++;
+    while (s[i] >= '0' && s[i] <= '9')
+    {
+      frac = frac * 10.0f + (float)(s[i] - '0');
+      divisor *= 10.0f;
+      i++;
+    }
+    value += frac / divisor;
+  }
+
+  *consumed = i;
+
+  return value * (float)sign;
+}
+
+/* Repeats head.obj until the buffer reaches RGF_BENCH_TARGET_SIZE */
+static unsigned char *bench_load_scaled_obj(unsigned long *size, unsigned long *copies)
+{
+  unsigned char *obj = malloc(RGF_BENCH_OBJ_CAPACITY);
+  unsigned long obj_size = 0;
+  unsigned char *scaled;
+  unsigned long i, j;
+
+  if (!obj || !rgf_platform_read("head.obj", obj, RGF_BENCH_OBJ_CAPACITY, &obj_size))
+  {
+    return 0;
+  }
+
+  /* Drop the trailing NUL bytes so that copies can be concatenated */
+  while (obj_size > 0 && obj[obj_size - 1] == '\0')
+  {
+    obj_size--;
+  }
+
+  *copies = RGF_BENCH_TARGET_SIZE / obj_size;
+  *size = *copies * obj_size;
+
+  /* One extra byte since the scalar reference pass peeks one byte past a line start */
+  scaled = malloc(*size + 1);
+
+  if (scaled)
+  {
+    for (i = 0; i < *copies; ++i)
+    {
+      for (j = 0; j < obj_size; ++j)
+      {
+        scaled[i * obj_size + j] = obj[j];
+      }
+    }
+    scaled[*size] = '\0';
+  }
+
+  free(obj);
+
+  return scaled;
+}
+
+static void bench_obj_count(unsigned char *obj, unsigned long obj_size, unsigned long copies)
+{
+  rgf_obj_counts reference, counts;
+  double best_reference = 1e30, best_counts = 1e30;
+  int run;
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start = bench_time();
+    double elapsed;
+
+    bench_obj_count_scalar(&reference, obj, obj_size);
+    elapsed = bench_time() - start;
+    best_reference = elapsed < best_reference ? elapsed : best_reference;
+
+    start = bench_time();
+    rgf_obj_count(&counts, obj, obj_size);
+    elapsed = bench_time() - start;
+    best_counts = elapsed < best_counts ? elapsed : best_counts;
+  }
+
+  bench_report("obj count (scalar reference)", obj_size, best_reference);
+  bench_report("rgf_obj_count", obj_size, best_counts);
+
+  printf("[BENCH] copies=%lu vertices=%lu uvs=%lu triangles=%lu speedup=%.2fx %s\n",
+         copies, counts.vertex_count, counts.uv_count, counts.triangle_count,
+         best_reference / best_counts,
+         (counts.vertex_count == reference.vertex_count &&
+          counts.uv_count == reference.uv_count &&
+          counts.triangle_count == reference.triangle_count)
+             ? "MATCH"
+             : "MISMATCH");
+}
+
+/* Parses every number that follows a space on a "v", "vt" or "vn" line, the values
+   rgf_parse_obj reads with rgf_atof_n (face indices use the integer parser) */
+static void bench_atof(unsigned char *obj, unsigned long obj_size)
+{
+  unsigned long size = obj_size < RGF_BENCH_ATOF_SIZE ? obj_size : RGF_BENCH_ATOF_SIZE;
+  double best_legacy = 1e30, best_atof = 1e30;
+  float sum_legacy = 0.0f, sum_atof = 0.0f;
+  unsigned long numbers = 0;
+  int run;
+
+  /* Whole lines only, so that the last number is not cut off */
+  while (size > 0 && obj[size - 1] != '\n')
+  {
+    size--;
+  }
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start = bench_time();
+    double elapsed;
+    unsigned long i;
+    int consumed;
+    int vertex_line = obj[0] == 'v';
+
+    for (i = 1; i < size; ++i)
+    {
+      if (obj[i - 1] == '\n')
+      {
+        vertex_line = obj[i] == 'v';
+      }
+      else if (vertex_line && obj[i - 1] == ' ' && (rgf_is_digit(obj[i]) || obj[i] == '-'))
+      {
+        sum_legacy += bench_atof_legacy((char *)(obj + i), &consumed);
+        i += (unsigned long)consumed;
+      }
+    }
+    elapsed = bench_time() - start;
+    best_legacy = elapsed < best_legacy ? elapsed : best_legacy;
+
+    start = bench_time();
+    numbers = 0;
+    vertex_line = obj[0] == 'v';
+    for (i = 1; i < size; ++i)
+    {
+      if (obj[i - 1] == '\n')
+      {
+        vertex_line = obj[i] == 'v';
+      }
+      else if (vertex_line && obj[i - 1] == ' ' && (rgf_is_digit(obj[i]) || obj[i] == '-'))
+      {
+        sum_atof += rgf_atof_n((char *)(obj + i), size - i, &consumed);
+        i += (unsigned long)consumed;
+        numbers++;
+      }
+    }
+    elapsed = bench_time() - start;
+    best_atof = elapsed < best_atof ? elapsed : best_atof;
+  }
+
+  bench_report("atof (multiply-add reference)", size, best_legacy);
+  bench_report("rgf_atof_n (correctly rounded)", size, best_atof);
+  printf("[BENCH] numbers=%lu speedup=%.2fx checksum=%f/%f\n", numbers, best_legacy / best_atof, (double)sum_legacy, (double)sum_atof);
+}
+
+static void bench_obj_parse(unsigned char *obj, unsigned long obj_size)
+{
+  rgf_obj_counts counts;
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+  rgf_model serial = {0};
+  rgf_model parallel = {0};
+  double best_serial = 1e30, best_parallel = 1e30;
+  unsigned long i;
+  int run, equal = 1;
+
+  rgf_obj_count(&counts, obj, obj_size);
+
+  serial.vertices = malloc(counts.vertex_count * 3 * sizeof(float));
+  serial.uvs = malloc(counts.uv_count * 2 * sizeof(float));
+  serial.indices = malloc(counts.triangle_count * 3 * sizeof(int));
+  parallel.vertices = malloc(counts.vertex_count * 3 * sizeof(float));
+  parallel.uvs = malloc(counts.uv_count * 2 * sizeof(float));
+  parallel.indices = malloc(counts.triangle_count * 3 * sizeof(int));
+
+  if (!serial.vertices || !serial.uvs || !serial.indices || !parallel.vertices || !parallel.uvs || !parallel.indices)
+  {
+    printf("[BENCH] out of memory for obj parse\n");
+    return;
+  }
+
+  rgf_platform_threads_init(&threads, 0);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start = bench_time();
+    double elapsed;
+
+    rgf_parse_obj(&serial, obj, obj_size);
+    elapsed = bench_time() - start;
+    best_serial = elapsed < best_serial ? elapsed : best_serial;
+
+    start = bench_time();
+    rgf_parse_obj_parallel(&parallel, obj, obj_size, &jobs);
+    elapsed = bench_time() - start;
+    best_parallel = elapsed < best_parallel ? elapsed : best_parallel;
+  }
+
+  for (i = 0; i < serial.vertices_size; ++i)
+  {
+    equal &= serial.vertices[i] == parallel.vertices[i];
+  }
+
+  for (i = 0; i < serial.indices_size; ++i)
+  {
+    equal &= serial.indices[i] == parallel.indices[i];
+  }
+
+  bench_report("rgf_parse_obj", obj_size, best_serial);
+  bench_report("rgf_parse_obj_parallel", obj_size, best_parallel);
+  printf("[BENCH] threads=%lu speedup=%.2fx %s\n", threads.thread_count, best_serial / best_parallel, equal ? "MATCH" : "MISMATCH");
+
+  free(serial.vertices);
+  free(serial.uvs);
+  free(serial.indices);
+  free(parallel.vertices);
+  free(parallel.uvs);
+  free(parallel.indices);
+}
+
+/* Size and decode throughput of the triangle index codec on the indices of head.obj */
+static void bench_index_codec(void)
+{
+  unsigned char *obj = malloc(RGF_BENCH_OBJ_CAPACITY);
+  unsigned long obj_size = 0;
+  rgf_obj_counts counts;
+  rgf_model model = {0};
+  unsigned char *encoded = 0;
+  unsigned long encoded_size = 0;
+  int *decoded = 0;
+  double best_encode = 1e30, best_decode = 1e30;
+  unsigned long triangles;
+  unsigned long i;
+  int run, equal = 1;
+
+  if (!obj || !rgf_platform_read("head.obj", obj, RGF_BENCH_OBJ_CAPACITY, &obj_size))
+  {
+    printf("[BENCH] could not load head.obj for the index codec\n");
+    free(obj);
+    return;
+  }
+
+  rgf_obj_count(&counts, obj, obj_size);
+
+  model.vertices = malloc(counts.vertex_count * 3 * sizeof(float));
+  model.indices = malloc(counts.triangle_count * 3 * sizeof(int));
+  decoded = malloc(counts.triangle_count * 3 * sizeof(int));
+  encoded = malloc(rgf_binary_triangles_bound(counts.triangle_count * 3));
+
+  if (!model.vertices || !model.indices || !decoded || !encoded || !rgf_parse_obj(&model, obj, obj_size))
+  {
+    printf("[BENCH] out of memory for the index codec\n");
+    return;
+  }
+
+  triangles = model.indices_size / 3;
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start = bench_time();
+    double elapsed;
+    int decode;
+
+    rgf_binary_encode_triangles(encoded, model.indices, model.indices_size, &encoded_size);
+    elapsed = bench_time() - start;
+    best_encode = elapsed < best_encode ? elapsed : best_encode;
+
+    start = bench_time();
+    for (decode = 0; decode < RGF_BENCH_INDEX_DECODES; ++decode)
+    {
+      equal &= rgf_binary_decode_triangles(decoded, encoded, encoded_size, model.indices_size);
+    }
+    elapsed = (bench_time() - start) / RGF_BENCH_INDEX_DECODES;
+    best_decode = elapsed < best_decode ? elapsed : best_decode;
+  }
+
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    equal &= decoded[i] == model.indices[i];
+  }
+
+  /* Throughput in decoded index bytes */
+  bench_report("rgf_binary_encode_triangles", model.indices_size * (unsigned long)sizeof(int), best_encode);
+  bench_report("rgf_binary_decode_triangles", model.indices_size * (unsigned long)sizeof(int), best_decode);
+  printf("[BENCH] triangles=%lu bytes=%lu bits/triangle=%.2f ratio=%.2fx %s\n",
+         triangles, encoded_size, (double)encoded_size * 8.0 / (double)triangles,
+         (double)(model.indices_size * sizeof(int)) / (double)encoded_size,
+         equal ? "MATCH" : "MISMATCH");
+
+  free(obj);
+  free(model.vertices);
+  free(model.indices);
+  free(decoded);
+  free(encoded);
+}
+
+static void bench_compression(unsigned char *obj, unsigned long obj_size)
+{
+  rgf_obj_counts counts;
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+  rgf_model model = {0};
+  rgf_model decoded = {0};
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  rgf_binary_section decompressed;
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+  unsigned long compressions[RGF_BINARY_SECTION_COUNT] = {0};
+  unsigned char *binary = 0;
+  unsigned char *out = 0;
+  unsigned long binary_capacity;
+  unsigned long binary_size = 0;
+  unsigned long sections_size = 0;
+  unsigned long raw_size;
+  double best_encode = 1e30, best_serial = 1e30, best_parallel = 1e30;
+  unsigned long i;
+  int run, equal = 1;
+
+  rgf_obj_count(&counts, obj, obj_size);
+
+  model.vertices = malloc(counts.vertex_count * 3 * sizeof(float));
+  model.indices = malloc(counts.triangle_count * 3 * sizeof(int));
+  raw_size = counts.vertex_count * 3 * sizeof(float);
+  binary_capacity = RGF_BINARY_SIZE_HEADER_MAX + 2 * RGF_BINARY_ALIGNMENT + rgf_binary_compressed_bound(raw_size) +
+                    rgf_binary_compressed_bound(rgf_binary_triangles_bound(counts.triangle_count * 3));
+  binary = malloc(binary_capacity);
+  out = malloc(raw_size);
+
+  if (!model.vertices || !model.indices || !binary || !out || !rgf_parse_obj(&model, obj, obj_size))
+  {
+    printf("[BENCH] out of memory for compression\n");
+    return;
+  }
+
+  rgf_platform_threads_init(&threads, 0);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_TRIANGLE_FIFO;
+  compressions[RGF_BINARY_SECTION_VERTICES] = RGF_BINARY_COMPRESSION_LZ;
+  compressions[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_COMPRESSION_LZ;
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start = bench_time();
+    double elapsed;
+
+    equal &= rgf_binary_encode_sections(binary, binary_capacity, &binary_size, &model, encodings, compressions, 0);
+    elapsed = bench_time() - start;
+    best_encode = elapsed < best_encode ? elapsed : best_encode;
+
+    equal &= rgf_binary_decode_header(binary, binary_size, &decoded, sections, &sections_size);
+
+    start = bench_time();
+    equal &= rgf_binary_decompress_section(&sections[0], binary + sections[0].offset, out, raw_size, &decompressed);
+    elapsed = bench_time() - start;
+    best_serial = elapsed < best_serial ? elapsed : best_serial;
+
+    start = bench_time();
+    equal &= rgf_binary_decompress_section_parallel(&sections[0], binary + sections[0].offset, out, raw_size, &decompressed, &jobs);
+    elapsed = bench_time() - start;
+    best_parallel = elapsed < best_parallel ? elapsed : best_parallel;
+  }
+
+  equal &= rgf_binary_decode_section(&decoded, &decompressed, out);
+
+  for (i = 0; equal && i < model.vertices_size; ++i)
+  {
+    equal &= decoded.vertices[i] == model.vertices[i];
+  }
+
+  /* Throughput in decompressed vertex bytes */
+  bench_report("rgf_binary_encode_sections (lz)", raw_size + model.indices_size * (unsigned long)sizeof(int), best_encode);
+  bench_report("rgf_binary_decompress_section", raw_size, best_serial);
+  bench_report("rgf_binary_decompress_section_parallel", raw_size, best_parallel);
+  printf("[BENCH] threads=%lu vertices ratio=%.2fx indices ratio=%.2fx speedup=%.2fx %s\n",
+         threads.thread_count, (double)raw_size / (double)sections[0].size,
+         (double)(model.indices_size * sizeof(int)) / (double)sections[1].size,
+         best_serial / best_parallel, equal ? "MATCH" : "MISMATCH");
+
+  free(model.vertices);
+  free(model.indices);
+  free(binary);
+  free(out);
+}
+
+/* The byte wise copy rgf_binary_memcpy used before */
+static void bench_memcpy_bytewise(unsigned char *dest, unsigned char *src, unsigned long count)
+{
+  while (count--)
+  {
+    *dest++ = *src++;
+  }
+}
+
+static void bench_binary_copy(unsigned char *obj, unsigned long obj_size)
+{
+  rgf_obj_counts counts;
+  rgf_model model = {0};
+  rgf_model decoded = {0};
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned char *binary = 0;
+  unsigned char *out = 0;
+  unsigned long binary_capacity;
+  unsigned long binary_size = 0;
+  unsigned long sections_size = 0;
+  unsigned long raw_size;
+  double best_bytewise = 1e30, best_memcpy = 1e30, best_encode = 1e30, best_decode = 1e30;
+  unsigned long i;
+  int run, equal = 1;
+
+  rgf_obj_count(&counts, obj, obj_size);
+
+  model.vertices = malloc(counts.vertex_count * 3 * sizeof(float));
+  model.indices = malloc(counts.triangle_count * 3 * sizeof(int));
+  raw_size = (counts.vertex_count * 3 + counts.triangle_count * 3) * 4;
+  binary_capacity = RGF_BINARY_SIZE_HEADER_MAX + 3 * RGF_BINARY_ALIGNMENT + raw_size;
+  binary = malloc(binary_capacity);
+  out = malloc(raw_size);
+
+  if (!model.vertices || !model.indices || !binary || !out || !rgf_parse_obj(&model, obj, obj_size))
+  {
+    printf("[BENCH] out of memory for binary copy\n");
+    return;
+  }
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start = bench_time();
+    double elapsed;
+
+    bench_memcpy_bytewise(binary, (unsigned char *)model.vertices, model.vertices_size * 4);
+    elapsed = bench_time() - start;
+    best_bytewise = elapsed < best_bytewise ? elapsed : best_bytewise;
+
+    start = bench_time();
+    rgf_binary_memcpy(binary, model.vertices, model.vertices_size * 4);
+    elapsed = bench_time() - start;
+    best_memcpy = elapsed < best_memcpy ? elapsed : best_memcpy;
+
+    start = bench_time();
+    equal &= rgf_binary_encode(binary, binary_capacity, &binary_size, &model);
+    elapsed = bench_time() - start;
+    best_encode = elapsed < best_encode ? elapsed : best_encode;
+
+    /* Decoding into separate arrays copies every raw section */
+    start = bench_time();
+    equal &= rgf_binary_decode_header(binary, binary_size, &decoded, sections, &sections_size);
+
+    for (i = 0; i < sections_size; ++i)
+    {
+      equal &= rgf_binary_decode_section_to(&decoded, &sections[i], binary + sections[i].offset, i == 0 ? out : out + sections[0].size);
+    }
+
+    elapsed = bench_time() - start;
+    best_decode = elapsed < best_decode ? elapsed : best_decode;
+  }
+
+  for (i = 0; equal && i < model.vertices_size; ++i)
+  {
+    equal &= decoded.vertices[i] == model.vertices[i];
+  }
+
+  for (i = 0; equal && i < model.indices_size; ++i)
+  {
+    equal &= rgf_model_index(&decoded, i) == (unsigned long)model.indices[i];
+  }
+
+  bench_report("copy (byte loop reference)", model.vertices_size * 4, best_bytewise);
+  bench_report("rgf_binary_memcpy", model.vertices_size * 4, best_memcpy);
+  bench_report("rgf_binary_encode (raw)", binary_size, best_encode);
+  bench_report("rgf_binary_decode_section_to (raw)", raw_size, best_decode);
+  printf("[BENCH] memcpy speedup=%.2fx %s\n", best_bytewise / best_memcpy, equal ? "MATCH" : "MISMATCH");
+
+  free(model.vertices);
+  free(model.indices);
+  free(binary);
+  free(out);
+}
+
+/* The per vertex comparisons rgf_model_calculate_boundaries used before */
+static void bench_bounds_scalar(float *min, float *max, float *vertices, unsigned long count)
+{
+  unsigned long i;
+
+  for (i = 0; i < count; i += 3)
+  {
+    if (vertices[i] < min[0])
+    {
+      min[0] = vertices[i];
+    }
+    if (vertices[i] > max[0])
+    {
+      max[0] = vertices[i];
+    }
+    if (vertices[i + 1] < min[1])
+    {
+      min[1] = vertices[i + 1];
+    }
+    if (vertices[i + 1] > max[1])
+    {
+      max[1] = vertices[i + 1];
+    }
+    if (vertices[i + 2] < min[2])
+    {
+      min[2] = vertices[i + 2];
+    }
+    if (vertices[i + 2] > max[2])
+    {
+      max[2] = vertices[i + 2];
+    }
+  }
+}
+
+static void bench_bounds(unsigned char *obj, unsigned long obj_size)
+{
+  rgf_obj_counts counts;
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+  rgf_model model = {0};
+  float reference_min[3], reference_max[3];
+  float simd_min[3], simd_max[3];
+  float parallel_min[3], parallel_max[3];
+  double best_scalar = 1e30, best_simd = 1e30, best_parallel = 1e30;
+  unsigned long bytes;
+  int run, k, equal = 1;
+
+  rgf_obj_count(&counts, obj, obj_size);
+
+  model.vertices = malloc(counts.vertex_count * 3 * sizeof(float));
+  model.indices = malloc(counts.triangle_count * 3 * sizeof(int));
+
+  if (!model.vertices || !model.indices || !rgf_parse_obj(&model, obj, obj_size))
+  {
+    printf("[BENCH] out of memory for bounds\n");
+    return;
+  }
+
+  rgf_platform_threads_init(&threads, 0);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start;
+    double elapsed;
+
+    for (k = 0; k < 3; ++k)
+    {
+      reference_min[k] = simd_min[k] = parallel_min[k] = 1e30f;
+      reference_max[k] = simd_max[k] = parallel_max[k] = -1e30f;
+    }
+
+    start = bench_time();
+    bench_bounds_scalar(reference_min, reference_max, model.vertices, model.vertices_size);
+    elapsed = bench_time() - start;
+    best_scalar = elapsed < best_scalar ? elapsed : best_scalar;
+
+    start = bench_time();
+    rgf_bounds_reduce(simd_min, simd_max, model.vertices, model.vertices_size);
+    elapsed = bench_time() - start;
+    best_simd = elapsed < best_simd ? elapsed : best_simd;
+
+    start = bench_time();
+    rgf_bounds_reduce_parallel(parallel_min, parallel_max, model.vertices, model.vertices_size, &jobs);
+    elapsed = bench_time() - start;
+    best_parallel = elapsed < best_parallel ? elapsed : best_parallel;
+  }
+
+  for (k = 0; k < 3; ++k)
+  {
+    equal &= simd_min[k] == reference_min[k] && simd_max[k] == reference_max[k];
+    equal &= parallel_min[k] == reference_min[k] && parallel_max[k] == reference_max[k];
+  }
+
+  bytes = model.vertices_size * (unsigned long)sizeof(float);
+  bench_report("bounds (per vertex reference)", bytes, best_scalar);
+  bench_report("rgf_bounds_reduce", bytes, best_simd);
+  bench_report("rgf_bounds_reduce_parallel", bytes, best_parallel);
+  printf("[BENCH] threads=%lu simd speedup=%.2fx parallel speedup=%.2fx %s\n", threads.thread_count,
+         best_scalar / best_simd, best_scalar / best_parallel, equal ? "MATCH" : "MISMATCH");
+
+  free(model.vertices);
+  free(model.indices);
+}
+
+/* rgf_v3_normalize before the batch kernel: five newton steps from f / 2 per vector */
+static void bench_normalize_legacy(float *out, float *v, unsigned long count)
+{
+  unsigned long i;
+
+  for (i = 0; i + 3 <= count; i += 3)
+  {
+    float f = v[i] * v[i] + v[i + 1] * v[i + 1] + v[i + 2] * v[i + 2];
+    float length = f / 2.0f;
+
+    length = 0.5f * (length + f / length);
+    length = 0.5f * (length + f / length);
+    length = 0.5f * (length + f / length);
+    length = 0.5f * (length + f / length);
+    length = 0.5f * (length + f / length);
+
+    if (length > 0.0f)
+    {
+      float inv_length = 1.0f / length;
+
+      out[i] = v[i] * inv_length;
+      out[i + 1] = v[i + 1] * inv_length;
+      out[i + 2] = v[i + 2] * inv_length;
+    }
+    else
+    {
+      out[i] = out[i + 1] = out[i + 2] = 0.0f;
+    }
+  }
+}
+
+/* |length^2 - 1| of a vector in double precision */
+static double bench_length_error(float *v)
+{
+  double x = (double)v[0];
+  double y = (double)v[1];
+  double z = (double)v[2];
+  double length_squared = x * x + y * y + z * z;
+
+  return length_squared > 1.0 ? length_squared - 1.0 : 1.0 - length_squared;
+}
+
+static void bench_normalize(void)
+{
+  unsigned long count = 3UL * 1000000UL;
+  float *vectors = malloc(count * sizeof(float));
+  float *legacy = malloc(count * sizeof(float));
+  float *batch = malloc(count * sizeof(float));
+  double best_legacy = 1e30, best_batch = 1e30;
+  double legacy_error = 0.0, batch_error = 0.0;
+  unsigned long seed = 12345;
+  unsigned long i;
+  int run;
+
+  if (!vectors || !legacy || !batch)
+  {
+    printf("[BENCH] out of memory for normalize\n");
+    return;
+  }
+
+  /* Unnormalized sums like the ones of the normal passes, lengths up to 1000 */
+  for (i = 0; i < count; ++i)
+  {
+    seed = (seed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+    vectors[i] = (float)seed / 2147483648.0f * 1000.0f - 500.0f;
+  }
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start;
+    double elapsed;
+
+    start = bench_time();
+    bench_normalize_legacy(legacy, vectors, count);
+    elapsed = bench_time() - start;
+    best_legacy = elapsed < best_legacy ? elapsed : best_legacy;
+
+    start = bench_time();
+    rgf_v3_normalize_batch(batch, vectors, count);
+    elapsed = bench_time() - start;
+    best_batch = elapsed < best_batch ? elapsed : best_batch;
+  }
+
+  /* Largest deviation of the lengths from 1 */
+  for (i = 0; i < count; i += 3)
+  {
+    double l = bench_length_error(legacy + i);
+    double b = bench_length_error(batch + i);
+
+    legacy_error = l > legacy_error ? l : legacy_error;
+    batch_error = b > batch_error ? b : batch_error;
+  }
+
+  bench_report("normalize (5 newton sqrt)", count * (unsigned long)sizeof(float), best_legacy);
+  bench_report("rgf_v3_normalize_batch", count * (unsigned long)sizeof(float), best_batch);
+  printf("[BENCH] speedup=%.2fx max |length^2 - 1| legacy=%.2e batch=%.2e\n", best_legacy / best_batch, legacy_error, batch_error);
+
+  free(vectors);
+  free(legacy);
+  free(batch);
+}
+
+static void bench_normals(unsigned char *obj, unsigned long obj_size)
+{
+  rgf_obj_counts counts;
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+  rgf_model model = {0};
+  float *scatter_normals;
+  double best_scatter = 1e30, best_build = 1e30, best_gather = 1e30, best_angle = 1e30;
+  unsigned long bytes;
+  unsigned long i;
+  int run, equal = 1;
+
+  rgf_obj_count(&counts, obj, obj_size);
+
+  model.vertices = malloc(counts.vertex_count * 3 * sizeof(float));
+  model.indices = malloc(counts.triangle_count * 3 * sizeof(int));
+  model.normals = malloc(counts.vertex_count * 3 * sizeof(float));
+  scatter_normals = malloc(counts.vertex_count * 3 * sizeof(float));
+
+  if (!model.vertices || !model.indices || !model.normals || !scatter_normals || !rgf_parse_obj(&model, obj, obj_size))
+  {
+    printf("[BENCH] out of memory for normals\n");
+    return;
+  }
+
+  model.adjacency_offsets = malloc((model.vertices_size / 3 + 1) * sizeof(unsigned int));
+  model.adjacency_triangles = malloc(model.indices_size * sizeof(unsigned int));
+
+  if (!model.adjacency_offsets || !model.adjacency_triangles)
+  {
+    printf("[BENCH] out of memory for normals\n");
+    return;
+  }
+
+  rgf_platform_threads_init(&threads, 0);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    unsigned int *offsets = model.adjacency_offsets;
+    double start;
+    double elapsed;
+
+    /* Without adjacency buffers the normals are scattered per triangle */
+    model.adjacency_offsets = 0;
+    start = bench_time();
+    rgf_model_calculate_normals(&model);
+    elapsed = bench_time() - start;
+    best_scatter = elapsed < best_scatter ? elapsed : best_scatter;
+    model.adjacency_offsets = offsets;
+
+    for (i = 0; i < model.vertices_size; ++i)
+    {
+      scatter_normals[i] = model.normals[i];
+    }
+
+    start = bench_time();
+    rgf_model_build_adjacency(&model);
+    elapsed = bench_time() - start;
+    best_build = elapsed < best_build ? elapsed : best_build;
+
+    start = bench_time();
+    rgf_model_calculate_normals_parallel(&model, &jobs);
+    elapsed = bench_time() - start;
+    best_gather = elapsed < best_gather ? elapsed : best_gather;
+  }
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= model.normals[i] == scatter_normals[i];
+  }
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start = bench_time();
+    double elapsed;
+
+    rgf_model_calculate_normals_weighted(&model, RGF_NORMALS_WEIGHT_ANGLE, &jobs);
+    elapsed = bench_time() - start;
+    best_angle = elapsed < best_angle ? elapsed : best_angle;
+  }
+
+  bytes = model.indices_size * (unsigned long)sizeof(int);
+  bench_report("rgf_model_calculate_normals (scatter)", bytes, best_scatter);
+  bench_report("rgf_model_build_adjacency", bytes, best_build);
+  bench_report("rgf_model_calculate_normals_parallel", bytes, best_gather);
+  bench_report("rgf_model_calculate_normals_weighted angle", bytes, best_angle);
+  printf("[BENCH] threads=%lu gather speedup=%.2fx (%.2fx with the build) %s\n", threads.thread_count,
+         best_scatter / best_gather, best_scatter / (best_build + best_gather), equal ? "MATCH" : "MISMATCH");
+
+  free(model.vertices);
+  free(model.indices);
+  free(model.normals);
+  free(model.adjacency_offsets);
+  free(model.adjacency_triangles);
+  free(scatter_normals);
+}
+
+static void bench_encode_parallel(unsigned char *obj, unsigned long obj_size)
+{
+  rgf_obj_counts counts;
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+  rgf_model model = {0};
+  rgf_model decoded = {0};
+  rgf_model parallel = {0};
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+  unsigned char *binary = 0;
+  unsigned char *parallel_binary = 0;
+  unsigned char *out = 0;
+  unsigned long binary_capacity;
+  unsigned long out_capacity;
+  unsigned long binary_size = 0;
+  unsigned long parallel_size = 0;
+  unsigned long sections_size = 0;
+  unsigned long used;
+  double best_encode = 1e30, best_encode_parallel = 1e30, best_decode = 1e30, best_decode_parallel = 1e30;
+  unsigned long i;
+  int run, equal = 1;
+
+  rgf_obj_count(&counts, obj, obj_size);
+
+  model.vertices = malloc(counts.vertex_count * 3 * sizeof(float));
+  model.normals = malloc(counts.vertex_count * 3 * sizeof(float));
+  model.indices = malloc(counts.triangle_count * 3 * sizeof(int));
+  binary_capacity = RGF_BINARY_SIZE_HEADER_MAX + 4 * RGF_BINARY_ALIGNMENT + counts.vertex_count * 3 * 4 + rgf_binary_triangles_bound(counts.triangle_count * 3);
+  out_capacity = 4 * RGF_BINARY_ALIGNMENT + (counts.vertex_count * 6 + counts.triangle_count * 3) * 4;
+  binary = malloc(binary_capacity);
+  parallel_binary = malloc(binary_capacity);
+  out = malloc(2 * out_capacity);
+
+  if (!model.vertices || !model.normals || !model.indices || !binary || !parallel_binary || !out || !rgf_parse_obj(&model, obj, obj_size))
+  {
+    printf("[BENCH] out of memory for parallel encode\n");
+    return;
+  }
+
+  model.normals_size = model.vertices_size;
+  rgf_model_calculate_normals(&model);
+  rgf_model_calculate_boundaries(&model);
+
+  rgf_platform_threads_init(&threads, 0);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  encodings[RGF_BINARY_SECTION_VERTICES] = RGF_BINARY_ENCODING_UNORM16;
+  encodings[RGF_BINARY_SECTION_NORMALS] = RGF_BINARY_ENCODING_OCTAHEDRAL;
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_TRIANGLE_FIFO;
+
+  for (run = 0; run < RGF_BENCH_RUNS; ++run)
+  {
+    double start = bench_time();
+    double elapsed;
+
+    equal &= rgf_binary_encode_sections(binary, binary_capacity, &binary_size, &model, encodings, 0, 0);
+    elapsed = bench_time() - start;
+    best_encode = elapsed < best_encode ? elapsed : best_encode;
+
+    start = bench_time();
+    equal &= rgf_binary_encode_sections_parallel(parallel_binary, binary_capacity, &parallel_size, &model, encodings, 0, 0, &jobs);
+    elapsed = bench_time() - start;
+    best_encode_parallel = elapsed < best_encode_parallel ? elapsed : best_encode_parallel;
+
+    start = bench_time();
+    equal &= rgf_binary_decode_header(binary, binary_size, &decoded, sections, &sections_size);
+
+    for (i = 0, used = 0; i < sections_size; ++i)
+    {
+      equal &= rgf_binary_decode_section_to(&decoded, &sections[i], binary + sections[i].offset, out + used);
+      used = rgf_binary_align(used + rgf_binary_section_decoded_size(&sections[i]));
+    }
+
+    elapsed = bench_time() - start;
+    best_decode = elapsed < best_decode ? elapsed : best_decode;
+
+    start = bench_time();
+    equal &= rgf_binary_decode_parallel(parallel_binary, parallel_size, &parallel, out + out_capacity, out_capacity, &jobs);
+    elapsed = bench_time() - start;
+    best_decode_parallel = elapsed < best_decode_parallel ? elapsed : best_decode_parallel;
+  }
+
+  equal &= binary_size == parallel_size;
+
+  for (i = 0; equal && i < binary_size; ++i)
+  {
+    equal &= binary[i] == parallel_binary[i];
+  }
+
+  for (i = 0; equal && i < model.vertices_size; ++i)
+  {
+    equal &= decoded.vertices[i] == parallel.vertices[i] && decoded.normals[i] == parallel.normals[i];
+  }
+
+  /* Throughput in raw model bytes */
+  used = (model.vertices_size + model.normals_size + model.indices_size) * 4;
+  bench_report("rgf_binary_encode_sections (quantized)", used, best_encode);
+  bench_report("rgf_binary_encode_sections_parallel", used, best_encode_parallel);
+  bench_report("rgf_binary_decode_section_to (quantized)", used, best_decode);
+  bench_report("rgf_binary_decode_parallel", used, best_decode_parallel);
+  printf("[BENCH] threads=%lu encode speedup=%.2fx decode speedup=%.2fx %s\n", threads.thread_count,
+         best_encode / best_encode_parallel, best_decode / best_decode_parallel, equal ? "MATCH" : "MISMATCH");
+
+  free(model.vertices);
+  free(model.normals);
+  free(model.indices);
+  free(binary);
+  free(parallel_binary);
+  free(out);
+}
+
+int main(void)
+{
+  unsigned long obj_size = 0;
+  unsigned long copies = 0;
+  unsigned char *obj = bench_load_scaled_obj(&obj_size, &copies);
+
+  if (!obj)
+  {
+    printf("[BENCH] could not load head.obj\n");
+    return 1;
+  }
+
+  bench_obj_count(obj, obj_size, copies);
+  bench_atof(obj, obj_size);
+  bench_obj_parse(obj, obj_size);
+  bench_index_codec();
+  bench_compression(obj, obj_size);
+  bench_binary_copy(obj, obj_size);
+  bench_encode_parallel(obj, obj_size);
+  bench_bounds(obj, obj_size);
+  bench_normalize();
+  bench_normals(obj, obj_size);
+
+  free(obj);
+
+  return 0;
+}
+
+/*
+   ------------------------------------------------------------------------------
+   This software is available under 2 licenses -- choose whichever you prefer.
+   ------------------------------------------------------------------------------
+   ALTERNATIVE A - MIT License
+   Copyright (c) 2025 nickscha
+   Permission is hereby granted, free of charge, to any person obtaining a copy of
+   this software and associated documentation files (the "Software"), to deal in
+   the Software without restriction, including without limitation the rights to
+   use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+   of the Software, and to permit persons to whom the Software is furnished to do
+   so, subject to the following conditions:
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+   ------------------------------------------------------------------------------
+   ALTERNATIVE B - Public Domain (www.unlicense.org)
+   This is free and unencumbered software released into the public domain.
+   Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+   software, either in source code form or as a compiled binary, for any purpose,
+   commercial or non-commercial, and by any means.
+   In jurisdictions that recognize copyright laws, the author or authors of this
+   software dedicate any and all copyright interest in the software to the public
+   domain. We make this dedication for the benefit of the public at large and to
+   the detriment of our heirs and successors. We intend this dedication to be an
+   overt act of relinquishment in perpetuity of all present and future rights to
+   this software under copyright law.
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+   WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+   ------------------------------------------------------------------------------
+*/
@@ -10,8 +10,15 @@ LICENSE
   See end of file for detailed license information.
 
 */
-#include "../rgf.h"             /* Raw Geometry Format                                   */
-#include "../rgf_platform_io.h" /* Optional: OS-Specific read/write file implementations */
+#ifndef _WIN32
+#define _DEFAULT_SOURCE /* Before the SIMD intrinsics of rgf.h pull in system headers, see rgf_platform_io.h */
+#endif
+
+#define RGF_GATHER_JOB_VERTICES 1024 /* Split the gather passes of head.obj over the jobs */
+
+#include "../rgf.h"                 /* Raw Geometry Format                                      */
+#include "../rgf_platform_io.h"     /* Optional: OS-Specific read/write file implementations    */
+#include "../rgf_platform_thread.h" /* Optional: OS-Specific job dispatcher for multi-threading */
 
 #include "test.h" /* Simple Testing framework */
 
@@ -20,13 +27,15 @@ LICENSE
 
 void rgf_test_encode_decode(void)
 {
-  /* The encoded model data */
-  unsigned char binary_buffer[BINARY_BUFFER_CAPACITY];
+  /* The encoded model data (decoding needs an aligned buffer) */
+  rgf_u64 binary_memory[BINARY_BUFFER_CAPACITY / 8];
+  unsigned char *binary_buffer = (unsigned char *)binary_memory;
   unsigned long binary_buffer_size = 0;
 
   /* Setup of the rgf model data */
   float vertices[] = {1.0f, 0.0f};
   int indices[] = {0, 1};
+  rgf_submesh submeshes[2] = {{0, 1, 7}, {1, 1, 9}};
 
   rgf_model binary_model = {0};
 
@@ -58,6 +67,211 @@ void rgf_test_encode_decode(void)
 
   assert(binary_model.vertices_size == model.vertices_size);
   assert(binary_model.indices_size == model.indices_size);
+  assert(!(binary_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED));
+  assert(binary_model.submeshes_size == 0);
+
+  /* Fixed little endian header and directory, every section starts aligned */
+  model.submeshes_size = 2;
+  model.submeshes = submeshes;
+  model.flags = RGF_MODEL_FLAG_NORMALS_PROVIDED;
+  model.max_x = 1.0f;
+
+  assert(rgf_binary_encode(binary_buffer, BINARY_BUFFER_CAPACITY, &binary_buffer_size, &model));
+
+  assert(binary_buffer_size == 6 * RGF_BINARY_ALIGNMENT + 2 * sizeof(rgf_submesh));
+  assert(binary_buffer[8] == 1);
+  assert(binary_buffer[12] == 3);
+  assert(binary_buffer[16 + 3 * 4 + 2] == 0x80 && binary_buffer[16 + 3 * 4 + 3] == 0x3F);
+  assert(binary_buffer[80 + 40] == RGF_BINARY_SECTION_INDICES);
+  assert(binary_buffer[80 + 40 + 4] == RGF_BINARY_ENCODING_RAW);
+  assert(binary_buffer[80 + 40 + 8] == 0x40 && binary_buffer[80 + 40 + 9] == 0x01);
+  assert(binary_buffer[80 + 40 + 16] == 8);
+  assert(binary_buffer[80 + 40 + 24] == 2);
+  assert(binary_buffer[4 * RGF_BINARY_ALIGNMENT + 4] == 0);
+  assert(binary_buffer[4 * RGF_BINARY_ALIGNMENT + 3] == 0x3F);
+
+  assert(rgf_binary_decode(binary_buffer, binary_buffer_size, &binary_model));
+
+  /* The arrays point into the binary */
+  assert((unsigned char *)binary_model.vertices == binary_buffer + 4 * RGF_BINARY_ALIGNMENT);
+  assert((unsigned char *)binary_model.indices == binary_buffer + 5 * RGF_BINARY_ALIGNMENT);
+  assert((unsigned char *)binary_model.submeshes == binary_buffer + 6 * RGF_BINARY_ALIGNMENT);
+  assert(binary_model.vertices[0] == 1.0f);
+  assert(binary_model.indices[1] == 1);
+  assert(binary_model.max_x == 1.0f);
+
+  /* Only set when the normals section is decoded */
+  assert(!(binary_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED));
+
+  assert(binary_model.submeshes_size == 2);
+  assert(binary_model.submeshes[1].index_offset == 1);
+  assert(binary_model.submeshes[1].index_count == 1);
+  assert(binary_model.submeshes[1].material_hash == 9);
+
+  /* Truncated and unaligned binaries are rejected */
+  assert(!rgf_binary_decode(binary_buffer, binary_buffer_size - 1, &binary_model));
+  assert(!rgf_binary_decode(binary_buffer, RGF_BINARY_SIZE_HEADER_V2 + 3 * RGF_BINARY_SIZE_DIRECTORY_ENTRY - 1, &binary_model));
+
+  rgf_binary_memcpy(binary_buffer + 513, binary_buffer, binary_buffer_size);
+  assert(!rgf_binary_decode(binary_buffer + 513, binary_buffer_size, &binary_model));
+}
+
+void rgf_test_decode_sections(void)
+{
+  rgf_u64 binary_memory[BINARY_BUFFER_CAPACITY / 8];
+  unsigned char *binary_buffer = (unsigned char *)binary_memory;
+  unsigned long binary_buffer_size = 0;
+
+  float vertices[] = {1.0f, 0.0f, 2.0f};
+  float normals[] = {0.0f, 1.0f, 0.0f};
+  int indices[] = {0, 0, 0};
+
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long sections_size = 0;
+
+  rgf_model binary_model = {0};
+
+  rgf_model model = {0};
+  model.vertices_size = 3;
+  model.normals_size = 3;
+  model.indices_size = 3;
+  model.vertices = vertices;
+  model.normals = normals;
+  model.indices = indices;
+  model.min_y = -1.0f;
+
+  assert(rgf_binary_encode(binary_buffer, BINARY_BUFFER_CAPACITY, &binary_buffer_size, &model));
+
+  /* Only positions and indices, the normals are never touched */
+  assert(rgf_binary_decode_sections(binary_buffer, binary_buffer_size, &binary_model, RGF_BINARY_SECTION_BIT(RGF_BINARY_SECTION_VERTICES) | RGF_BINARY_SECTION_BIT(RGF_BINARY_SECTION_INDICES)));
+  assert(binary_model.vertices_size == 3);
+  assert(binary_model.vertices[2] == 2.0f);
+  assert(binary_model.indices_size == 3);
+  assert(binary_model.normals_size == 0);
+  assert(binary_model.normals == 0);
+  assert(!(binary_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED));
+  assert(binary_model.min_y == -1.0f);
+
+  /* The directory alone is enough to locate every section */
+  assert(rgf_binary_decode_header(binary_buffer, RGF_BINARY_SIZE_HEADER_V2 + 3 * RGF_BINARY_SIZE_DIRECTORY_ENTRY, &binary_model, sections, &sections_size));
+  assert(sections_size == 3);
+  assert(binary_model.vertices == 0);
+  assert(sections[0].type == RGF_BINARY_SECTION_VERTICES);
+  assert(sections[1].type == RGF_BINARY_SECTION_NORMALS);
+  assert(sections[2].type == RGF_BINARY_SECTION_INDICES);
+  assert(sections[1].offset == 5 * RGF_BINARY_ALIGNMENT);
+  assert(sections[1].size == 3 * sizeof(float));
+  assert(sections[1].count == 3);
+  assert(rgf_binary_section_verify(&sections[1], binary_buffer + sections[1].offset));
+
+  assert(rgf_binary_decode_section(&binary_model, &sections[1], binary_buffer + sections[1].offset));
+  assert(binary_model.normals_size == 3);
+  assert(binary_model.normals[1] == 1.0f);
+  assert(binary_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED);
+
+  /* Corrupted data fails the checksum, unknown encodings are not decoded */
+  binary_buffer[sections[1].offset + 1] ^= 1;
+  assert(!rgf_binary_section_verify(&sections[1], binary_buffer + sections[1].offset));
+
+  sections[1].encoding = 7;
+  assert(!rgf_binary_decode_section(&binary_model, &sections[1], binary_buffer + sections[1].offset));
+
+  /* Broken directories are rejected */
+  assert(!rgf_binary_decode_header(binary_buffer, RGF_BINARY_SIZE_HEADER_V2 + 3 * RGF_BINARY_SIZE_DIRECTORY_ENTRY - 1, &binary_model, sections, &sections_size));
+
+  binary_buffer[RGF_BINARY_SIZE_HEADER_V2 + RGF_BINARY_SIZE_DIRECTORY_ENTRY] = RGF_BINARY_SECTION_VERTICES;
+  assert(!rgf_binary_decode_header(binary_buffer, binary_buffer_size, &binary_model, sections, &sections_size));
+}
+
+void rgf_test_encode_quantized(void)
+{
+  rgf_u64 binary_memory[BINARY_BUFFER_CAPACITY / 8];
+  unsigned char *binary_buffer = (unsigned char *)binary_memory;
+  unsigned long binary_buffer_size = 0;
+
+  /* 5 of each, so the SIMD paths and the scalar tails both run */
+  float vertices[] = {-1.0f, 0.0f, 2.0f, 1.0f, 0.5f, 4.0f, 0.25f, 1.0f, 3.0f, -0.5f, 0.75f, 2.5f, 0.0f, 0.1f, 3.3f};
+  float normals[] = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.6f, -0.8f, 0.0f, -0.48f, 0.6f, -0.64f, 0.0f, 1.0f, 0.0f};
+  float uvs[] = {0.0f, 1.0f, 0.5f, 0.25f, 0.125f, 0.3f, 0.7f, 1.5f, -2.0f, 0.001f};
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+
+  rgf_u64 decoded_memory[3][8];
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long sections_size = 0;
+  unsigned long i;
+
+  rgf_model binary_model = {0};
+
+  rgf_model model = {0};
+  model.vertices_size = 15;
+  model.normals_size = 15;
+  model.uvs_size = 10;
+  model.vertices = vertices;
+  model.normals = normals;
+  model.uvs = uvs;
+
+  /* Half floats round to nearest even */
+  assert(rgf_binary_float_to_half(1.0f) == 0x3C00);
+  assert(rgf_binary_float_to_half(-2.0f) == 0xC000);
+  assert(rgf_binary_float_to_half(65504.0f) == 0x7BFF);
+  assert(rgf_binary_float_to_half(1e6f) == 0x7C00);
+  assert(rgf_binary_float_to_half(5.9604645e-8f) == 0x0001);
+  assert(rgf_binary_float_to_half(1.0f + 1.0f / 2048.0f) == 0x3C00);
+  assert(rgf_binary_half_to_float(0x3555) == 0.333251953125f);
+  assert(rgf_binary_half_to_float(0x0001) == 5.9604645e-8f);
+  assert(rgf_binary_half_to_float(0xFC00) < -1e38f);
+
+  encodings[RGF_BINARY_SECTION_VERTICES] = RGF_BINARY_ENCODING_UNORM16;
+  encodings[RGF_BINARY_SECTION_NORMALS] = RGF_BINARY_ENCODING_OCTAHEDRAL;
+  encodings[RGF_BINARY_SECTION_UVS] = RGF_BINARY_ENCODING_HALF;
+
+  /* Quantized vertices need bounds that contain them */
+  assert(!rgf_binary_encode_sections(binary_buffer, BINARY_BUFFER_CAPACITY, &binary_buffer_size, &model, encodings, 0, 0));
+
+  rgf_model_calculate_boundaries(&model);
+  assert(rgf_binary_encode_sections(binary_buffer, BINARY_BUFFER_CAPACITY, &binary_buffer_size, &model, encodings, 0, 0));
+
+  assert(rgf_binary_decode_header(binary_buffer, binary_buffer_size, &binary_model, sections, &sections_size));
+  assert(sections_size == 3);
+  assert(sections[0].encoding == RGF_BINARY_ENCODING_UNORM16 && sections[0].size == 15 * 2);
+  assert(sections[1].encoding == RGF_BINARY_ENCODING_OCTAHEDRAL && sections[1].size == 5 * 4);
+  assert(sections[2].encoding == RGF_BINARY_ENCODING_HALF && sections[2].size == 10 * 2);
+  assert(rgf_binary_section_decoded_size(&sections[0]) == 15 * sizeof(float));
+
+  /* Quantized data can not be pointed to, only expanded */
+  assert(!rgf_binary_decode_section(&binary_model, &sections[0], binary_buffer + sections[0].offset));
+  assert(!rgf_binary_decode(binary_buffer, binary_buffer_size, &binary_model));
+  assert(rgf_binary_decode_header(binary_buffer, binary_buffer_size, &binary_model, sections, &sections_size));
+
+  for (i = 0; i < sections_size; ++i)
+  {
+    assert(rgf_binary_section_verify(&sections[i], binary_buffer + sections[i].offset));
+    assert(rgf_binary_decode_section_to(&binary_model, &sections[i], binary_buffer + sections[i].offset, decoded_memory[i]));
+  }
+
+  assert(binary_model.vertices_size == 15);
+  assert(binary_model.normals_size == 15);
+  assert(binary_model.uvs_size == 10);
+  assert(binary_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED);
+
+  /* Positions within half a step of the bounds, unit vectors within the snorm16 error */
+  for (i = 0; i < 15; ++i)
+  {
+    assert_equalsf(binary_model.vertices[i], vertices[i], 5.0f / 65535.0f);
+    assert_equalsf(binary_model.normals[i], normals[i], 1e-4f);
+  }
+
+  for (i = 0; i < 10; ++i)
+  {
+    assert_equalsf(binary_model.uvs[i], uvs[i], 1e-3f);
+  }
+
+  assert(binary_model.vertices[0] == -1.0f);
+  assert(binary_model.uvs[8] == -2.0f);
+
+  /* Encodings that do not fit the section are rejected */
+  encodings[RGF_BINARY_SECTION_UVS] = RGF_BINARY_ENCODING_OCTAHEDRAL;
+  assert(!rgf_binary_encode_sections(binary_buffer, BINARY_BUFFER_CAPACITY, &binary_buffer_size, &model, encodings, 0, 0));
 }
 
 void rgf_test_encode_to_file(void)
@@ -100,19 +314,20 @@ void rgf_test_encode_to_file(void)
 void rgf_test_decode_from_file(void)
 {
   /* The decoded model data */
-  unsigned char binary_buffer[BINARY_BUFFER_CAPACITY];
+  rgf_u64 binary_memory[BINARY_BUFFER_CAPACITY / 8];
+  unsigned char *binary_buffer = (unsigned char *)binary_memory;
   unsigned long binary_buffer_size = 0;
 
   rgf_model model = {0};
 
   assert(rgf_platform_read("test_v1.rgf", binary_buffer, BINARY_BUFFER_CAPACITY, &binary_buffer_size));
 
-  /* Check header */
+  /* Check header, the legacy version 1 is still decoded */
   assert(binary_buffer[0] == 'R');
   assert(binary_buffer[1] == 'G');
   assert(binary_buffer[2] == 'F');
   assert(binary_buffer[3] == '\0');
-  assert(binary_buffer[4] == RGF_BINARY_VERSION);
+  assert(binary_buffer[4] == RGF_BINARY_VERSION_1);
   assert(binary_buffer[5] == 0);
   assert(binary_buffer[6] == 0);
   assert(binary_buffer[7] == 0);
@@ -122,12 +337,253 @@ void rgf_test_decode_from_file(void)
   assert(model.vertices_size == 2);
   assert(model.normals_size == 1);
   assert(model.indices_size == 2);
+  assert(model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED);
 
   assert_equalsf(model.vertices[0], 1.0f, RGF_TEST_EPSILON);
   assert_equalsf(model.vertices[1], 0.0f, RGF_TEST_EPSILON);
   assert_equalsf(model.normals[0], 4.0f, RGF_TEST_EPSILON);
   assert(model.indices[0] == 0);
   assert(model.indices[1] == 1);
+
+  /* Version 1 written on an LP64 host has 8 byte size fields */
+  {
+    unsigned long counts[6] = {2, 1, 0, 0, 0, 2};
+    unsigned long i;
+
+    for (i = 0; i < 132; ++i)
+    {
+      binary_buffer[i] = 0;
+    }
+
+    binary_buffer[0] = 'R';
+    binary_buffer[1] = 'G';
+    binary_buffer[2] = 'F';
+    binary_buffer[4] = RGF_BINARY_VERSION_1;
+
+    for (i = 0; i < 6; ++i)
+    {
+      rgf_binary_write_u32(binary_buffer + 8 + i * 8, counts[i]);
+    }
+
+    rgf_binary_write_u32(binary_buffer + 112, rgf_binary_float_bits(1.0f));
+    rgf_binary_write_u32(binary_buffer + 120, rgf_binary_float_bits(4.0f));
+    rgf_binary_write_u32(binary_buffer + 128, 1);
+
+    assert(rgf_binary_decode(binary_buffer, 132, &model));
+    assert(model.vertices_size == 2 && model.normals_size == 1 && model.indices_size == 2);
+    assert(model.vertices[0] == 1.0f && model.normals[0] == 4.0f && model.indices[1] == 1);
+
+    /* A size that matches neither width */
+    assert(!rgf_binary_decode(binary_buffer, 136, &model));
+  }
+}
+
+void rgf_test_decode_sections_from_file(void)
+{
+  /* Only the header and the requested sections are read from the file */
+  rgf_u64 header_memory[RGF_BINARY_SIZE_HEADER_MAX / 8 + 1];
+  rgf_u64 vertices_memory[4];
+  rgf_u64 indices_memory[4];
+  unsigned char *header = (unsigned char *)header_memory;
+  unsigned long header_size = 0;
+  unsigned long bytes_read = 0;
+
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long sections_size = 0;
+  unsigned long i;
+
+  rgf_model model = {0};
+
+  assert(rgf_platform_read_range("test.rgf", 0, header, RGF_BINARY_SIZE_HEADER_MAX, &header_size));
+  assert(rgf_binary_decode_header(header, header_size, &model, sections, &sections_size));
+  assert(sections_size == 3);
+
+  for (i = 0; i < sections_size; ++i)
+  {
+    if (sections[i].type == RGF_BINARY_SECTION_VERTICES)
+    {
+      assert(sections[i].size <= sizeof(vertices_memory));
+      assert(rgf_platform_read_range("test.rgf", sections[i].offset, (unsigned char *)vertices_memory, sections[i].size, &bytes_read));
+      assert(bytes_read == sections[i].size);
+      assert(rgf_binary_section_verify(&sections[i], (unsigned char *)vertices_memory));
+      assert(rgf_binary_decode_section(&model, &sections[i], (unsigned char *)vertices_memory));
+    }
+    else if (sections[i].type == RGF_BINARY_SECTION_INDICES)
+    {
+      assert(sections[i].size <= sizeof(indices_memory));
+      assert(rgf_platform_read_range("test.rgf", sections[i].offset, (unsigned char *)indices_memory, sections[i].size, &bytes_read));
+      assert(bytes_read == sections[i].size);
+      assert(rgf_binary_section_verify(&sections[i], (unsigned char *)indices_memory));
+      assert(rgf_binary_decode_section(&model, &sections[i], (unsigned char *)indices_memory));
+    }
+  }
+
+  assert(model.vertices_size == 2);
+  assert(model.indices_size == 2);
+  assert(model.normals_size == 0);
+  assert(model.normals == 0);
+
+  assert_equalsf(model.vertices[0], 1.0f, RGF_TEST_EPSILON);
+  assert(model.indices[1] == 1);
+
+  /* Reading past the end of the file stops early */
+  assert(rgf_platform_read_range("test.rgf", 6 * RGF_BINARY_ALIGNMENT, header, RGF_BINARY_SIZE_HEADER_MAX, &bytes_read));
+  assert(bytes_read == 8);
+}
+
+void rgf_test_atof(void)
+{
+  /* Hard cases: halfway points, long mantissas, exponents, subnormals and limits */
+  typedef struct rgf_test_float_case
+  {
+    char *text;
+    unsigned long bits;
+
+  } rgf_test_float_case;
+
+  rgf_test_float_case cases[] = {
+      {"1e-5", 0x3727C5ACUL},
+      {"0.1", 0x3DCCCCCDUL},
+      {"3.4028235e38", 0x7F7FFFFFUL},
+      {"3.4028236e38", 0x7F800000UL},
+      {"1.4e-45", 0x00000001UL},
+      {"7e-46", 0x00000000UL},
+      {"7.1e-46", 0x00000001UL},
+      {"1.17549435e-38", 0x00800000UL},
+      {"1.1754942e-38", 0x007FFFFFUL},
+      {"16777217", 0x4B800000UL},
+      {"16777219", 0x4B800002UL},
+      {"7.038531e-26", 0x15AE43FDUL},
+      {"8.589973e9", 0x50000026UL},
+      {"1.000000059604644775390625", 0x3F800000UL},
+      {"1.00000005960464477539062500000000000000000001", 0x3F800001UL},
+      {"2.7182818284590452353602874713526624977572", 0x402DF854UL},
+      {"4.7019774032891500318749461488889827112746622270883500860350068251e-38", 0x01800000UL},
+      {"0.000000000000000000000000000000000000011754943508222875079687365372222456778186655567720875215087517062784172594547271728515625", 0x00800000UL},
+      {"-0.0", 0x80000000UL},
+      {"1e39", 0x7F800000UL},
+      {"123456789012345678901234567890", 0x6FC77488UL},
+      {"-1.5E+3", 0xC4BB8000UL},
+  };
+
+  char text[] = "12.5e3 -0.25,.5e-1 3.";
+  unsigned long i;
+  int consumed = 0;
+  int equal = 1;
+
+  for (i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+  {
+    float value = rgf_atof(cases[i].text, &consumed);
+    equal &= value == rgf_float_from_bits(cases[i].bits) || (value == 0.0f && (cases[i].bits & 0x7FFFFFFFUL) == 0);
+    equal &= cases[i].text[consumed] == '\0';
+  }
+  assert(equal);
+
+  /* Signed zero */
+  assert(1.0f / rgf_atof("-0.0", &consumed) < 0.0f);
+
+  /* The length bounds the parsed characters */
+  assert(rgf_atof_n(text, 4, &consumed) == 12.5f);
+  assert(consumed == 4);
+  assert(rgf_atof_n(text, 5, &consumed) == 12.5f);
+  assert(consumed == 4);
+  assert(rgf_atof_n(text, 7, &consumed) == 12500.0f);
+  assert(consumed == 6);
+  assert(rgf_atof_n(text + 7, sizeof(text) - 1 - 7, &consumed) == -0.25f);
+  assert(consumed == 5);
+  assert(rgf_atof_n(text + 13, sizeof(text) - 1 - 13, &consumed) == 0.05f);
+  assert(consumed == 5);
+  assert(rgf_atof_n(text + 19, sizeof(text) - 1 - 19, &consumed) == 3.0f);
+  assert(consumed == 2);
+  assert(rgf_atof_n(text + 6, sizeof(text) - 1 - 6, &consumed) == 0.0f);
+  assert(consumed == 0);
+  assert(rgf_atof_n(text, 0, &consumed) == 0.0f);
+  assert(consumed == 0);
+
+  /* Round trip of the shortest representations (9 significant digits) of floats */
+  assert(rgf_atof("0.3", &consumed) == 0.3f);
+  assert(rgf_atof("-0.18487546", &consumed) == -0.18487546f);
+  assert(rgf_atof("0.70332", &consumed) == 0.70332f);
+  assert(rgf_atof("2.5e-7", &consumed) == 2.5e-7f);
+  assert(rgf_atof("3.40282347e38", &consumed) == 3.40282347e38f);
+  assert(rgf_atof("9.99999944e-39", &consumed) == 9.99999944e-39f);
+}
+
+void rgf_test_obj_count(void)
+{
+  /* Lines cross the 64 byte classification blocks, mixed line endings and no trailing newline */
+  char obj[] =
+      "# comment line that is long enough to span into the second block of 64 bytes\n"
+      "mtllib test.mtl\r\n"
+      "v 1.0 2.0 3.0\r\n"
+      "v -1.0 -2.0 -3.0\n"
+      "v 0.5 0.5 0.5\n"
+      "v 0.25 0.25 0.25\n"
+      "vt 0.0 1.0\n"
+      "vt 1.0 0.0\n"
+      "vn 0.0 1.0 0.0\n"
+      "f 1/1 2/2 3/1\r\n"
+      "f    1/1/1   2/2/1   3/1/1   4/2/1   \n"
+      "f -4 -3 -2 -1 1 2 3 4 1 2 3 4 1 2 3 4 1 2 3 4 1 2 3 4 1 2 3 4 1 2 3 4\n"
+      "f 1 2";
+
+  rgf_obj_counts counts;
+
+  rgf_obj_count(&counts, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1));
+
+  assert(counts.vertex_count == 4);
+  assert(counts.uv_count == 2);
+  assert(counts.triangle_count == 1 + 2 + 30);
+  assert(counts.normal_count == 1);
+  assert(counts.corner_count == 3 + 4 + 32 + 2);
+  assert(counts.submesh_count == 1);
+}
+
+void rgf_test_obj_measure(void)
+{
+  char obj[] =
+      "mtllib head.mtl\n"
+      "o head\n"
+      "v 1.0 2.0 3.0\n"
+      "v -1.0 -2.0 -3.0\n"
+      "v 0.5 0.5 0.5\n"
+      "vn 0.0 1.0 0.0\n"
+      "vn 1.0 0.0 0.0\n"
+      "usemtl skin\n"
+      "f 1//1 2//1 3//2\n"
+      "g empty\n"
+      "g eyes\n"
+      "usemtl eye\n"
+      "f 1//1 2//1 3//2 1//2\n"
+      "usemtlx not_a_group\n"
+      "f 3 2 1\n";
+
+  rgf_obj_measurement measurement;
+
+  assert(rgf_obj_measure(&measurement, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1)));
+
+  assert(measurement.counts.vertex_count == 3);
+  assert(measurement.counts.uv_count == 0);
+  assert(measurement.counts.normal_count == 2);
+  assert(measurement.counts.triangle_count == 4);
+  assert(measurement.counts.submesh_count == 2);
+
+  assert(measurement.vertices_size == 9);
+  assert(measurement.uvs_size == 0);
+  assert(measurement.normals_size == 6);
+  assert(measurement.indices_size == 12);
+  assert(measurement.vertices_bytes == 9 * sizeof(float));
+  assert(measurement.indices_bytes == 12 * sizeof(int));
+  assert(measurement.submeshes_size == 2);
+  assert(measurement.submeshes_bytes == 2 * sizeof(rgf_submesh));
+  assert(measurement.total_bytes == 15 * sizeof(float) + 12 * sizeof(int) + 2 * sizeof(rgf_submesh));
+  assert(measurement.parallel_submeshes_size == 2 + RGF_OBJ_MAX_CHUNKS);
+  assert(measurement.parallel_submeshes_bytes == (2 + RGF_OBJ_MAX_CHUNKS) * sizeof(rgf_submesh));
+  assert(measurement.weld_vertex_capacity == 10);
+  assert(measurement.weld_table_size == 32);
+  assert(measurement.weld_scratch_bytes == 32 * sizeof(rgf_obj_weld_slot) + 15 * sizeof(float));
+
+  assert(!rgf_obj_measure(&measurement, (unsigned char *)obj, 0));
 }
 
 #include <stdlib.h>
@@ -262,6 +718,1985 @@ void rgf_test_parse_obj(void)
   free(uvs_buffer);
 }
 
+void rgf_test_parse_obj_parallel(void)
+{
+  /* Stack Memory */
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  float *uvs_buffer = malloc(100000 * sizeof(float));
+  float *parallel_vertices_buffer = malloc(30000 * sizeof(float));
+  int *parallel_indices_buffer = malloc(60000 * sizeof(int));
+  float *parallel_uvs_buffer = malloc(100000 * sizeof(float));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned long binary_buffer_size = 0;
+  unsigned long i;
+  int equal;
+
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+
+  rgf_model model = {0};
+  rgf_model parallel_model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.uvs = uvs_buffer;
+  parallel_model.vertices = parallel_vertices_buffer;
+  parallel_model.indices = parallel_indices_buffer;
+  parallel_model.uvs = parallel_uvs_buffer;
+
+  /* More threads than cores to get a few chunks even for the small head.obj */
+  rgf_platform_threads_init(&threads, 8);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+  assert(rgf_parse_obj_parallel(&parallel_model, binary_buffer, binary_buffer_size, &jobs));
+
+  assert(parallel_model.vertices_size == model.vertices_size);
+  assert(parallel_model.uvs_size == model.uvs_size);
+  assert(parallel_model.indices_size == model.indices_size);
+
+  /* The parallel result has to be bit identical to the serial one */
+  equal = 1;
+  for (i = 0; i < model.vertices_size * sizeof(float); ++i)
+  {
+    equal &= ((unsigned char *)model.vertices)[i] == ((unsigned char *)parallel_model.vertices)[i];
+  }
+  for (i = 0; i < model.uvs_size * sizeof(float); ++i)
+  {
+    equal &= ((unsigned char *)model.uvs)[i] == ((unsigned char *)parallel_model.uvs)[i];
+  }
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    equal &= model.indices[i] == parallel_model.indices[i];
+  }
+  assert(equal);
+
+  assert(parallel_model.min_x == model.min_x);
+  assert(parallel_model.min_y == model.min_y);
+  assert(parallel_model.min_z == model.min_z);
+  assert(parallel_model.max_x == model.max_x);
+  assert(parallel_model.max_y == model.max_y);
+  assert(parallel_model.max_z == model.max_z);
+  assert(parallel_model.original_max_dim == model.original_max_dim);
+
+  /* Negative face indices are relative to the vertices defined so far */
+  {
+    char obj[] =
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "f -3 -2 -1\n"
+        "v 0 0 1\n"
+        "f 1/1/1 -3/1/1 -1/1/1 -2/1/1\n";
+
+    assert(rgf_parse_obj_parallel(&parallel_model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1), &jobs));
+
+    assert(parallel_model.vertices_size == 12);
+    assert(parallel_model.indices_size == 9);
+    assert(parallel_model.indices[0] == 0);
+    assert(parallel_model.indices[1] == 1);
+    assert(parallel_model.indices[2] == 2);
+    assert(parallel_model.indices[3] == 0);
+    assert(parallel_model.indices[4] == 1);
+    assert(parallel_model.indices[5] == 3);
+    assert(parallel_model.indices[6] == 0);
+    assert(parallel_model.indices[7] == 3);
+    assert(parallel_model.indices[8] == 2);
+  }
+
+  free(vertices_buffer);
+  free(indices_buffer);
+  free(uvs_buffer);
+  free(parallel_vertices_buffer);
+  free(parallel_indices_buffer);
+  free(parallel_uvs_buffer);
+  free(binary_buffer);
+}
+
+typedef struct rgf_test_allocator
+{
+  void *blocks[256];
+  unsigned long block_count;
+
+} rgf_test_allocator;
+
+void *rgf_test_allocate(void *allocate_context, unsigned long size)
+{
+  rgf_test_allocator *allocator = (rgf_test_allocator *)allocate_context;
+
+  if (allocator->block_count >= 256)
+  {
+    return 0;
+  }
+
+  return allocator->blocks[allocator->block_count++] = malloc(size);
+}
+
+void rgf_test_parse_obj_arena(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  float *uvs_buffer = malloc(100000 * sizeof(float));
+  float *arena_vertices_buffer = malloc(30000 * sizeof(float));
+  int *arena_indices_buffer = malloc(60000 * sizeof(int));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned long binary_buffer_size = 0;
+  unsigned long i;
+  int equal = 1;
+
+  /* Small first block on the stack, the rest grows in 16 KB blocks */
+  float stack_memory[256];
+  rgf_test_allocator allocator = {0};
+  rgf_arena vertices, uvs, indices;
+
+  rgf_model model = {0};
+  rgf_model arena_model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.uvs = uvs_buffer;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+
+  rgf_arena_init(&vertices, stack_memory, sizeof(stack_memory), rgf_test_allocate, &allocator, 16 * 1024);
+  rgf_arena_init(&uvs, 0, 0, rgf_test_allocate, &allocator, 16 * 1024);
+  rgf_arena_init(&indices, 0, 0, rgf_test_allocate, &allocator, 16 * 1024);
+
+  assert(rgf_parse_obj_arena(&arena_model, binary_buffer, binary_buffer_size, &vertices, &uvs, &indices, 0));
+
+  /* Exact sizes, data is spread over several blocks */
+  assert(arena_model.vertices_size == model.vertices_size);
+  assert(arena_model.uvs_size == model.uvs_size);
+  assert(arena_model.indices_size == model.indices_size);
+  assert(vertices.size == model.vertices_size * sizeof(float));
+  assert(arena_model.vertices == 0);
+  assert(arena_model.indices == 0);
+
+  rgf_arena_copy(&vertices, arena_vertices_buffer);
+  rgf_arena_copy(&indices, arena_indices_buffer);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= arena_vertices_buffer[i] == model.vertices[i];
+  }
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    equal &= arena_indices_buffer[i] == model.indices[i];
+  }
+  assert(equal);
+
+  assert(arena_model.min_x == model.min_x);
+  assert(arena_model.max_z == model.max_z);
+  assert(arena_model.center_y == model.center_y);
+
+  /* A fixed arena without an allocator fails instead of overflowing */
+  rgf_arena_init(&vertices, stack_memory, sizeof(stack_memory), 0, 0, 0);
+  assert(!rgf_parse_obj_arena(&arena_model, binary_buffer, binary_buffer_size, &vertices, 0, 0, 0));
+
+  /* Everything fits into one block: the model points into the arena */
+  rgf_arena_init(&vertices, arena_vertices_buffer, 30000 * sizeof(float), 0, 0, 0);
+  assert(rgf_parse_obj_arena(&arena_model, binary_buffer, binary_buffer_size, &vertices, 0, 0, 0));
+  assert(arena_model.vertices_size == model.vertices_size);
+  assert(arena_model.vertices != 0);
+  assert(arena_model.indices_size == 0);
+  assert(arena_model.vertices[0] == model.vertices[0]);
+  assert(arena_model.vertices[model.vertices_size - 1] == model.vertices[model.vertices_size - 1]);
+
+  /* Submeshes split by "usemtl", "g" and "o" lines match the ones of rgf_parse_obj */
+  {
+    char obj[] =
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\n"
+        "f 1 2 3\n"
+        "usemtl red\n"
+        "f 2 4 3\nf 1 2 4\n"
+        "g side\n"
+        "f 1 3 4\n"
+        "usemtl blue\n"
+        "o other\n"
+        "f 4 3 2\n";
+    rgf_submesh serial_submeshes[8];
+    rgf_arena submeshes;
+
+    model.uvs = 0;
+    model.submeshes = serial_submeshes;
+    assert(rgf_parse_obj(&model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1)));
+    assert(model.submeshes_size == 4);
+
+    rgf_arena_init(&vertices, 0, 0, rgf_test_allocate, &allocator, 1024);
+    rgf_arena_init(&indices, 0, 0, rgf_test_allocate, &allocator, 1024);
+    rgf_arena_init(&submeshes, 0, 0, rgf_test_allocate, &allocator, 1024);
+    assert(rgf_parse_obj_arena(&arena_model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1), &vertices, 0, &indices, &submeshes));
+    assert(arena_model.submeshes_size == model.submeshes_size);
+    assert(arena_model.submeshes != 0);
+
+    for (i = 0; i < model.submeshes_size; ++i)
+    {
+      equal &= arena_model.submeshes[i].index_offset == model.submeshes[i].index_offset;
+      equal &= arena_model.submeshes[i].index_count == model.submeshes[i].index_count;
+      equal &= arena_model.submeshes[i].material_hash == model.submeshes[i].material_hash;
+    }
+
+    assert(equal);
+    assert(arena_model.submeshes[3].material_hash == rgf_material_hash("blue"));
+
+    /* Without indices there are no submeshes */
+    assert(rgf_parse_obj_arena(&arena_model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1), &vertices, 0, 0, &submeshes));
+    assert(arena_model.submeshes_size == 0 && arena_model.submeshes == 0);
+  }
+
+  for (i = 0; i < allocator.block_count; ++i)
+  {
+    free(allocator.blocks[i]);
+  }
+
+  free(vertices_buffer);
+  free(indices_buffer);
+  free(uvs_buffer);
+  free(arena_vertices_buffer);
+  free(arena_indices_buffer);
+  free(binary_buffer);
+}
+
+void rgf_test_parse_obj_welded(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  float *welded_vertices_buffer = malloc(110000 * sizeof(float));
+  float *welded_uvs_buffer = malloc(75000 * sizeof(float));
+  int *welded_indices_buffer = malloc(60000 * sizeof(int));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned long binary_buffer_size = 0;
+  unsigned long i;
+  int equal = 1;
+  void *scratch;
+
+  rgf_obj_measurement measurement;
+  rgf_model model = {0};
+  rgf_model welded_model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  welded_model.vertices = welded_vertices_buffer;
+  welded_model.uvs = welded_uvs_buffer;
+  welded_model.indices = welded_indices_buffer;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+  assert(rgf_obj_measure(&measurement, binary_buffer, binary_buffer_size));
+
+  scratch = malloc(measurement.weld_scratch_bytes);
+
+  assert(measurement.weld_vertex_capacity == 35368);
+  assert(rgf_parse_obj_welded(&welded_model, binary_buffer, binary_buffer_size, &measurement, scratch));
+
+  /* Every v/vt pair of head.obj is unique */
+  assert(welded_model.vertices_size == 35368 * 3);
+  assert(welded_model.uvs_size == 35368 * 2);
+  assert(welded_model.normals_size == 0);
+  assert(welded_model.indices_size == model.indices_size);
+  assert(!(welded_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED));
+
+  assert(welded_model.indices[0] == 0);
+  assert(welded_model.indices[1] == 1);
+  assert(welded_model.indices[2] == 2);
+  assert(welded_model.indices[3] == 0);
+  assert(welded_model.indices[4] == 2);
+  assert(welded_model.indices[5] == 3);
+
+  assert_equalsf(welded_model.uvs[0], 0.70332f, RGF_TEST_EPSILON);
+  assert_equalsf(welded_model.uvs[1], 0.80831f, RGF_TEST_EPSILON);
+  assert_equalsf(welded_model.uvs[welded_model.uvs_size - 2], 0.23679f, RGF_TEST_EPSILON);
+  assert_equalsf(welded_model.uvs[welded_model.uvs_size - 1], 0.71382f, RGF_TEST_EPSILON);
+
+  /* The welded triangles reference the same positions as the unwelded ones */
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    float *a = &model.vertices[model.indices[i] * 3];
+    float *b = &welded_model.vertices[welded_model.indices[i] * 3];
+
+    equal &= a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+  }
+  assert(equal);
+
+  assert(welded_model.min_x == model.min_x);
+  assert(welded_model.max_y == model.max_y);
+  assert(welded_model.center_z == model.center_z);
+
+  free(scratch);
+
+  /* Shared corners are welded, corners without uv or normal get zeros */
+  {
+    char obj[] =
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\n"
+        "vt 0 0\nvt 1 1\n"
+        "vn 0 0 1\n"
+        "f 1/1/1 2/2/1 3/1/1\n"
+        "f 3/1/1 2/2/1 4//1\n"
+        "f -4/-2/-1 2/2/1 4\n";
+
+    float scratch_memory[256];
+    float normals_buffer[64];
+
+    welded_model.normals = normals_buffer;
+
+    assert(rgf_obj_measure(&measurement, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1)));
+    assert(measurement.weld_scratch_bytes <= sizeof(scratch_memory));
+    assert(rgf_parse_obj_welded(&welded_model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1), &measurement, scratch_memory));
+
+    assert(welded_model.vertices_size == 5 * 3);
+    assert(welded_model.uvs_size == 5 * 2);
+    assert(welded_model.normals_size == 5 * 3);
+    assert(welded_model.indices_size == 9);
+
+    assert(welded_model.indices[0] == 0);
+    assert(welded_model.indices[1] == 1);
+    assert(welded_model.indices[2] == 2);
+    assert(welded_model.indices[3] == 2);
+    assert(welded_model.indices[4] == 1);
+    assert(welded_model.indices[5] == 3);
+    assert(welded_model.indices[6] == 0);
+    assert(welded_model.indices[7] == 1);
+    assert(welded_model.indices[8] == 4);
+
+    assert(welded_model.vertices[3 * 3 + 0] == 1.0f);
+    assert(welded_model.vertices[3 * 3 + 1] == 1.0f);
+    assert(welded_model.uvs[3 * 2 + 0] == 0.0f);
+    assert(welded_model.normals[3 * 3 + 2] == 1.0f);
+    assert(welded_model.uvs[1 * 2 + 0] == 1.0f);
+    assert(welded_model.normals[4 * 3 + 2] == 0.0f);
+
+    /* The last vertex has no normal, so the normals have to be recomputed */
+    assert(!(welded_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED));
+  }
+
+  /* Authored normals of a hard edge are kept per corner */
+  {
+    char obj[] =
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\n"
+        "vn 0 0 1\nvn 0 1 0\n"
+        "f 1//1 2//1 3//1\n"
+        "f 1//2 4//2 2//2\n";
+
+    float scratch_memory[256];
+    float normals_buffer[64];
+
+    welded_model.normals = normals_buffer;
+
+    assert(rgf_obj_measure(&measurement, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1)));
+    assert(rgf_parse_obj_welded(&welded_model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1), &measurement, scratch_memory));
+
+    assert(welded_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED);
+    assert(measurement.vertices_size == 4 * 3);
+    assert(welded_model.vertices_size == 6 * 3);
+    assert(welded_model.normals_size == 6 * 3);
+    assert(welded_model.normals[0 * 3 + 2] == 1.0f);
+    assert(welded_model.normals[3 * 3 + 1] == 1.0f);
+    assert(welded_model.normals[5 * 3 + 1] == 1.0f);
+
+    /* A positional parse does not provide normals */
+    assert(rgf_parse_obj(&welded_model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1)));
+    assert(!(welded_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED));
+  }
+
+  /* Tokens without a vertex number are skipped like rgf_obj_count does */
+  {
+    char obj[] = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 x 2 3\n";
+    float scratch_memory[256];
+
+    welded_model.normals = 0;
+    assert(rgf_obj_measure(&measurement, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1)));
+    assert(measurement.indices_size == 3);
+    assert(rgf_parse_obj_welded(&welded_model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1), &measurement, scratch_memory));
+    assert(welded_model.vertices_size == 3 * 3);
+    assert(welded_model.indices_size == 3);
+    assert(welded_model.indices[2] == 2);
+  }
+
+  /* A face referencing an undefined uv is rejected */
+  {
+    char obj[] = "v 0 0 0\nvt 0 0\nf 1/1 1/2 1/1\n";
+    float scratch_memory[256];
+
+    assert(rgf_obj_measure(&measurement, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1)));
+    assert(!rgf_parse_obj_welded(&welded_model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1), &measurement, scratch_memory));
+  }
+
+  free(vertices_buffer);
+  free(indices_buffer);
+  free(welded_vertices_buffer);
+  free(welded_uvs_buffer);
+  free(welded_indices_buffer);
+  free(binary_buffer);
+}
+
+void rgf_test_parse_obj_submeshes(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  float *parallel_vertices_buffer = malloc(30000 * sizeof(float));
+  int *parallel_indices_buffer = malloc(60000 * sizeof(int));
+  rgf_submesh *submeshes_buffer = malloc(512 * sizeof(rgf_submesh));
+  rgf_submesh *parallel_submeshes_buffer = malloc((512 + RGF_OBJ_MAX_CHUNKS) * sizeof(rgf_submesh));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned long binary_buffer_size = 0;
+  unsigned long i;
+  int equal = 1;
+
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+
+  rgf_model model = {0};
+  rgf_model parallel_model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.submeshes = submeshes_buffer;
+  parallel_model.vertices = parallel_vertices_buffer;
+  parallel_model.indices = parallel_indices_buffer;
+  parallel_model.submeshes = parallel_submeshes_buffer;
+
+  rgf_platform_threads_init(&threads, 8);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  /* head.obj has one material and 296 groups */
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+
+  assert(model.submeshes_size == 296);
+  assert(model.submeshes[0].index_offset == 0);
+  assert(model.submeshes[0].index_count == 48);
+  assert(model.submeshes[1].index_offset == 48);
+  assert(model.submeshes[1].index_count == 72);
+  assert(model.submeshes[295].index_offset == 52992);
+  assert(model.submeshes[295].index_count == 60);
+  assert(model.submeshes[295].material_hash == rgf_material_hash("defaultMat"));
+
+  /* Submeshes split by the chunks are joined again */
+  assert(rgf_parse_obj_parallel(&parallel_model, binary_buffer, binary_buffer_size, &jobs));
+  assert(parallel_model.submeshes_size == model.submeshes_size);
+
+  for (i = 0; i < model.submeshes_size; ++i)
+  {
+    equal &= parallel_model.submeshes[i].index_offset == model.submeshes[i].index_offset;
+    equal &= parallel_model.submeshes[i].index_count == model.submeshes[i].index_count;
+    equal &= parallel_model.submeshes[i].material_hash == model.submeshes[i].material_hash;
+  }
+  assert(equal);
+
+  /* Sorting merges all groups of the single material */
+  rgf_model_sort_submeshes(&model, parallel_indices_buffer);
+  assert(model.submeshes_size == 1);
+  assert(model.submeshes[0].index_offset == 0);
+  assert(model.submeshes[0].index_count == model.indices_size);
+
+  {
+    char obj[] =
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "f 1 2 3\n"
+        "usemtl skin \r\n"
+        "f 1 2 3\nf 1 2 3\n"
+        "g eyes\n"
+        "usemtl eye\n"
+        "f 3 2 1\n"
+        "o other\n"
+        "f 1 2 3\n"
+        "usemtl skin\n"
+        "f 2 3 1\n";
+
+    int scratch[32];
+
+    assert(rgf_parse_obj(&model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 1)));
+
+    assert(model.submeshes_size == 5);
+    assert(model.submeshes[0].material_hash == 0);
+    assert(model.submeshes[1].index_offset == 3);
+    assert(model.submeshes[1].index_count == 6);
+    assert(model.submeshes[1].material_hash == rgf_material_hash("skin"));
+    assert(model.submeshes[2].material_hash == rgf_material_hash("eye"));
+    assert(model.submeshes[3].material_hash == rgf_material_hash("eye"));
+    assert(model.submeshes[4].index_offset == 15);
+    assert(model.submeshes[4].material_hash == rgf_material_hash("skin"));
+
+    rgf_model_sort_submeshes(&model, scratch);
+
+    /* One range per material, the triangles keep their order within a material */
+    assert(model.submeshes_size == 3);
+    assert(model.indices_size == 18);
+
+    for (i = 0; i < model.submeshes_size; ++i)
+    {
+      rgf_submesh *submesh = &model.submeshes[i];
+
+      if (submesh->material_hash == rgf_material_hash("skin"))
+      {
+        assert(submesh->index_count == 9);
+        assert(model.indices[submesh->index_offset + 6] == 1);
+      }
+      else if (submesh->material_hash == rgf_material_hash("eye"))
+      {
+        assert(submesh->index_count == 6);
+        assert(model.indices[submesh->index_offset] == 2);
+        assert(model.indices[submesh->index_offset + 3] == 0);
+      }
+      else
+      {
+        assert(submesh->material_hash == 0);
+        assert(submesh->index_offset + submesh->index_count <= model.indices_size);
+      }
+    }
+  }
+
+  free(vertices_buffer);
+  free(indices_buffer);
+  free(parallel_vertices_buffer);
+  free(parallel_indices_buffer);
+  free(submeshes_buffer);
+  free(parallel_submeshes_buffer);
+  free(binary_buffer);
+}
+
+void rgf_test_parse_obj_mapped(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  unsigned char *mapped = 0;
+  unsigned long mapped_size = 0;
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+
+  /* Parse straight off the read only mapping */
+  assert(rgf_platform_map("head.obj", &mapped, &mapped_size));
+  assert(mapped_size == 1436246);
+  assert(rgf_parse_obj(&model, mapped, mapped_size));
+
+  assert(model.vertices_size == 26532UL);
+  assert(model.indices_size == 53052UL);
+  assert_equalsf(model.vertices[model.vertices_size - 1], -0.071214f, RGF_TEST_EPSILON);
+  assert(model.indices[model.indices_size - 1] == 1263);
+
+  rgf_platform_unmap(mapped, mapped_size);
+
+  assert(!rgf_platform_map("does_not_exist.obj", &mapped, &mapped_size));
+
+  /* Nothing after the buffer size is read, the digits behind it must not be parsed */
+  {
+    char obj[] = "v 1 2 3\nv 4 5 6\nv 7 8 9\nf 1 2 3" "4\n";
+    char obj_vertex[] = "v 1 2 3" "5\n";
+    char obj_short[] = "v 1 2 3\nf" " 1 2 3\n";
+
+    assert(rgf_parse_obj(&model, (unsigned char *)obj, (unsigned long)(sizeof(obj) - 3)));
+    assert(model.indices_size == 3);
+    assert(model.indices[2] == 2);
+
+    assert(rgf_parse_obj(&model, (unsigned char *)obj_vertex, (unsigned long)(sizeof(obj_vertex) - 3)));
+    assert(model.vertices_size == 3);
+    assert(model.vertices[2] == 3.0f);
+
+    assert(rgf_parse_obj(&model, (unsigned char *)obj_short, (unsigned long)(sizeof(obj_short) - 8)));
+    assert(model.vertices_size == 3);
+    assert(model.indices_size == 0);
+  }
+
+  free(vertices_buffer);
+  free(indices_buffer);
+}
+
+void rgf_test_encode_triangles(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  int *decoded = malloc(60000 * sizeof(int));
+  unsigned char *encoded = malloc(rgf_binary_triangles_bound(60000));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned long encoded_size = 0;
+  unsigned long binary_buffer_size = 0;
+  unsigned long i;
+  int equal = 1;
+
+  /* Two quads, every triangle keeps its corner order */
+  int quads[] = {0, 1, 2, 0, 2, 3, 3, 2, 4, 3, 4, 5, 7, 6, 1};
+  int negative[] = {0, -1, 2};
+  int decoded_quads[15];
+
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long sections_size = 0;
+
+  rgf_model binary_model = {0};
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+
+  assert(rgf_binary_encode_triangles(encoded, quads, 15, &encoded_size));
+  assert(encoded_size < 15);
+  assert(rgf_binary_decode_triangles(decoded_quads, encoded, encoded_size, 15));
+
+  for (i = 0; i < 15; ++i)
+  {
+    equal &= decoded_quads[i] == quads[i];
+  }
+
+  assert(equal);
+
+  /* Truncated or trailing data and negative indices are rejected */
+  assert(!rgf_binary_decode_triangles(decoded_quads, encoded, encoded_size - 1, 15));
+  assert(!rgf_binary_decode_triangles(decoded_quads, encoded, encoded_size, 12));
+  assert(!rgf_binary_encode_triangles(encoded, negative, 3, &encoded_size));
+
+  /* head.obj: about 22 instead of 96 bits per triangle */
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+
+  assert(rgf_binary_encode_triangles(encoded, model.indices, model.indices_size, &encoded_size));
+  assert(encoded_size * 8 < (model.indices_size / 3) * 24);
+  assert(rgf_binary_decode_triangles(decoded, encoded, encoded_size, model.indices_size));
+
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    equal &= decoded[i] == model.indices[i];
+  }
+
+  assert(equal);
+
+  /* As section of the binary */
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_TRIANGLE_FIFO;
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, 0));
+  assert(rgf_binary_decode_header(binary_buffer, binary_buffer_size, &binary_model, sections, &sections_size));
+  assert(sections_size == 2);
+  assert(sections[1].encoding == RGF_BINARY_ENCODING_TRIANGLE_FIFO);
+  assert(sections[1].size == encoded_size);
+  assert(sections[1].count == model.indices_size);
+  assert(binary_buffer_size == sections[1].offset + encoded_size);
+
+  assert(!rgf_binary_decode_section(&binary_model, &sections[1], binary_buffer + sections[1].offset));
+  assert(rgf_binary_decode_section_to(&binary_model, &sections[1], binary_buffer + sections[1].offset, decoded));
+  assert(binary_model.indices == decoded);
+  assert(binary_model.indices_size == model.indices_size);
+  assert(decoded[model.indices_size - 1] == 1263);
+
+  /* Only triangle lists */
+  model.indices_size = 2;
+  assert(!rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, 0));
+
+  free(vertices_buffer);
+  free(indices_buffer);
+  free(decoded);
+  free(encoded);
+  free(binary_buffer);
+}
+
+void rgf_test_encode_compressed(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  rgf_submesh *submeshes_buffer = malloc(512 * sizeof(rgf_submesh));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned char *decompressed_buffer = malloc(300000);
+  float *decoded = malloc(60000 * sizeof(float));
+  unsigned long binary_buffer_size = 0;
+  unsigned long decompressed_size = 0;
+  unsigned long i;
+  int equal = 1;
+
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+  unsigned long compressions[RGF_BINARY_SECTION_COUNT];
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  rgf_binary_section decompressed;
+  unsigned long sections_size = 0;
+
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+
+  rgf_model binary_model = {0};
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.submeshes = submeshes_buffer;
+
+  rgf_platform_threads_init(&threads, 8);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  for (i = 0; i < RGF_BINARY_SECTION_COUNT; ++i)
+  {
+    compressions[i] = RGF_BINARY_COMPRESSION_LZ;
+  }
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_TRIANGLE_FIFO;
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, compressions, 0));
+  assert(rgf_binary_decode_header(binary_buffer, binary_buffer_size, &binary_model, sections, &sections_size));
+  assert(sections_size == 3);
+  assert(sections[0].compression == RGF_BINARY_COMPRESSION_LZ);
+  assert(rgf_binary_section_verify(&sections[0], binary_buffer + sections[0].offset));
+
+  /* Compressed sections are not usable without decompressing */
+  assert(!rgf_binary_decode(binary_buffer, binary_buffer_size, &binary_model));
+  assert(!rgf_binary_decode_section(&binary_model, &sections[0], binary_buffer + sections[0].offset));
+
+  /* Vertices: 7 blocks, in parallel */
+  assert(rgf_binary_decompressed_size(&sections[0], binary_buffer + sections[0].offset, &decompressed_size));
+  assert(decompressed_size == model.vertices_size * 4);
+  assert(sections[0].size < decompressed_size);
+  assert(!rgf_binary_decompress_section_parallel(&sections[0], binary_buffer + sections[0].offset, decompressed_buffer, decompressed_size - 1, &decompressed, &jobs));
+  assert(rgf_binary_decompress_section_parallel(&sections[0], binary_buffer + sections[0].offset, decompressed_buffer, 300000, &decompressed, &jobs));
+  assert(decompressed.compression == RGF_BINARY_COMPRESSION_NONE && decompressed.size == decompressed_size);
+  assert(rgf_binary_decode_section(&binary_model, &decompressed, decompressed_buffer));
+  assert(binary_model.vertices_size == model.vertices_size);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= binary_model.vertices[i] == model.vertices[i];
+  }
+
+  assert(equal);
+
+  /* Indices: decompressed, then decoded */
+  assert(sections[1].encoding == RGF_BINARY_ENCODING_TRIANGLE_FIFO);
+  assert(rgf_binary_decompress_section(&sections[1], binary_buffer + sections[1].offset, decompressed_buffer, 300000, &decompressed));
+  assert(rgf_binary_decode_section_to(&binary_model, &decompressed, decompressed_buffer, decoded));
+  assert(binary_model.indices_size == model.indices_size);
+
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    equal &= binary_model.indices[i] == model.indices[i];
+  }
+
+  assert(equal);
+
+  assert(rgf_binary_decompress_section(&sections[2], binary_buffer + sections[2].offset, decompressed_buffer, 300000, &decompressed));
+  assert(rgf_binary_decode_section(&binary_model, &decompressed, decompressed_buffer));
+  assert(binary_model.submeshes_size == 296);
+  assert(binary_model.submeshes[295].index_offset == 52992);
+
+  /* Truncated or corrupt block tables are rejected */
+  sections[0].size -= 1;
+  assert(!rgf_binary_decompress_section(&sections[0], binary_buffer + sections[0].offset, decompressed_buffer, 300000, &decompressed));
+  sections[0].size += 1;
+  binary_buffer[sections[0].offset + 8] ^= 1;
+  assert(!rgf_binary_decompress_section(&sections[0], binary_buffer + sections[0].offset, decompressed_buffer, 300000, &decompressed));
+
+  /* Unknown compression */
+  compressions[0] = 2;
+  assert(!rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, compressions, 0));
+
+  free(vertices_buffer);
+  free(indices_buffer);
+  free(submeshes_buffer);
+  free(binary_buffer);
+  free(decompressed_buffer);
+  free(decoded);
+}
+
+typedef struct rgf_test_sink
+{
+  unsigned char *buffer;
+  unsigned long size;
+  unsigned long capacity;
+  unsigned long calls;
+
+} rgf_test_sink;
+
+int rgf_test_sink_write(void *write_context, unsigned char **buffers, unsigned long *sizes, unsigned long count)
+{
+  rgf_test_sink *sink = (rgf_test_sink *)write_context;
+  unsigned long i;
+
+  sink->calls++;
+
+  for (i = 0; i < count; ++i)
+  {
+    if (sizes[i] > sink->capacity - sink->size)
+    {
+      return 0;
+    }
+
+    rgf_binary_memcpy(sink->buffer + sink->size, buffers[i], sizes[i]);
+    sink->size += sizes[i];
+  }
+
+  return 1;
+}
+
+void rgf_test_encode_stream(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  rgf_submesh *submeshes_buffer = malloc(512 * sizeof(rgf_submesh));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned char *stream_buffer = malloc(1500000);
+  unsigned long binary_buffer_size = 0;
+  unsigned long stream_size = 0;
+  unsigned long i;
+  int equal = 1;
+
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+  rgf_platform_writer writer;
+  rgf_test_sink sink;
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.submeshes = submeshes_buffer;
+
+  sink.buffer = stream_buffer;
+  sink.size = 0;
+  sink.capacity = 1500000;
+  sink.calls = 0;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+
+  /* Same bytes as the encoding into one buffer, the vertices in 9 chunks */
+  encodings[RGF_BINARY_SECTION_VERTICES] = RGF_BINARY_ENCODING_UNORM16;
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, 0));
+  assert(rgf_binary_encode_stream(&model, encodings, rgf_test_sink_write, &sink, &stream_size));
+  assert(stream_size == binary_buffer_size);
+  assert(sink.size == binary_buffer_size);
+  assert(sink.calls == 1 + 9 + 1 + 1);
+
+  for (i = 0; i < binary_buffer_size; ++i)
+  {
+    equal &= stream_buffer[i] == binary_buffer[i];
+  }
+
+  assert(equal);
+
+  /* Writer errors abort the encoding */
+  sink.size = 0;
+  sink.capacity = 1000;
+  assert(!rgf_binary_encode_stream(&model, encodings, rgf_test_sink_write, &sink, &stream_size));
+
+  /* Sections with a data dependent size can not be streamed */
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_TRIANGLE_FIFO;
+  assert(!rgf_binary_encode_stream(&model, encodings, rgf_test_sink_write, &sink, &stream_size));
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_RAW;
+
+  /* Straight into a file */
+  assert(rgf_platform_writer_open(&writer, "test_stream.rgf"));
+  assert(rgf_binary_encode_stream(&model, encodings, rgf_platform_writer_write, &writer, &stream_size));
+  assert(rgf_platform_writer_write_at(&writer, 4, binary_buffer + 4, 1));
+  assert(rgf_platform_writer_close(&writer));
+
+  assert(rgf_platform_read("test_stream.rgf", stream_buffer, 1500000, &stream_size));
+  assert(stream_size == binary_buffer_size);
+
+  for (i = 0; i < binary_buffer_size; ++i)
+  {
+    equal &= stream_buffer[i] == binary_buffer[i];
+  }
+
+  assert(equal);
+
+  free(vertices_buffer);
+  free(indices_buffer);
+  free(submeshes_buffer);
+  free(binary_buffer);
+  free(stream_buffer);
+}
+
+void rgf_test_pak(void)
+{
+  rgf_u64 pak_memory[4096 / 8];
+  unsigned char *pak = (unsigned char *)pak_memory;
+  rgf_u64 binary_memory[BINARY_BUFFER_CAPACITY / 8];
+  unsigned char *binary_buffer = (unsigned char *)binary_memory;
+  unsigned long binary_buffer_size = 0;
+  unsigned char *mapped;
+  unsigned long mapped_size;
+  unsigned long i;
+
+  float triangle_vertices[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+  int triangle_indices[] = {0, 1, 2};
+  float line_vertices[] = {-1.0f, -2.0f, -3.0f, 4.0f, 5.0f, 6.0f};
+
+  char *name;
+  unsigned long name_length;
+  unsigned char *binary;
+  unsigned long binary_size;
+
+  rgf_pak_builder builder;
+  rgf_model model = {0};
+  rgf_model line = {0};
+  rgf_model loaded = {0};
+
+  model.vertices = triangle_vertices;
+  model.vertices_size = 9;
+  model.indices = triangle_indices;
+  model.indices_size = 3;
+
+  line.vertices = line_vertices;
+  line.vertices_size = 6;
+
+  /* Room for 3 models: 8 slots */
+  assert(!rgf_pak_begin(&builder, pak, 64, 3));
+  assert(rgf_pak_begin(&builder, pak, 4096, 3));
+  assert(builder.slot_count == 8);
+
+  assert(rgf_pak_add(&builder, "triangle", 8, &model));
+  assert(rgf_pak_add(&builder, "line", 4, &line));
+  assert(!rgf_pak_add(&builder, "line", 4, &model));
+
+  /* Already encoded binaries are copied as they are */
+  assert(rgf_binary_encode(binary_buffer, BINARY_BUFFER_CAPACITY, &binary_buffer_size, &line));
+  assert(rgf_pak_add_binary(&builder, "meshes/line_copy", 16, binary_buffer, binary_buffer_size));
+  assert(!rgf_pak_add(&builder, "full", 4, &model));
+  assert(builder.count == 3);
+
+  assert(rgf_pak_find(pak, builder.size, "triangle", 8) == 0);
+  assert(rgf_pak_find(pak, builder.size, "meshes/line_copy", 16) == 2);
+  assert(rgf_pak_find(pak, builder.size, "line", 3) == -1);
+  assert(rgf_pak_find(pak, builder.size, "cube", 4) == -1);
+
+  assert(rgf_pak_entry(pak, builder.size, 1, &name, &name_length, &binary, &binary_size));
+  assert(name_length == 4 && name[0] == 'l' && name[3] == 'e');
+  assert((unsigned long)(binary - pak) % RGF_BINARY_ALIGNMENT == 0);
+  assert(!rgf_pak_entry(pak, builder.size, 3, &name, &name_length, &binary, &binary_size));
+
+  /* The arrays point into the pack */
+  assert(rgf_pak_load(pak, builder.size, "line", 4, &loaded));
+  assert(loaded.vertices_size == 6);
+  assert(loaded.vertices[5] == 6.0f);
+  assert((unsigned char *)loaded.vertices > pak && (unsigned char *)loaded.vertices < pak + builder.size);
+  assert(!rgf_pak_load(pak, builder.size, "cube", 4, &loaded));
+  assert(!rgf_pak_load(pak, 12, "line", 4, &loaded));
+
+  /* One mapping for all models */
+  assert(rgf_platform_write("test.rgfpak", pak, builder.size));
+  assert(rgf_platform_map("test.rgfpak", &mapped, &mapped_size));
+  assert(mapped_size == builder.size);
+  assert(rgf_pak_load(mapped, mapped_size, "triangle", 8, &loaded));
+  assert(loaded.indices_size == 3);
+  assert(loaded.indices[2] == 2);
+  assert(loaded.vertices[7] == 1.0f);
+  assert(rgf_pak_load(mapped, mapped_size, "meshes/line_copy", 16, &loaded));
+  assert(loaded.vertices[0] == -1.0f);
+  rgf_platform_unmap(mapped, mapped_size);
+
+  /* Failed adds leave no hash slot behind */
+  assert(rgf_pak_begin(&builder, pak, 256, 3));
+
+  for (i = 0; i < 16; ++i)
+  {
+    assert(!rgf_pak_add_binary(&builder, "big", 3, binary_buffer, 256));
+  }
+
+  for (i = 0; i < builder.slot_count; ++i)
+  {
+    assert(rgf_binary_read_ul(pak + RGF_PAK_SIZE_HEADER + i * 4) == 0);
+  }
+
+  assert(builder.count == 0);
+  assert(rgf_pak_add_binary(&builder, "big", 3, binary_buffer, 8));
+  assert(rgf_pak_find(pak, builder.size, "big", 3) == 0);
+}
+
+void rgf_test_interleaved(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  float *normals_buffer = malloc(30000 * sizeof(float));
+  float *uvs_buffer = malloc(20000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  rgf_submesh *submeshes_buffer = malloc(512 * sizeof(rgf_submesh));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned char *interleaved_buffer = malloc(400000);
+  float *decoded = malloc(80000 * sizeof(float));
+  unsigned long binary_buffer_size = 0;
+  unsigned long vertex_count = 0;
+  unsigned long i;
+  int equal = 1;
+
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long sections_size = 0;
+  rgf_vertex_layout layout;
+  rgf_vertex_layout binary_layout;
+
+  rgf_model binary_model = {0};
+  rgf_model split_model = {0};
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.submeshes = submeshes_buffer;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+
+  /* head.obj has no normals and uvs */
+  model.normals = normals_buffer;
+  rgf_model_calculate_normals(&model);
+  model.normals_size = model.vertices_size;
+  model.uvs = uvs_buffer;
+  model.uvs_size = model.vertices_size / 3 * 2;
+
+  for (i = 0; i < model.uvs_size; ++i)
+  {
+    model.uvs[i] = (float)i * 0.25f;
+  }
+
+  /* Packed: 8 floats per vertex */
+  rgf_vertex_layout_packed(&layout, RGF_VERTEX_BIT(RGF_VERTEX_POSITION) | RGF_VERTEX_BIT(RGF_VERTEX_NORMAL) | RGF_VERTEX_BIT(RGF_VERTEX_UV));
+  assert(layout.stride == 32);
+  assert(layout.offsets[RGF_VERTEX_NORMAL] == 12);
+  assert(layout.offsets[RGF_VERTEX_UV] == 24);
+
+  /* Padded, uvs before normals */
+  layout.stride = 40;
+  layout.offsets[RGF_VERTEX_UV] = 16;
+  layout.offsets[RGF_VERTEX_NORMAL] = 28;
+
+  assert(rgf_model_interleave(&model, &layout, interleaved_buffer));
+  assert(((float *)(void *)interleaved_buffer)[10 + 4] == model.uvs[2]);
+  assert(((float *)(void *)interleaved_buffer)[10 + 9] == model.normals[5]);
+
+  split_model.vertices = decoded;
+  split_model.normals = decoded + 30000;
+  split_model.uvs = decoded + 60000;
+  split_model.flags = RGF_MODEL_FLAG_TRANSFORM_PENDING;
+  assert(rgf_model_deinterleave(&split_model, &layout, interleaved_buffer, model.vertices_size / 3));
+  assert(!(split_model.flags & RGF_MODEL_FLAG_TRANSFORM_PENDING));
+  assert(split_model.vertices_size == model.vertices_size);
+  assert(split_model.normals_size == model.normals_size);
+  assert(split_model.uvs_size == model.uvs_size);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= split_model.vertices[i] == model.vertices[i];
+    equal &= split_model.normals[i] == model.normals[i];
+  }
+
+  for (i = 0; i < model.uvs_size; ++i)
+  {
+    equal &= split_model.uvs[i] == model.uvs[i];
+  }
+
+  assert(equal);
+
+  /* Bytes outside the attributes are left to the caller */
+  {
+    rgf_vertex_layout gap_layout;
+    float *floats = (float *)(void *)interleaved_buffer;
+
+    rgf_vertex_layout_packed(&gap_layout, RGF_VERTEX_BIT(RGF_VERTEX_POSITION) | RGF_VERTEX_BIT(RGF_VERTEX_UV));
+    gap_layout.stride = 40;
+    gap_layout.offsets[RGF_VERTEX_UV] = 12;
+
+    for (i = 0; i < model.vertices_size / 3 * 10; ++i)
+    {
+      floats[i] = -1.0f;
+    }
+
+    assert(rgf_model_interleave(&model, &gap_layout, interleaved_buffer));
+
+    for (i = 0; i < model.vertices_size / 3; ++i)
+    {
+      equal &= floats[i * 10 + 3] == model.uvs[i * 2] && floats[i * 10 + 4] == model.uvs[i * 2 + 1];
+      equal &= floats[i * 10 + 5] == -1.0f && floats[i * 10 + 6] == -1.0f && floats[i * 10 + 9] == -1.0f;
+    }
+
+    assert(equal);
+  }
+
+  /* One section for the interleaved attributes, the padding is stored as zeros */
+  for (i = 0; i < 1500000; ++i)
+  {
+    binary_buffer[i] = 0xAB;
+  }
+
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, 0, 0, &layout));
+  assert(rgf_binary_decode_header(binary_buffer, binary_buffer_size, &binary_model, sections, &sections_size));
+  assert(sections_size == 3);
+  assert(sections[0].type == RGF_BINARY_SECTION_INDICES);
+  assert(sections[2].type == RGF_BINARY_SECTION_INTERLEAVED);
+  assert(sections[2].size == RGF_BINARY_SIZE_LAYOUT + model.vertices_size / 3 * 40);
+
+  /* The vertices can be uploaded as they are stored */
+  assert(rgf_binary_read_layout(&sections[2], binary_buffer + sections[2].offset, &binary_layout, &vertex_count));
+  assert(vertex_count == model.vertices_size / 3);
+  assert(binary_layout.stride == 40 && binary_layout.offsets[RGF_VERTEX_NORMAL] == 28);
+
+  for (i = 0; i < vertex_count; ++i)
+  {
+    unsigned char *vertex = binary_buffer + sections[2].offset + RGF_BINARY_SIZE_LAYOUT + i * 40;
+
+    equal &= vertex[12] == 0 && vertex[15] == 0 && vertex[24] == 0 && vertex[27] == 0;
+  }
+
+  assert(equal);
+
+  /* Or split into the model arrays */
+  assert(!rgf_binary_decode(binary_buffer, binary_buffer_size, &binary_model));
+  assert(!rgf_binary_decode_section(&binary_model, &sections[2], binary_buffer + sections[2].offset));
+  assert(rgf_binary_section_decoded_size(&sections[2]) == (model.vertices_size * 2 + model.uvs_size) * sizeof(float));
+  assert(rgf_binary_decode_section_to(&binary_model, &sections[2], binary_buffer + sections[2].offset, decoded));
+  assert(binary_model.vertices == decoded && binary_model.vertices_size == model.vertices_size);
+  assert(binary_model.normals_size == model.normals_size);
+  assert(binary_model.uvs_size == model.uvs_size);
+  assert(binary_model.flags & RGF_MODEL_FLAG_NORMALS_PROVIDED);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= binary_model.vertices[i] == model.vertices[i];
+    equal &= binary_model.normals[i] == model.normals[i];
+  }
+
+  for (i = 0; i < model.uvs_size; ++i)
+  {
+    equal &= binary_model.uvs[i] == model.uvs[i];
+  }
+
+  assert(equal);
+
+  /* A stored size that does not match the layout */
+  sections[2].size -= 4;
+  assert(!rgf_binary_read_layout(&sections[2], binary_buffer + sections[2].offset, &binary_layout, &vertex_count));
+  sections[2].size += 4;
+
+  /* Overlapping attributes, attribute outside of the stride, missing attribute, quantized */
+  layout.offsets[RGF_VERTEX_NORMAL] = 20;
+  assert(!rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, 0, 0, &layout));
+  layout.offsets[RGF_VERTEX_NORMAL] = 32;
+  assert(!rgf_model_interleave(&model, &layout, interleaved_buffer));
+  layout.offsets[RGF_VERTEX_NORMAL] = 28;
+  layout.attributes |= RGF_VERTEX_BIT(RGF_VERTEX_TANGENT);
+  assert(!rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, 0, 0, &layout));
+  layout.attributes &= ~RGF_VERTEX_BIT(RGF_VERTEX_TANGENT);
+  {
+    unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+    encodings[RGF_BINARY_SECTION_INTERLEAVED] = RGF_BINARY_ENCODING_HALF;
+    assert(!rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, &layout));
+  }
+
+  free(vertices_buffer);
+  free(normals_buffer);
+  free(uvs_buffer);
+  free(indices_buffer);
+  free(submeshes_buffer);
+  free(binary_buffer);
+  free(interleaved_buffer);
+  free(decoded);
+}
+
+void rgf_test_index_width(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  float *normals_buffer = malloc(30000 * sizeof(float));
+  float *narrow_normals_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  int *original_indices = malloc(60000 * sizeof(int));
+  rgf_submesh *submeshes_buffer = malloc(512 * sizeof(rgf_submesh));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned char *stream_buffer = malloc(1500000);
+  int *decoded = malloc(60000 * sizeof(int));
+  unsigned long binary_buffer_size = 0;
+  unsigned long fifo_size = 0;
+  unsigned long stream_size = 0;
+  unsigned long i;
+  int equal = 1;
+
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long sections_size = 0;
+  rgf_test_sink sink;
+
+  float tiny_vertices[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+  int tiny_indices[] = {0, 1, 2};
+  int negative_indices[] = {0, -1, 2};
+
+  rgf_model binary_model = {0};
+  rgf_model tiny = {0};
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.submeshes = submeshes_buffer;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+  assert(model.index_width == 4);
+
+  model.normals = normals_buffer;
+  rgf_model_calculate_normals(&model);
+  rgf_binary_memcpy(original_indices, model.indices, model.indices_size * sizeof(int));
+  assert(rgf_binary_encode_triangles(binary_buffer, model.indices, model.indices_size, &fifo_size));
+
+  /* 8844 vertices: 16 bit indices, narrowed in place */
+  assert(rgf_model_index_max(&model) == 8843);
+  assert(rgf_model_narrow_indices(&model));
+  assert(model.index_width == 2);
+  assert(((unsigned short *)(void *)model.indices)[model.indices_size - 1] == 1263);
+
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    equal &= rgf_model_index(&model, i) == (unsigned long)original_indices[i];
+  }
+
+  assert(equal);
+
+  /* The processing functions give the same result at any width */
+  model.normals = narrow_normals_buffer;
+  rgf_model_calculate_normals(&model);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= narrow_normals_buffer[i] == normals_buffer[i];
+  }
+
+  assert(equal);
+  model.normals = 0;
+
+  /* Narrowed models are encoded narrowed, the decoded indices point into the binary */
+  assert(rgf_binary_index_encoding(&model) == RGF_BINARY_ENCODING_INDEX16);
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, 0, 0, 0));
+  assert(rgf_binary_decode_header(binary_buffer, binary_buffer_size, &binary_model, sections, &sections_size));
+  assert(sections[1].type == RGF_BINARY_SECTION_INDICES);
+  assert(sections[1].encoding == RGF_BINARY_ENCODING_INDEX16);
+  assert(sections[1].size == model.indices_size * 2);
+
+  assert(rgf_binary_decode(binary_buffer, binary_buffer_size, &binary_model));
+  assert(binary_model.index_width == 2);
+  assert((unsigned char *)binary_model.indices == binary_buffer + sections[1].offset);
+  assert(rgf_model_index(&binary_model, model.indices_size - 6) == 7904);
+
+  /* Or expanded to ints */
+  assert(rgf_binary_decode_section_to(&binary_model, &sections[1], binary_buffer + sections[1].offset, decoded));
+  assert(binary_model.index_width == 4);
+  assert(decoded[model.indices_size - 1] == 1263);
+
+  /* Streamed the same way */
+  sink.buffer = stream_buffer;
+  sink.size = 0;
+  sink.capacity = 1500000;
+  sink.calls = 0;
+  assert(rgf_binary_encode_stream(&model, 0, rgf_test_sink_write, &sink, &stream_size));
+  assert(stream_size == binary_buffer_size);
+
+  for (i = 0; i < binary_buffer_size; ++i)
+  {
+    equal &= stream_buffer[i] == binary_buffer[i];
+  }
+
+  assert(equal);
+
+  /* Explicit RAW widens, TRIANGLE_FIFO reads any width */
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, 0));
+  assert(rgf_binary_decode(binary_buffer, binary_buffer_size, &binary_model));
+  assert(binary_model.index_width == 4);
+  assert(binary_model.indices[model.indices_size - 1] == 1263);
+
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_TRIANGLE_FIFO;
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, 0));
+  assert(rgf_binary_decode_header(binary_buffer, binary_buffer_size, &binary_model, sections, &sections_size));
+  assert(sections[1].size == fifo_size);
+
+  /* Indices that do not fit */
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_INDEX8;
+  assert(!rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, 0));
+
+  /* Tiny meshes get 8 bit indices */
+  tiny.vertices = tiny_vertices;
+  tiny.vertices_size = 9;
+  tiny.indices = tiny_indices;
+  tiny.indices_size = 3;
+  assert(rgf_binary_index_encoding(&tiny) == RGF_BINARY_ENCODING_INDEX8);
+  assert(rgf_binary_model_index_encoding(&tiny) == RGF_BINARY_ENCODING_RAW);
+  assert(rgf_model_narrow_indices(&tiny));
+  assert(tiny.index_width == 1);
+  assert(rgf_binary_model_index_encoding(&tiny) == RGF_BINARY_ENCODING_INDEX8);
+  assert(((unsigned char *)tiny.indices)[2] == 2);
+
+  tiny.indices = negative_indices;
+  tiny.index_width = 4;
+  assert(!rgf_model_narrow_indices(&tiny));
+  assert(tiny.index_width == 4);
+  assert(negative_indices[1] == -1);
+
+  free(vertices_buffer);
+  free(normals_buffer);
+  free(narrow_normals_buffer);
+  free(indices_buffer);
+  free(original_indices);
+  free(submeshes_buffer);
+  free(binary_buffer);
+  free(stream_buffer);
+  free(decoded);
+}
+
+void rgf_test_memcpy(void)
+{
+  unsigned long sizes[] = {0, 1, 7, 8, 63, 64, 127, 128, 129, 1000, RGF_MEMCPY_STREAM_SIZE + 3};
+  unsigned char *src = malloc(RGF_MEMCPY_STREAM_SIZE + 64);
+  unsigned char *dest = malloc(RGF_MEMCPY_STREAM_SIZE + 64);
+  unsigned long size_index;
+  unsigned long offset;
+  unsigned long i;
+  int equal = 1;
+
+  for (i = 0; i < RGF_MEMCPY_STREAM_SIZE + 64; ++i)
+  {
+    src[i] = (unsigned char)(i * 7 + 3);
+  }
+
+  /* Every head alignment of src and dest, the bytes around the copy stay untouched */
+  for (size_index = 0; size_index < sizeof(sizes) / sizeof(sizes[0]); ++size_index)
+  {
+    for (offset = 0; offset < 16; ++offset)
+    {
+      unsigned long size = sizes[size_index];
+      unsigned char *d = dest + (offset * 5) % 16 + 1;
+      unsigned char *s = src + offset;
+
+      d[-1] = 0xAA;
+      d[size] = 0xAA;
+
+      equal &= rgf_binary_memcpy(d, s, size) == d;
+      equal &= d[-1] == 0xAA && d[size] == 0xAA;
+
+      for (i = 0; i < size; ++i)
+      {
+        equal &= d[i] == s[i];
+      }
+    }
+  }
+
+  assert(equal);
+
+  free(src);
+  free(dest);
+}
+
+void rgf_test_encode_parallel(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  float *normals_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  rgf_submesh *submeshes_buffer = malloc(512 * sizeof(rgf_submesh));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned char *parallel_buffer = malloc(1500000);
+  unsigned char *decoded_buffer = malloc(1500000);
+  unsigned char *serial_buffer = malloc(1500000);
+  unsigned long binary_buffer_size = 0;
+  unsigned long parallel_buffer_size = 0;
+  unsigned long i;
+  int equal = 1;
+
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+  unsigned long compressions[RGF_BINARY_SECTION_COUNT];
+  rgf_binary_section sections[RGF_BINARY_SECTION_COUNT];
+  unsigned long sections_size = 0;
+  rgf_vertex_layout layout;
+
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+
+  rgf_model binary_model = {0};
+  rgf_model serial_model = {0};
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.submeshes = submeshes_buffer;
+
+  rgf_platform_threads_init(&threads, 8);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+
+  model.normals = normals_buffer;
+  rgf_model_calculate_normals(&model);
+  model.normals_size = model.vertices_size;
+  rgf_model_calculate_boundaries(&model);
+
+  /* Raw with narrowed indices: every section has a fixed size */
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, 0, 0, 0));
+  assert(rgf_binary_encode_sections_parallel(parallel_buffer, 1500000, &parallel_buffer_size, &model, 0, 0, 0, &jobs));
+  assert(parallel_buffer_size == binary_buffer_size);
+
+  for (i = 0; i < binary_buffer_size; ++i)
+  {
+    equal &= parallel_buffer[i] == binary_buffer[i];
+  }
+
+  assert(equal);
+
+  /* Quantized, chunks start at whole vertices. TRIANGLE_FIFO is moved down behind the normals */
+  encodings[RGF_BINARY_SECTION_VERTICES] = RGF_BINARY_ENCODING_UNORM16;
+  encodings[RGF_BINARY_SECTION_NORMALS] = RGF_BINARY_ENCODING_OCTAHEDRAL;
+  encodings[RGF_BINARY_SECTION_INDICES] = RGF_BINARY_ENCODING_TRIANGLE_FIFO;
+
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, 0));
+  assert(rgf_binary_encode_sections_parallel(parallel_buffer, 1500000, &parallel_buffer_size, &model, encodings, 0, 0, &jobs));
+  assert(parallel_buffer_size == binary_buffer_size);
+
+  for (i = 0; i < binary_buffer_size; ++i)
+  {
+    equal &= parallel_buffer[i] == binary_buffer[i];
+  }
+
+  assert(equal);
+
+  /* Every section has to fit at its bound while encoding */
+  assert(!rgf_binary_encode_sections_parallel(parallel_buffer, binary_buffer_size, &parallel_buffer_size, &model, encodings, 0, 0, &jobs));
+
+  /* Decoded in parallel like section by section */
+  assert(rgf_binary_decode_parallel(parallel_buffer, binary_buffer_size, &binary_model, decoded_buffer, 1500000, &jobs));
+  assert(rgf_binary_decode_header(binary_buffer, binary_buffer_size, &serial_model, sections, &sections_size));
+  assert(sections_size == 4);
+
+  for (i = 0; i < sections_size; ++i)
+  {
+    assert(rgf_binary_decode_section_to(&serial_model, &sections[i], binary_buffer + sections[i].offset, serial_buffer + sections[i].offset * 4));
+  }
+
+  assert(binary_model.vertices_size == model.vertices_size && binary_model.normals_size == model.normals_size);
+  assert(binary_model.indices_size == model.indices_size && binary_model.submeshes_size == 296);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= binary_model.vertices[i] == serial_model.vertices[i] && binary_model.normals[i] == serial_model.normals[i];
+  }
+
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    equal &= binary_model.indices[i] == model.indices[i];
+  }
+
+  assert(equal);
+  assert(binary_model.submeshes[295].index_offset == 52992);
+
+  /* Too small for the arrays */
+  assert(!rgf_binary_decode_parallel(parallel_buffer, binary_buffer_size, &binary_model, decoded_buffer, model.vertices_size * 4, &jobs));
+
+  /* Compressed sections are encoded by one job each */
+  for (i = 0; i < RGF_BINARY_SECTION_COUNT; ++i)
+  {
+    compressions[i] = RGF_BINARY_COMPRESSION_LZ;
+  }
+
+  compressions[RGF_BINARY_SECTION_VERTICES] = RGF_BINARY_COMPRESSION_NONE;
+
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, compressions, 0));
+  assert(rgf_binary_encode_sections_parallel(parallel_buffer, 1500000, &parallel_buffer_size, &model, encodings, compressions, 0, &jobs));
+  assert(parallel_buffer_size == binary_buffer_size);
+
+  for (i = 0; i < binary_buffer_size; ++i)
+  {
+    equal &= parallel_buffer[i] == binary_buffer[i];
+  }
+
+  assert(equal);
+  assert(!rgf_binary_decode_parallel(parallel_buffer, parallel_buffer_size, &binary_model, decoded_buffer, 1500000, &jobs));
+
+  /* Interleaved vertices are split by vertex */
+  rgf_vertex_layout_packed(&layout, RGF_VERTEX_BIT(RGF_VERTEX_POSITION) | RGF_VERTEX_BIT(RGF_VERTEX_NORMAL));
+
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, 0, 0, &layout));
+  assert(rgf_binary_encode_sections_parallel(parallel_buffer, 1500000, &parallel_buffer_size, &model, 0, 0, &layout, &jobs));
+  assert(parallel_buffer_size == binary_buffer_size);
+
+  for (i = 0; i < binary_buffer_size; ++i)
+  {
+    equal &= parallel_buffer[i] == binary_buffer[i];
+  }
+
+  assert(equal);
+  assert(rgf_binary_decode_parallel(parallel_buffer, parallel_buffer_size, &binary_model, decoded_buffer, 1500000, &jobs));
+  assert(binary_model.vertices_size == model.vertices_size && binary_model.normals_size == model.normals_size);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= binary_model.vertices[i] == model.vertices[i] && binary_model.normals[i] == model.normals[i];
+  }
+
+  for (i = 0; i < model.indices_size; ++i)
+  {
+    equal &= rgf_model_index(&binary_model, i) == rgf_model_index(&model, i);
+  }
+
+  assert(equal);
+
+  /* An attribute of the interleaved section that also has its own section is rejected,
+     here the submeshes retyped to a smaller vertices section behind it
+  */
+  for (i = 0; i < rgf_binary_read_ul(parallel_buffer + 12); ++i)
+  {
+    unsigned char *entry = parallel_buffer + RGF_BINARY_SIZE_HEADER_V2 + i * RGF_BINARY_SIZE_DIRECTORY_ENTRY;
+
+    if (rgf_binary_read_ul(entry) == RGF_BINARY_SECTION_SUBMESHES)
+    {
+      rgf_binary_write_u32(entry, RGF_BINARY_SECTION_VERTICES);
+      rgf_binary_write_u32(entry + 24, 296 * 3);
+    }
+  }
+
+  assert(!rgf_binary_decode_parallel(parallel_buffer, parallel_buffer_size, &binary_model, decoded_buffer, 1500000, &jobs));
+
+  /* Without a job system everything runs on the calling thread */
+  assert(rgf_binary_encode_sections_parallel(parallel_buffer, 1500000, &parallel_buffer_size, &model, encodings, compressions, &layout, 0));
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, compressions, &layout));
+  assert(parallel_buffer_size == binary_buffer_size);
+
+  for (i = 0; i < binary_buffer_size; ++i)
+  {
+    equal &= parallel_buffer[i] == binary_buffer[i];
+  }
+
+  assert(equal);
+
+  free(vertices_buffer);
+  free(normals_buffer);
+  free(indices_buffer);
+  free(submeshes_buffer);
+  free(binary_buffer);
+  free(parallel_buffer);
+  free(decoded_buffer);
+  free(serial_buffer);
+}
+
+void rgf_test_bounds(void)
+{
+  unsigned long count = 600000 * 3;
+  float *vertices = malloc(count * sizeof(float));
+  float small[] = {1.0f, 2.0f, 3.0f, -1.0f, 5.0f, 0.0f, 4.0f, -2.0f, 9.0f};
+  float min[3] = {1e30f, 1e30f, 1e30f};
+  float max[3] = {-1e30f, -1e30f, -1e30f};
+  float expected_min[3];
+  float expected_max[3];
+  float zero = 0.0f;
+  unsigned long i;
+
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+
+  rgf_model model = {0};
+
+  for (i = 0; i < count; ++i)
+  {
+    vertices[i] = (float)((i * 7919) % 10007) - 5000.0f;
+  }
+
+  /* Extremes of every component at a different lane and in the scalar tail */
+  vertices[13 * 3 + 0] = -6000.0f;
+  vertices[250000 * 3 + 1] = 7000.0f;
+  vertices[599999 * 3 + 2] = -8000.0f;
+  vertices[5 * 3 + 1] = zero / zero;
+
+  expected_min[0] = -6000.0f;
+  expected_max[0] = 5006.0f;
+  expected_min[1] = -5000.0f;
+  expected_max[1] = 7000.0f;
+  expected_min[2] = -8000.0f;
+  expected_max[2] = 5006.0f;
+
+  /* 3 vertices: only the scalar tail */
+  rgf_bounds_reduce(min, max, small, 9);
+  assert(min[0] == -1.0f && min[1] == -2.0f && min[2] == 0.0f);
+  assert(max[0] == 4.0f && max[1] == 5.0f && max[2] == 9.0f);
+
+  min[0] = min[1] = min[2] = 1e30f;
+  max[0] = max[1] = max[2] = -1e30f;
+
+  /* NaN components are skipped */
+  rgf_bounds_reduce(min, max, vertices, count);
+  assert(min[0] == expected_min[0] && min[1] == expected_min[1] && min[2] == expected_min[2]);
+  assert(max[0] == expected_max[0] && max[1] == expected_max[1] && max[2] == expected_max[2]);
+
+  rgf_platform_threads_init(&threads, 8);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  min[0] = min[1] = min[2] = 1e30f;
+  max[0] = max[1] = max[2] = -1e30f;
+
+  rgf_bounds_reduce_parallel(min, max, vertices, count, &jobs);
+  assert(min[0] == expected_min[0] && min[1] == expected_min[1] && min[2] == expected_min[2]);
+  assert(max[0] == expected_max[0] && max[1] == expected_max[1] && max[2] == expected_max[2]);
+
+  /* The model bounds and center */
+  vertices[5 * 3 + 1] = 0.0f;
+  model.vertices = vertices;
+  model.vertices_size = count;
+
+  rgf_model_calculate_boundaries_parallel(&model, &jobs);
+  assert(model.min_x == -6000.0f && model.max_y == 7000.0f && model.min_z == -8000.0f);
+  assert(model.center_y == 1000.0f);
+  assert(model.original_max_dim == 13006.0f);
+
+  rgf_model_scale(&model, 2.0f);
+  rgf_model_scale_reset(&model);
+  assert(model.min_x == -6000.0f && model.max_y == 7000.0f && model.min_z == -8000.0f);
+
+  free(vertices);
+}
+
+void rgf_test_transform(void)
+{
+  /* 5 of each, so the SIMD paths and the scalar tails both run */
+  float vertices[] = {1.0f, 2.0f, 3.0f, -1.0f, 0.0f, 0.5f, 4.0f, -2.0f, 1.0f, 0.0f, 0.0f, 0.0f, 2.0f, 2.0f, -3.0f};
+  float normals[] = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.6f, 0.8f, 0.0f, 0.0f, 0.0f, 0.0f};
+  float tangents[] = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.6f, 0.8f, 0.0f, 0.0f, 0.0f, 1.0f};
+  float rotate[] = {0.0f, -1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 1.0f, 3.0f};
+  float stretch[] = {2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+  float mirror[] = {-1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+  unsigned long i;
+
+  rgf_model model = {0};
+  model.vertices = vertices;
+  model.normals = normals;
+  model.tangents = tangents;
+  model.vertices_size = 15;
+  model.normals_size = 15;
+  model.tangents_size = 15;
+
+  rgf_model_calculate_boundaries(&model);
+
+  /* 90 degrees around z and a translation */
+  rgf_model_transform(&model, rotate);
+  assert(vertices[0] == -1.0f && vertices[1] == 3.0f && vertices[2] == 6.0f);
+  assert(vertices[12] == -1.0f && vertices[13] == 4.0f && vertices[14] == 0.0f);
+  assert(normals[0] == 0.0f && normals[1] == 1.0f && normals[2] == 0.0f);
+  assert_equalsf(normals[9], -0.8f, 1e-6f);
+  assert_equalsf(normals[10], 0.6f, 1e-6f);
+  assert(normals[12] == 0.0f && normals[13] == 0.0f && normals[14] == 0.0f);
+  assert(tangents[3] == -1.0f && tangents[4] == 0.0f);
+
+  /* Exact bounds for right angles */
+  assert(model.min_x == -1.0f && model.max_x == 3.0f);
+  assert(model.min_y == 1.0f && model.max_y == 6.0f);
+  assert(model.min_z == 0.0f && model.max_z == 6.0f);
+  assert(model.center_x == 1.0f && model.center_y == 3.5f && model.center_z == 3.0f);
+
+  /* Normals use the inverse transpose, tangents the matrix */
+  normals[9] = tangents[9] = 0.6f;
+  normals[10] = tangents[10] = 0.8f;
+  normals[11] = tangents[11] = 0.0f;
+
+  rgf_model_transform(&model, stretch);
+  assert(vertices[0] == -2.0f && model.min_x == -2.0f && model.max_x == 6.0f);
+  assert_equalsf(normals[9], 0.3f / rgf_sqrtf(0.09f + 0.64f), 1e-5f);
+  assert_equalsf(normals[10], 0.8f / rgf_sqrtf(0.09f + 0.64f), 1e-5f);
+  assert_equalsf(tangents[9], 1.2f / rgf_sqrtf(1.44f + 0.64f), 1e-5f);
+  assert_equalsf(tangents[10], 0.8f / rgf_sqrtf(1.44f + 0.64f), 1e-5f);
+
+  /* Mirrored normals stay on the outside */
+  rgf_model_transform(&model, mirror);
+  assert(vertices[0] == 2.0f && model.min_x == -6.0f && model.max_x == 2.0f);
+  assert(normals[3] == 1.0f && normals[4] == 0.0f);
+
+  for (i = 0; i < 3; ++i)
+  {
+    assert_equalsf(normals[i], i == 1 ? 1.0f : 0.0f, 1e-6f);
+  }
+
+  /* Uniform scales leave directions as they are */
+  normals[0] = 0.5f;
+  rgf_model_scale(&model, 1.0f);
+  assert(normals[0] == 0.5f);
+}
+
+void rgf_test_normalize(void)
+{
+  /* 5 vectors, so the SIMD step and the scalar tail both run */
+  float vectors[] = {3.0f, 0.0f, 4.0f, 0.0f, 0.0f, 0.0f, 1e30f, -1e30f, 0.0f, 0.0f, 2e-30f, 0.0f, 0.0f, -0.5f, 0.0f};
+  float expected[] = {0.6f, 0.0f, 0.8f, 0.0f, 0.0f, 0.0f, 0.70710678f, -0.70710678f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, -1.0f, 0.0f};
+  float normalized[15];
+  float vertices[] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, -1.0f};
+  int indices[] = {0, 1, 2, 0, 3, 1};
+  float normals[12];
+  unsigned long i;
+
+  rgf_model model = {0};
+  model.vertices = vertices;
+  model.indices = indices;
+  model.normals = normals;
+  model.vertices_size = 12;
+  model.indices_size = 6;
+
+  /* Exact over the whole float range */
+  assert(rgf_sqrtf(4.0f) == 2.0f);
+  assert(rgf_sqrtf(1.0f) == 1.0f);
+  assert(rgf_sqrtf(0.0f) == 0.0f);
+  assert_equalsf(rgf_sqrtf(1e6f), 1000.0f, 1e-4f);
+  assert_equalsf(rgf_sqrtf(1e30f) / 1e15f, 1.0f, RGF_TEST_EPSILON);
+  assert_equalsf(rgf_sqrtf(1e-30f) / 1e-15f, 1.0f, RGF_TEST_EPSILON);
+  assert_equalsf(rgf_sqrtf(1e-40f) / 1e-20f, 1.0f, 1e-5f);
+  assert_equalsf(rgf_atan2f(1.0f, -1.0f), 2.35619449f, 2e-6f);
+  assert_equalsf(rgf_atan2f(-1.0f, 2.0f), -0.46364761f, 2e-6f);
+
+  rgf_v3_normalize_batch(normalized, vectors, 15);
+
+  for (i = 0; i < 15; ++i)
+  {
+    assert_equalsf(normalized[i], expected[i], 1e-6f);
+  }
+
+  /* In place */
+  rgf_v3_normalize_batch(vectors, vectors, 15);
+  assert(vectors[0] == normalized[0] && vectors[14] == normalized[14]);
+
+  /* A right angle in the xy plane and a 45 degree corner facing -y of the same area */
+  rgf_model_calculate_normals(&model);
+  assert_equalsf(normals[0], 0.0f, 1e-6f);
+  assert_equalsf(normals[1], -0.70710678f, 1e-6f);
+  assert_equalsf(normals[2], 0.70710678f, 1e-6f);
+
+  rgf_model_calculate_normals_weighted(&model, RGF_NORMALS_WEIGHT_ANGLE, 0);
+  assert_equalsf(normals[0], 0.0f, 1e-6f);
+  assert_equalsf(normals[1], -1.0f / 2.23606798f, 1e-5f);
+  assert_equalsf(normals[2], 2.0f / 2.23606798f, 1e-5f);
+
+  /* The other shared vertex has the 45 degree corner in the xy plane */
+  assert_equalsf(normals[3], 0.0f, 1e-6f);
+  assert_equalsf(normals[4], -2.0f / 2.23606798f, 1e-5f);
+  assert_equalsf(normals[5], 1.0f / 2.23606798f, 1e-5f);
+
+  /* A vertex of a single triangle keeps the face normal */
+  assert_equalsf(normals[8], 1.0f, 1e-6f);
+  assert_equalsf(normals[10], -1.0f, 1e-6f);
+}
+
+void rgf_test_transform_deferred(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  float *original = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned long binary_buffer_size = 0;
+  unsigned long encodings[RGF_BINARY_SECTION_COUNT] = {0};
+  float center[3];
+  float extent_x;
+  unsigned long i;
+  int equal = 1;
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+  assert(!(model.flags & RGF_MODEL_FLAG_TRANSFORM_PENDING));
+
+  rgf_binary_memcpy(original, model.vertices, model.vertices_size * sizeof(float));
+  center[0] = model.center_x;
+  center[1] = model.center_y;
+  center[2] = model.center_z;
+  extent_x = model.max_x - model.min_x;
+
+  /* Edits only compose the pending transform and move the bounds */
+  rgf_model_center(&model, 0.0f, 0.0f, 0.0f);
+  rgf_model_scale(&model, 1.0f);
+  rgf_model_scale_reset(&model);
+  rgf_model_center_reset(&model);
+  rgf_model_scale(&model, 2.0f);
+  rgf_model_center(&model, 1.0f, 2.0f, 3.0f);
+
+  assert(model.flags & RGF_MODEL_FLAG_TRANSFORM_PENDING);
+  assert_equalsf(model.center_x, 1.0f, RGF_TEST_EPSILON);
+  assert_equalsf(model.max_x - model.min_x, 2.0f * extent_x / model.original_max_dim, 1e-5f);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= model.vertices[i] == original[i];
+  }
+
+  assert(equal);
+
+  /* Encoding applies it once, the bounds contain every transformed vertex */
+  encodings[RGF_BINARY_SECTION_VERTICES] = RGF_BINARY_ENCODING_UNORM16;
+  assert(rgf_binary_encode_sections(binary_buffer, 1500000, &binary_buffer_size, &model, encodings, 0, 0));
+  assert(!(model.flags & RGF_MODEL_FLAG_TRANSFORM_PENDING));
+  assert(!(rgf_binary_read_ul(binary_buffer + 8) & RGF_MODEL_FLAG_TRANSFORM_PENDING));
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    float expected = (original[i] - center[i % 3]) * 2.0f / model.original_max_dim + (float)(i % 3 + 1);
+
+    equal &= test_absf(model.vertices[i] - expected) < 1e-5f;
+  }
+
+  assert(equal);
+
+  /* Applying again does nothing */
+  model.vertices[0] = 42.0f;
+  rgf_model_apply_transform(&model);
+  assert(model.vertices[0] == 42.0f);
+
+  /* Parsing replaces the arrays the transform was pending for */
+  rgf_model_scale(&model, 3.0f);
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+  assert(!(model.flags & RGF_MODEL_FLAG_TRANSFORM_PENDING));
+
+  free(vertices_buffer);
+  free(original);
+  free(indices_buffer);
+  free(binary_buffer);
+}
+
+void rgf_test_adjacency(void)
+{
+  float *vertices_buffer = malloc(30000 * sizeof(float));
+  int *indices_buffer = malloc(60000 * sizeof(int));
+  float *uvs_buffer = malloc(100000 * sizeof(float));
+  float *normals_buffer = malloc(30000 * sizeof(float));
+  float *tangents_buffer = malloc(30000 * sizeof(float));
+  float *bitangents_buffer = malloc(30000 * sizeof(float));
+  float *scatter_buffer = malloc(90000 * sizeof(float));
+  unsigned int *offsets_buffer = malloc(10001 * sizeof(unsigned int));
+  unsigned int *triangles_buffer = malloc(60000 * sizeof(unsigned int));
+  unsigned char *binary_buffer = malloc(1500000);
+  unsigned long binary_buffer_size = 0;
+  unsigned long i;
+  unsigned long v;
+  int equal = 1;
+
+  rgf_platform_threads threads;
+  rgf_job_system jobs;
+
+  rgf_model model = {0};
+  model.vertices = vertices_buffer;
+  model.indices = indices_buffer;
+  model.uvs = uvs_buffer;
+  model.normals = normals_buffer;
+  model.tangents = tangents_buffer;
+  model.bitangents = bitangents_buffer;
+
+  rgf_platform_threads_init(&threads, 4);
+  jobs.dispatch = rgf_platform_threads_dispatch;
+  jobs.dispatch_context = &threads;
+  jobs.thread_count = threads.thread_count;
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+  assert(model.vertices_size <= 30000);
+
+  /* Scattered per triangle without adjacency buffers */
+  rgf_model_calculate_normals(&model);
+  rgf_model_calculate_tangents_bitangents(&model);
+  rgf_binary_memcpy(scatter_buffer, model.normals, model.vertices_size * sizeof(float));
+  rgf_binary_memcpy(scatter_buffer + 30000, model.tangents, model.vertices_size * sizeof(float));
+  rgf_binary_memcpy(scatter_buffer + 60000, model.bitangents, model.vertices_size * sizeof(float));
+
+  model.adjacency_offsets = offsets_buffer;
+  model.adjacency_triangles = triangles_buffer;
+  assert(rgf_model_build_adjacency(&model));
+  assert(model.flags & RGF_MODEL_FLAG_ADJACENCY);
+  assert(offsets_buffer[0] == 0);
+  assert(offsets_buffer[model.vertices_size / 3] == model.indices_size);
+
+  /* Every corner is listed at its vertex, triangles ascending */
+  for (v = 0; v < model.vertices_size / 3; ++v)
+  {
+    for (i = offsets_buffer[v]; i < offsets_buffer[v + 1]; ++i)
+    {
+      unsigned long triangle = triangles_buffer[i];
+
+      equal &= i == offsets_buffer[v] || triangles_buffer[i - 1] <= triangle;
+      equal &= rgf_model_index(&model, triangle * 3 + 0) == v || rgf_model_index(&model, triangle * 3 + 1) == v || rgf_model_index(&model, triangle * 3 + 2) == v;
+    }
+  }
+
+  assert(equal);
+
+  /* The gathered results are bit identical to the scattered ones */
+  rgf_model_calculate_normals_parallel(&model, &jobs);
+  rgf_model_calculate_tangents_bitangents_parallel(&model, &jobs);
+
+  for (i = 0; i < model.vertices_size * sizeof(float); ++i)
+  {
+    equal &= ((unsigned char *)model.normals)[i] == ((unsigned char *)scatter_buffer)[i];
+    equal &= ((unsigned char *)model.tangents)[i] == ((unsigned char *)(scatter_buffer + 30000))[i];
+    equal &= ((unsigned char *)model.bitangents)[i] == ((unsigned char *)(scatter_buffer + 60000))[i];
+  }
+
+  assert(equal);
+
+  /* Vertex ranges are independent of each other */
+  rgf_model_gather_normals(&model, RGF_NORMALS_WEIGHT_AREA, 100, model.vertices_size / 3 - 100);
+  rgf_model_gather_normals(&model, RGF_NORMALS_WEIGHT_AREA, 0, 100);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= model.normals[i] == scatter_buffer[i];
+  }
+
+  assert(equal);
+
+  /* Angle weights are gathered to the same bits */
+  model.adjacency_offsets = 0;
+  rgf_model_calculate_normals_weighted(&model, RGF_NORMALS_WEIGHT_ANGLE, &jobs);
+  rgf_binary_memcpy(scatter_buffer, model.normals, model.vertices_size * sizeof(float));
+  model.adjacency_offsets = offsets_buffer;
+  rgf_model_calculate_normals_weighted(&model, RGF_NORMALS_WEIGHT_ANGLE, &jobs);
+
+  for (i = 0; i < model.vertices_size; ++i)
+  {
+    equal &= model.normals[i] == scatter_buffer[i];
+  }
+
+  assert(equal);
+
+  /* Runtime flags are not stored */
+  assert(rgf_binary_encode(binary_buffer, 1500000, &binary_buffer_size, &model));
+  assert(!(rgf_binary_read_ul(binary_buffer + 8) & RGF_MODEL_FLAG_ADJACENCY));
+
+  /* Renumbering the triangles or parsing drops the adjacency */
+  {
+    rgf_submesh submeshes[2];
+
+    submeshes[0].index_offset = 0;
+    submeshes[0].index_count = 3;
+    submeshes[0].material_hash = 2;
+    submeshes[1].index_offset = 3;
+    submeshes[1].index_count = (unsigned int)model.indices_size - 3;
+    submeshes[1].material_hash = 1;
+    model.submeshes = submeshes;
+    model.submeshes_size = 2;
+
+    rgf_model_sort_submeshes(&model, (int *)triangles_buffer);
+    assert(!(model.flags & RGF_MODEL_FLAG_ADJACENCY));
+    model.submeshes = 0;
+    model.submeshes_size = 0;
+  }
+
+  /* The passes scatter instead of building it again */
+  rgf_model_calculate_normals_parallel(&model, &jobs);
+  assert(!(model.flags & RGF_MODEL_FLAG_ADJACENCY));
+  assert(rgf_model_build_adjacency(&model));
+
+  assert(rgf_platform_read("head.obj", binary_buffer, 1500000, &binary_buffer_size));
+  assert(rgf_parse_obj(&model, binary_buffer, binary_buffer_size));
+  assert(!(model.flags & RGF_MODEL_FLAG_ADJACENCY));
+
+  /* Out of range indices are rejected */
+  indices_buffer[4] = (int)(model.vertices_size / 3);
+  assert(!rgf_model_build_adjacency(&model));
+  assert(!(model.flags & RGF_MODEL_FLAG_ADJACENCY));
+
+  free(vertices_buffer);
+  free(indices_buffer);
+  free(uvs_buffer);
+  free(normals_buffer);
+  free(tangents_buffer);
+  free(bitangents_buffer);
+  free(scatter_buffer);
+  free(offsets_buffer);
+  free(triangles_buffer);
+  free(binary_buffer);
+}
+
 void rgf_test_convert_to_c_header(void)
 {
   /* Stack Memory */
@@ -294,9 +2729,33 @@ void rgf_test_convert_to_c_header(void)
 int main(void)
 {
   rgf_test_encode_decode();
+  rgf_test_decode_sections();
+  rgf_test_encode_quantized();
   rgf_test_encode_to_file();
   rgf_test_decode_from_file();
+  rgf_test_decode_sections_from_file();
+  rgf_test_atof();
+  rgf_test_memcpy();
+  rgf_test_bounds();
+  rgf_test_transform();
+  rgf_test_normalize();
+  rgf_test_transform_deferred();
+  rgf_test_adjacency();
+  rgf_test_obj_count();
+  rgf_test_obj_measure();
   rgf_test_parse_obj();
+  rgf_test_parse_obj_parallel();
+  rgf_test_parse_obj_arena();
+  rgf_test_parse_obj_welded();
+  rgf_test_parse_obj_submeshes();
+  rgf_test_parse_obj_mapped();
+  rgf_test_encode_triangles();
+  rgf_test_encode_compressed();
+  rgf_test_encode_stream();
+  rgf_test_pak();
+  rgf_test_interleaved();
+  rgf_test_index_width();
+  rgf_test_encode_parallel();
   rgf_test_convert_to_c_header();
 
   return 0;